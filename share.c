@@ -0,0 +1,12 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gs1syntaxdictionary.h"
+#include "dictionary.h"
+static char *rd(const char *f, size_t *n){FILE*fp=fopen(f,"rb");fseek(fp,0,2);*n=ftell(fp);rewind(fp);char*b=malloc(*n);fread(b,1,*n,fp);fclose(fp);return b;}
+int main(void){size_t n1,n2,l=0;char*a=rd("old.txt",&n1),*b=rd("/root/repo/gs1-syntax-dictionary.txt",&n2);
+gs1_dict_t*base,*d;int r=gs1_dict_load(a,n1,&base,&l);printf("base %d line %zu count %zu\n",r,l,r?0:gs1_dict_count(base));
+r=gs1_dict_load_derived(base,b,n2,&d,&l);printf("derived %d line %zu count %zu\n",r,l,gs1_dict_count(d));
+size_t np=(gs1_dict_count(d)+63)/64,sh=0,ip=0;for(size_t p=0;p<np;p++)if(p*64<base->count && d->pages[p]==base->pages[p])sh++;
+for(size_t p=0;p<DICT_INDEX_PAGES;p++)if(d->index[p]==base->index[p])ip++;
+printf("entry pages shared %zu/%zu, index pages shared %zu/%d, own blob %zu vs base blob %zu\n",sh,np,ip,DICT_INDEX_PAGES,d->blob_len,base->blob_len);}
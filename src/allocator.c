@@ -0,0 +1,525 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Allocation of SSCCs from a range of serial references, and of serial
+ * numbers for a GTIN, writing element strings that are ready to print, e.g.
+ *
+ *   (00)095212340000000017
+ *   (01)09521234543213(21)1000
+ *
+ * An allocator may be shared between threads. Each thread holds a cursor that
+ * claims a block of serial references at a time from the shared counter with
+ * an atomic fetch-and-add, so the threads only contend once per block.
+ *
+ * Within a block, the serial is held as a string of digits that is
+ * incremented in place. For an SSCC, the weighted sum modulo 10 from which the
+ * check digit is derived is maintained alongside: a digit that is incremented,
+ * or that wraps from 9 to 0, changes the sum by its weight modulo 10, so only
+ * the digits that change are visited.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <windows.h>
+typedef volatile LONG64 counter_t;
+#else
+#include <stdatomic.h>
+typedef _Atomic uint64_t counter_t;
+#endif
+
+#include "gs1syntaxdictionary.h"
+
+
+#define SSCC_DATA_LEN 17
+#define MAX_SERIAL_DIGITS 20
+
+struct gs1_alloc {
+	counter_t next;			/* Next unclaimed serial reference */
+	uint64_t last;
+	int sscc;
+	uint32_t width;			/* Digits in an SSCC serial reference */
+	uint32_t prefix_sum;		/* Weighted sum of the SSCC prefix, modulo 10 */
+	size_t prefix_len;
+	char prefix[32];		/* e.g. "(00)0952123" or "(01)09521234543213(21)" */
+};
+
+
+static uint64_t fetch_add(counter_t* const c, const uint64_t n)
+{
+#ifdef _MSC_VER
+	return (uint64_t)InterlockedExchangeAdd64(c, (LONG64)n);
+#else
+	return atomic_fetch_add_explicit(c, n, memory_order_relaxed);
+#endif
+}
+
+
+/*
+ * Weight of the data digit at the given distance from the check digit,
+ * counting from 0.
+ *
+ */
+static uint32_t weight(const size_t k)
+{
+	return k % 2 == 0 ? 3 : 1;
+}
+
+
+static gs1_alloc_err_t create(const char* const prefix, const size_t prefix_len, const uint64_t first, const uint64_t last,
+			      gs1_alloc_t** const alloc)
+{
+
+	struct gs1_alloc *a;
+
+	/*
+	 * Leave headroom so that claims past the end cannot wrap the counter.
+	 *
+	 */
+	if (first > last || last > UINT64_MAX / 2)
+		return GS1_ALLOC_INVALID_RANGE;
+
+	if ((a = calloc(1, sizeof(struct gs1_alloc))) == NULL)
+		return GS1_ALLOC_NO_MEMORY;
+
+#ifdef _MSC_VER
+	a->next = (LONG64)first;
+#else
+	atomic_init(&a->next, first);
+#endif
+	a->last = last;
+	memcpy(a->prefix, prefix, prefix_len);
+	a->prefix_len = prefix_len;
+
+	*alloc = a;
+	return GS1_ALLOC_OK;
+
+}
+
+
+/**
+ * Create an allocator of SSCCs, (00).
+ *
+ * @param [in] prefix The extension digit followed by the GS1 Company Prefix,
+ *                    up to 16 digits. The remaining digits of the SSCC are
+ *                    the serial reference and the check digit.
+ * @param [in] first The first serial reference.
+ * @param [in] last The last serial reference, inclusive.
+ * @param [out] alloc The allocator, to be released with gs1_alloc_free().
+ *
+ * @return #GS1_ALLOC_OK if okay, otherwise the reason that the allocator
+ *         could not be created.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_alloc_err_t gs1_alloc_sscc_create(const char* const prefix, const uint64_t first, const uint64_t last,
+								gs1_alloc_t** const alloc)
+{
+
+	char buf[32] = "(00)";
+	size_t len, i;
+	uint64_t limit = 1;
+	uint32_t sum = 0;
+	gs1_alloc_err_t ret;
+
+	assert(prefix);
+	assert(alloc);
+
+	*alloc = NULL;
+
+	len = strlen(prefix);
+	if (len == 0 || len >= SSCC_DATA_LEN || strspn(prefix, "0123456789") != len)
+		return GS1_ALLOC_INVALID_PREFIX;
+
+	for (i = 0; i < SSCC_DATA_LEN - len; i++)
+		limit *= 10;
+	if (last >= limit)
+		return GS1_ALLOC_INVALID_RANGE;
+
+	for (i = 0; i < len; i++)
+		sum += (uint32_t)(prefix[i] - '0') * weight(SSCC_DATA_LEN - 1 - i);
+
+	memcpy(buf + 4, prefix, len);
+	if ((ret = create(buf, 4 + len, first, last, alloc)) != GS1_ALLOC_OK)
+		return ret;
+
+	(*alloc)->sscc = 1;
+	(*alloc)->width = (uint32_t)(SSCC_DATA_LEN - len);
+	(*alloc)->prefix_sum = sum % 10;
+
+	return GS1_ALLOC_OK;
+
+}
+
+
+/**
+ * Create an allocator of numeric serial numbers, (21), for a GTIN, (01).
+ *
+ * The serial numbers are written without leading zeros. The last serial
+ * number may be at most 2^63 - 1.
+ *
+ * @param [in] gtin The 14-digit GTIN, including its check digit.
+ * @param [in] first The first serial number.
+ * @param [in] last The last serial number, inclusive.
+ * @param [out] alloc The allocator, to be released with gs1_alloc_free().
+ *
+ * @return #GS1_ALLOC_OK if okay, otherwise the reason that the allocator
+ *         could not be created.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_alloc_err_t gs1_alloc_gtin_serial_create(const char* const gtin, const uint64_t first, const uint64_t last,
+								       gs1_alloc_t** const alloc)
+{
+
+	char buf[32] = "(01)";
+
+	assert(gtin);
+	assert(alloc);
+
+	*alloc = NULL;
+
+	if (strlen(gtin) != 14 || strspn(gtin, "0123456789") != 14 || gs1_lint_csum(gtin, NULL, NULL) != GS1_LINTER_OK)
+		return GS1_ALLOC_INVALID_PREFIX;
+
+	memcpy(buf + 4, gtin, 14);
+	memcpy(buf + 18, "(21)", 4);
+
+	return create(buf, 22, first, last, alloc);
+
+}
+
+
+/**
+ * Release an allocator.
+ *
+ * @param [in] alloc The allocator, or `NULL`.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_alloc_free(gs1_alloc_t* const alloc)
+{
+	free(alloc);
+}
+
+
+/**
+ * Initialise a cursor, which must not be shared between threads.
+ *
+ * Serial references that a cursor has claimed but not allocated are not
+ * allocated by any other cursor, so a smaller block wastes fewer at the end of
+ * a run, whereas a larger block reduces contention between threads.
+ *
+ * @param [out] cur The cursor.
+ * @param [in] block_size The number of serial references to claim at a time.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_alloc_cursor_init(gs1_alloc_cursor_t* const cur, const uint32_t block_size)
+{
+	assert(cur);
+	memset(cur, 0, sizeof(*cur));
+	cur->block_size = block_size ? block_size : 1;
+}
+
+
+/*
+ * Claims the next block, setting the digits and weighted sum of its first
+ * serial. Returns 0 if the range is exhausted.
+ *
+ */
+static int refill(gs1_alloc_t* const a, gs1_alloc_cursor_t* const cur)
+{
+
+	uint64_t n;
+	size_t k;
+
+	n = fetch_add(&a->next, cur->block_size);
+	if (n > a->last) {
+		cur->next = cur->end = 0;
+		return 0;
+	}
+
+	cur->next = n;
+	cur->end = a->last - n < cur->block_size ? a->last + 1 : n + cur->block_size;
+
+	cur->sum = a->prefix_sum;
+	for (k = 0; k < MAX_SERIAL_DIGITS && (n > 0 || k < a->width || k == 0); k++, n /= 10) {
+		cur->digits[MAX_SERIAL_DIGITS - 1 - k] = (char)('0' + n % 10);
+		cur->sum += (uint32_t)(n % 10) * weight(k);
+	}
+	cur->sum %= 10;
+	cur->width = (uint32_t)k;
+
+	return 1;
+
+}
+
+
+static void increment(gs1_alloc_cursor_t* const cur)
+{
+
+	char *d = &cur->digits[MAX_SERIAL_DIGITS - 1];
+	size_t k = 0;
+
+	/*
+	 * Both 9 -> 0 and d -> d + 1 change the sum by the weight, modulo 10.
+	 *
+	 */
+	for (; *d == '9' && k < cur->width; d--, k++) {
+		*d = '0';
+		cur->sum += weight(k);
+	}
+
+	if (k == cur->width) {
+		*d = '1';
+		cur->width++;
+	} else {
+		(*d)++;
+	}
+	cur->sum = (cur->sum + weight(k)) % 10;
+
+}
+
+
+/*
+ * Writes the element string for the current serial. The caller ensures that
+ * the buffer is large enough.
+ *
+ */
+static size_t emit(const gs1_alloc_t* const a, const gs1_alloc_cursor_t* const cur, char* const out)
+{
+
+	size_t len = a->prefix_len;
+
+	memcpy(out, a->prefix, len);
+	memcpy(out + len, &cur->digits[MAX_SERIAL_DIGITS - cur->width], cur->width);
+	len += cur->width;
+
+	if (a->sscc)
+		out[len++] = (char)('0' + (10 - cur->sum) % 10);
+
+	return len;
+
+}
+
+
+static size_t next_len(const gs1_alloc_t* const a, const gs1_alloc_cursor_t* const cur)
+{
+	return a->prefix_len + cur->width + (a->sscc ? 1 : 0);
+}
+
+
+/*
+ * Ensures that the cursor holds a serial, claiming a block if necessary.
+ *
+ */
+static int ready(gs1_alloc_t* const a, gs1_alloc_cursor_t* const cur)
+{
+	return cur->next < cur->end || refill(a, cur);
+}
+
+
+static void advance(gs1_alloc_cursor_t* const cur)
+{
+	if (++cur->next < cur->end)
+		increment(cur);
+}
+
+
+/**
+ * Allocate the next SSCC or serial number, writing its element string.
+ *
+ * Safe to call concurrently from several threads, each with its own cursor.
+ *
+ * @param [in] alloc The allocator.
+ * @param [in,out] cur The cursor of the calling thread.
+ * @param [out] buf Buffer that receives the null-terminated element string.
+ *                  #GS1_ALLOC_BUF_LEN is always sufficient.
+ * @param [in] buf_len The size of buf.
+ *
+ * @return the length of the element string, or 0 if the range is exhausted or
+ *         the buffer is too small, in which case nothing is allocated.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_alloc_next(gs1_alloc_t* const alloc, gs1_alloc_cursor_t* const cur, char* const buf, const size_t buf_len)
+{
+
+	size_t len;
+
+	assert(alloc);
+	assert(cur);
+	assert(buf);
+
+	if (!ready(alloc, cur) || next_len(alloc, cur) >= buf_len)
+		return 0;
+
+	len = emit(alloc, cur, buf);
+	buf[len] = '\0';
+	advance(cur);
+
+	return len;
+
+}
+
+
+/**
+ * Allocate several SSCCs or serial numbers.
+ *
+ * The element strings are written end-to-end into out, without null
+ * terminators, with element string i occupying out[out_offsets[i]] to
+ * out[out_offsets[i+1] - 1], so out_offsets has room for count + 1 entries.
+ * Since out_offsets are 32-bit, no more than UINT32_MAX bytes of out are used.
+ *
+ * @return the number allocated, which is less than count if the range is
+ *         exhausted or out is full.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_alloc_batch(gs1_alloc_t* const alloc, gs1_alloc_cursor_t* const cur, const size_t count,
+						 char* const out, const size_t out_len, uint32_t* const out_offsets)
+{
+
+	const size_t avail = out_len < UINT32_MAX ? out_len : UINT32_MAX;
+	size_t i, pos = 0;
+
+	assert(alloc);
+	assert(cur);
+	assert(out || out_len == 0);
+	assert(out_offsets);
+
+	out_offsets[0] = 0;
+
+	for (i = 0; i < count; i++) {
+		if (!ready(alloc, cur) || next_len(alloc, cur) > avail - pos)
+			break;
+		pos += emit(alloc, cur, out + pos);
+		out_offsets[i+1] = (uint32_t)pos;
+		advance(cur);
+	}
+
+	return i;
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <stdio.h>
+
+
+void test_allocator_sscc(void)
+{
+
+	gs1_alloc_t *a;
+	gs1_alloc_cursor_t cur;
+	char buf[GS1_ALLOC_BUF_LEN], expect[GS1_ALLOC_BUF_LEN];
+	unsigned long i;
+	size_t len;
+
+	TEST_ASSERT(gs1_alloc_sscc_create("0952123", 0, 9999999999UL, &a) == GS1_ALLOC_OK);
+	gs1_alloc_cursor_init(&cur, 7);
+
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 22);
+	TEST_CHECK(strcmp(buf, "(00)095212300000000000") == 0);
+	TEST_MSG("Got %s", buf);
+
+	/*
+	 * The incremental check digit agrees with the csum linter, across
+	 * carries and block boundaries.
+	 *
+	 */
+	for (i = 1; i < 2500; i++) {
+		TEST_ASSERT((len = gs1_alloc_next(a, &cur, buf, sizeof(buf))) == 22);
+		sprintf(expect, "(00)0952123%010lu", i);
+		if (!TEST_CHECK(memcmp(buf, expect, 21) == 0 && gs1_lint_csum(buf + 4, NULL, NULL) == GS1_LINTER_OK)) {
+			TEST_MSG("Got %s", buf);
+			break;
+		}
+	}
+
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, 22) == 0);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, 23) == 22);
+	TEST_CHECK(strcmp(buf, "(00)095212300000025003") == 0);
+	TEST_MSG("Got %s", buf);
+
+	gs1_alloc_free(a);
+
+	/*
+	 * The end of the range, which need not align with a block.
+	 *
+	 */
+	TEST_ASSERT(gs1_alloc_sscc_create("1952123456789012", 7, 9, &a) == GS1_ALLOC_OK);
+	gs1_alloc_cursor_init(&cur, 2);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 22 && strcmp(buf, "(00)195212345678901270") == 0);
+	TEST_MSG("Got %s", buf);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 22 && gs1_lint_csum(buf + 4, NULL, NULL) == GS1_LINTER_OK);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 22 && memcmp(buf, "(00)19521234567890129", 21) == 0);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 0);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 0);
+	gs1_alloc_free(a);
+
+	TEST_CHECK(gs1_alloc_sscc_create("", 0, 1, &a) == GS1_ALLOC_INVALID_PREFIX && a == NULL);
+	TEST_CHECK(gs1_alloc_sscc_create("09521234567890123", 0, 0, &a) == GS1_ALLOC_INVALID_PREFIX);
+	TEST_CHECK(gs1_alloc_sscc_create("095212A", 0, 1, &a) == GS1_ALLOC_INVALID_PREFIX);
+	TEST_CHECK(gs1_alloc_sscc_create("0952123", 2, 1, &a) == GS1_ALLOC_INVALID_RANGE);
+	TEST_CHECK(gs1_alloc_sscc_create("0952123", 0, 10000000000UL, &a) == GS1_ALLOC_INVALID_RANGE);
+
+}
+
+
+void test_allocator_gtin_serial(void)
+{
+
+	gs1_alloc_t *a;
+	gs1_alloc_cursor_t cur;
+	char buf[GS1_ALLOC_BUF_LEN], out[80];
+	uint32_t offsets[5];
+
+	TEST_ASSERT(gs1_alloc_gtin_serial_create("09521234543213", 98, 1000000, &a) == GS1_ALLOC_OK);
+	gs1_alloc_cursor_init(&cur, 100);
+
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 24 && strcmp(buf, "(01)09521234543213(21)98") == 0);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 24 && strcmp(buf, "(01)09521234543213(21)99") == 0);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 25 && strcmp(buf, "(01)09521234543213(21)100") == 0);
+	TEST_MSG("Got %s", buf);
+
+	TEST_CHECK(gs1_alloc_batch(a, &cur, 4, out, sizeof(out), offsets) == 3);
+	TEST_CHECK(offsets[0] == 0 && offsets[1] == 25 && offsets[2] == 50 && offsets[3] == 75);
+	TEST_CHECK(memcmp(out, "(01)09521234543213(21)101(01)09521234543213(21)102(01)09521234543213(21)103", 75) == 0);
+
+	gs1_alloc_free(a);
+
+	TEST_ASSERT(gs1_alloc_gtin_serial_create("09521234543213", UINT64_MAX / 2 - 1, UINT64_MAX / 2, &a) == GS1_ALLOC_OK);
+	gs1_alloc_cursor_init(&cur, 0);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 41 && strcmp(buf, "(01)09521234543213(21)9223372036854775806") == 0);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 41 && strcmp(buf, "(01)09521234543213(21)9223372036854775807") == 0);
+	TEST_CHECK(gs1_alloc_next(a, &cur, buf, sizeof(buf)) == 0);
+	gs1_alloc_free(a);
+
+	TEST_CHECK(gs1_alloc_gtin_serial_create("09521234543213", 0, UINT64_MAX / 2 + 1, &a) == GS1_ALLOC_INVALID_RANGE);
+
+	TEST_CHECK(gs1_alloc_gtin_serial_create("09521234543212", 0, 1, &a) == GS1_ALLOC_INVALID_PREFIX);
+	TEST_CHECK(gs1_alloc_gtin_serial_create("0952123454321", 0, 1, &a) == GS1_ALLOC_INVALID_PREFIX);
+
+}
+
+#endif  /* UNIT_TESTS */
@@ -0,0 +1,834 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * AI association rules: the "req" and "ex" attributes of the dictionary, and
+ * application profiles that mandate further AIs, e.g. for a sector.
+ *
+ * A rule is a list of alternatives separated by ",", each of which is one or
+ * more AI patterns joined by "+", where "n" in a pattern matches any digit:
+ *
+ *   req=01+21,02,35nn   requires (01) with (21), or (02), or any of (35nn)
+ *   ex=392n,393n        forbids any of (392n) and (393n), other than itself
+ *
+ * The rules are compiled into bitsets over the dictionary entry numbers, once
+ * for the dictionary when it is loaded and once for each profile. A message
+ * is then checked with a single pass over its AIs to form the set that is
+ * present, against which the rules of each AI and those of the selected
+ * profile are evaluated a word at a time.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+#include "dictionary.h"
+
+
+#define WORD_BITS 64
+#define BITSET_WORDS ((DICT_INDEX_LEN + WORD_BITS - 1) / WORD_BITS)
+
+#define MAX_PATTERN_LEN 4
+
+
+struct gs1_profile {
+	const struct gs1_dict *dict;
+	struct dict_rules rules;
+};
+
+
+/*
+ * Accumulates rules whilst compiling.
+ *
+ */
+struct compiler {
+	const struct gs1_dict *dict;
+	struct dict_rules *r;
+	size_t rules_cap;
+	size_t alts_cap;
+	size_t terms_cap;
+};
+
+
+static int grow(void** const p, size_t* const cap, const size_t need, const size_t size)
+{
+
+	size_t cap2 = *cap ? *cap : 16;
+	void *q;
+
+	if (need <= *cap)
+		return 1;
+
+	while (cap2 < need)
+		cap2 *= 2;
+	if ((q = realloc(*p, cap2 * size)) == NULL)
+		return 0;
+	*p = q;
+	*cap = cap2;
+
+	return 1;
+
+}
+
+
+/*
+ * Sets the bits of the entries for the AIs that match a pattern, by expanding
+ * each "n" over the digits and looking up the result in the index.
+ *
+ */
+static void set_pattern_bits(const struct gs1_dict* const d, uint64_t* const bits, const char* const pattern, const size_t len)
+{
+
+	char ai[MAX_PATTERN_LEN];
+	size_t wild[MAX_PATTERN_LEN];
+	size_t i, num_wild = 0;
+	unsigned int v, k, combos = 1;
+	int key, entry;
+
+	for (i = 0; i < len; i++) {
+		ai[i] = pattern[i];
+		if (pattern[i] == 'n') {
+			wild[num_wild++] = i;
+			combos *= 10;
+		}
+	}
+
+	for (v = 0; v < combos; v++) {
+		for (i = 0, k = v; i < num_wild; i++, k /= 10)
+			ai[wild[i]] = (char)('0' + k % 10);
+		key = gs1_dict_ai_key(ai, len);
+		assert(key >= 0);
+		if ((entry = (int)DICT_INDEX(d, key) - 1) >= 0)
+			bits[entry / WORD_BITS] |= UINT64_C(1) << (entry % WORD_BITS);
+	}
+
+}
+
+
+/*
+ * Parses the alternatives of one rule within [p, end). With no compiler, only
+ * the syntax is checked.
+ *
+ */
+static gs1_dict_err_t parse_rule(struct compiler* const c, const char *p, const char* const end, const int ex)
+{
+
+	struct dict_rules * const r = c ? c->r : NULL;
+	struct dict_rule *rule = NULL;
+	struct dict_alt *alt = NULL;
+	const char *t;
+	size_t len;
+
+	if (c) {
+		if (!grow((void **)&r->rules, &c->rules_cap, r->num_rules + 1, sizeof(*r->rules)))
+			return GS1_DICT_NO_MEMORY;
+		rule = &r->rules[r->num_rules++];
+		rule->alts = (uint32_t)r->num_alts;
+		rule->num_alts = 0;
+		rule->ex = (uint8_t)ex;
+	}
+
+	for (;;) {
+
+		if (c) {
+			if (rule->num_alts == UINT16_MAX || r->num_alts >= UINT32_MAX)
+				return GS1_DICT_INVALID_ENTRY;
+			if (!grow((void **)&r->alts, &c->alts_cap, r->num_alts + 1, sizeof(*r->alts)))
+				return GS1_DICT_NO_MEMORY;
+			alt = &r->alts[r->num_alts++];
+			alt->terms = (uint32_t)r->num_terms;
+			alt->num_terms = 0;
+			rule->num_alts++;
+		}
+
+		for (;;) {
+
+			for (t = p; t < end && ((*t >= '0' && *t <= '9') || *t == 'n'); t++);
+			len = (size_t)(t - p);
+			if (len < 2 || len > MAX_PATTERN_LEN)
+				return GS1_DICT_INVALID_ENTRY;
+
+			if (c) {
+				if (alt->num_terms == UINT16_MAX || r->num_terms >= UINT32_MAX)
+					return GS1_DICT_INVALID_ENTRY;
+				if (!grow((void **)&r->terms, &c->terms_cap, (r->num_terms + 1) * r->words, sizeof(*r->terms)))
+					return GS1_DICT_NO_MEMORY;
+				memset(&r->terms[r->num_terms * r->words], 0, r->words * sizeof(*r->terms));
+				set_pattern_bits(c->dict, &r->terms[r->num_terms * r->words], p, len);
+				r->num_terms++;
+				alt->num_terms++;
+			}
+
+			p = t;
+			if (p == end || *p != '+')
+				break;
+			p++;
+
+		}
+
+		if (p == end)
+			break;
+		if (*p != ',')
+			return GS1_DICT_INVALID_ENTRY;
+		p++;
+
+	}
+
+	return GS1_DICT_OK;
+
+}
+
+
+/*
+ * Parses the space-separated rules within [p, end), skipping any other
+ * attributes of a dictionary entry. In a profile, a bare list of patterns is a
+ * "req" rule and there must be no other attributes.
+ *
+ */
+static gs1_dict_err_t parse_rules(struct compiler* const c, const char *p, const char* const end, const int profile)
+{
+
+	const char *t;
+	gs1_dict_err_t ret;
+
+	for (;;) {
+
+		while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+			p++;
+		if (p == end)
+			break;
+		for (t = p; t < end && *t != ' ' && *t != '\t' && *t != '\r' && *t != '\n'; t++);
+
+		if (t - p > 4 && memcmp(p, "req=", 4) == 0)
+			ret = parse_rule(c, p + 4, t, 0);
+		else if (t - p > 3 && memcmp(p, "ex=", 3) == 0)
+			ret = parse_rule(c, p + 3, t, 1);
+		else if (profile)
+			ret = parse_rule(c, p, t, 0);
+		else
+			ret = GS1_DICT_OK;
+
+		if (ret != GS1_DICT_OK)
+			return ret;
+
+		p = t;
+
+	}
+
+	return GS1_DICT_OK;
+
+}
+
+
+/*
+ * A run of terms, for finding those that are the same.
+ *
+ */
+struct term_run {
+	const uint64_t *bits;
+	size_t num_terms;
+	size_t alt;		/* Alternative that owns the run, or SIZE_MAX if of the base */
+	size_t hash;
+};
+
+static size_t run_hash(const uint64_t* const bits, const size_t words)
+{
+
+	uint64_t h = UINT64_C(14695981039346656037);
+	size_t i;
+
+	/*
+	 * Multiplying only carries upwards, so fold the high bits down after
+	 * each word.
+	 *
+	 */
+	for (i = 0; i < words; i++) {
+		h = (h ^ bits[i]) * UINT64_C(1099511628211);
+		h ^= h >> 32;
+	}
+
+	return (size_t)h;
+
+}
+
+
+/*
+ * Finds a run the same as the given one, or else inserts it.
+ *
+ */
+static const struct term_run *run_find(struct term_run* const table, const size_t mask, struct term_run* const run, const size_t words)
+{
+
+	const size_t len = run->num_terms * words;
+	size_t i;
+
+	run->hash = run_hash(run->bits, len);
+	for (i = run->hash & mask; table[i].bits; i = (i + 1) & mask)
+		if (table[i].hash == run->hash && table[i].num_terms == run->num_terms &&
+		    memcmp(table[i].bits, run->bits, len * sizeof(uint64_t)) == 0)
+			return &table[i];
+
+	table[i] = *run;
+	return NULL;
+
+}
+
+
+/*
+ * Points each alternative at its terms, sharing the identical terms of an
+ * earlier alternative or of an alternative of the base rules, and keeps only
+ * the runs of terms that are not shared.
+ *
+ */
+static gs1_dict_err_t share_terms(struct dict_rules* const r, const struct dict_rules *base)
+{
+
+	const size_t words = r->words;
+	struct dict_alt *alt;
+	struct term_run *table, run;
+	const struct term_run *found;
+	uint64_t *terms = NULL, *t;
+	size_t *same;		/* The first alternative with the same terms */
+	size_t i, mask, n = 0;
+
+	if (base && base->words != words)
+		base = NULL;
+
+	for (mask = 15; mask < 2 * (r->num_alts + (base ? base->num_alts : 0)); mask = mask * 2 + 1);
+	table = calloc(mask + 1, sizeof(struct term_run));
+	same = malloc((r->num_alts ? r->num_alts : 1) * sizeof(size_t));
+	if (!table || !same)
+		goto fail;
+
+	for (i = 0; base && i < base->num_alts; i++) {
+		run.bits = base->alts[i].bits;
+		run.num_terms = base->alts[i].num_terms;
+		run.alt = SIZE_MAX;
+		run_find(table, mask, &run, words);
+	}
+
+	for (i = 0, alt = r->alts; i < r->num_alts; i++, alt++) {
+		run.bits = &r->terms[alt->terms * words];
+		run.num_terms = alt->num_terms;
+		run.alt = i;
+		alt->bits = NULL;
+		same[i] = i;
+		if ((found = run_find(table, mask, &run, words)) == NULL)
+			n += alt->num_terms;
+		else if (found->alt == SIZE_MAX)
+			alt->bits = found->bits;
+		else
+			same[i] = found->alt;
+	}
+
+	if (n && (terms = malloc(n * words * sizeof(uint64_t))) == NULL)
+		goto fail;
+
+	for (i = 0, alt = r->alts, t = terms; i < r->num_alts; i++, alt++) {
+		if (alt->bits)
+			continue;
+		if (same[i] != i) {
+			alt->bits = r->alts[same[i]].bits;
+			continue;
+		}
+		memcpy(t, &r->terms[alt->terms * words], alt->num_terms * words * sizeof(uint64_t));
+		alt->bits = t;
+		t += alt->num_terms * words;
+	}
+
+	free(table);
+	free(same);
+	free(r->terms);
+	r->terms = terms;
+	r->num_terms = n;
+
+	return GS1_DICT_OK;
+
+fail:
+
+	free(table);
+	free(same);
+	return GS1_DICT_NO_MEMORY;
+
+}
+
+
+gs1_dict_err_t gs1_dict_check_rules(const char* const p, const char* const end)
+{
+	return parse_rules(NULL, p, end, 0);
+}
+
+
+void gs1_dict_free_rules(struct dict_rules* const rules)
+{
+	free(rules->rules);
+	free(rules->alts);
+	free(rules->terms);
+	memset(rules, 0, sizeof(*rules));
+}
+
+
+gs1_dict_err_t gs1_dict_compile_rules(struct gs1_dict* const dict)
+{
+
+	struct compiler c;
+	struct dict_entry_rules *er;
+	const char *attrs, *prev = NULL;
+	size_t i, first, n;
+	gs1_dict_err_t ret;
+
+	memset(&c, 0, sizeof(c));
+	c.dict = dict;
+	c.r = &dict->rules;
+	dict->rules.words = dict->count / WORD_BITS + 1;
+
+	if ((dict->entry_rules = malloc((dict->count ? dict->count : 1) * sizeof(struct dict_entry_rules))) == NULL)
+		return GS1_DICT_NO_MEMORY;
+
+	for (i = 0; i < dict->count; i++, prev = attrs) {
+
+		er = &dict->entry_rules[i];
+		attrs = DICT_STR(dict, i, DICT_ENTRY(dict, i)->attrs);
+
+		/*
+		 * The entries of an AI range share their attributes, and so
+		 * their rules.
+		 *
+		 */
+		if (attrs == prev) {
+			*er = er[-1];
+			continue;
+		}
+
+		first = dict->rules.num_rules;
+		if ((ret = parse_rules(&c, attrs, attrs + strlen(attrs), 0)) != GS1_DICT_OK)
+			return ret;
+		n = dict->rules.num_rules - first;
+		if (first > UINT16_MAX || n > UINT8_MAX)
+			return GS1_DICT_INVALID_ENTRY;
+		er->rules = (uint16_t)first;
+		er->num_rules = (uint8_t)n;
+
+	}
+
+	return share_terms(&dict->rules, dict->base ? &dict->base->rules : NULL);
+
+}
+
+
+/**
+ * Compile an application profile, which specifies AIs that a message must or
+ * must not contain beyond what the dictionary requires.
+ *
+ * The profile consists of space-separated rules, each of which is either a
+ * "req=" or "ex=" rule with the same syntax as the dictionary attributes, or
+ * a bare list of alternatives that is treated as a "req" rule. For example,
+ * "01 17 10 21" requires each of those AIs, and "01 310n 15 ex=17" requires
+ * (01), any (310n) and (15) whilst forbidding (17).
+ *
+ * @param [in] dict The dictionary against which the profile is checked.
+ * @param [in] rules The profile text, which need not be null-terminated.
+ * @param [in] len The length of the text.
+ * @param [out] profile The compiled profile, to be released with
+ *                      gs1_profile_free(). It remains valid only for as long
+ *                      as the dictionary.
+ *
+ * @return #GS1_DICT_OK if okay, #GS1_DICT_INVALID_ENTRY if the profile is
+ *         malformed, or #GS1_DICT_NO_MEMORY.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_dict_err_t gs1_profile_compile(const gs1_dict_t* const dict, const char* const rules, const size_t len,
+							     gs1_profile_t** const profile)
+{
+
+	struct compiler c;
+	struct gs1_profile *prof;
+	gs1_dict_err_t ret;
+
+	assert(dict);
+	assert(rules || len == 0);
+	assert(profile);
+
+	*profile = NULL;
+
+	if ((prof = calloc(1, sizeof(struct gs1_profile))) == NULL)
+		return GS1_DICT_NO_MEMORY;
+	prof->dict = dict;
+	prof->rules.words = dict->rules.words;
+
+	memset(&c, 0, sizeof(c));
+	c.dict = dict;
+	c.r = &prof->rules;
+
+	if ((ret = parse_rules(&c, rules, rules + len, 1)) != GS1_DICT_OK ||
+	    (ret = share_terms(&prof->rules, NULL)) != GS1_DICT_OK) {
+		gs1_profile_free(prof);
+		return ret;
+	}
+
+	*profile = prof;
+	return GS1_DICT_OK;
+
+}
+
+
+/**
+ * Release a profile that was compiled with gs1_profile_compile().
+ *
+ * @param [in] profile The profile, or `NULL`.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_profile_free(gs1_profile_t* const profile)
+{
+	if (!profile)
+		return;
+	gs1_dict_free_rules(&profile->rules);
+	free(profile);
+}
+
+
+static int alt_holds(const struct dict_rules* const r, const struct dict_alt* const alt, const uint64_t* const present)
+{
+
+	const uint64_t *bits = alt->bits;
+	size_t t, w;
+
+	for (t = 0; t < alt->num_terms; t++, bits += r->words) {
+		for (w = 0; w < r->words && !(bits[w] & present[w]); w++);
+		if (w == r->words)
+			return 0;
+	}
+
+	return 1;
+
+}
+
+
+/*
+ * An AI is not excluded by itself, so its own entry is removed from the
+ * present set whilst evaluating its "ex" rules.
+ *
+ */
+static int rule_holds(const struct dict_rules* const r, const struct dict_rule* const rule, uint64_t* const present, const int self)
+{
+
+	const uint64_t self_bit = self >= 0 ? UINT64_C(1) << (self % WORD_BITS) : 0;
+	const uint64_t saved = self >= 0 ? present[self / WORD_BITS] : 0;
+	size_t i;
+	int holds = rule->ex;
+
+	if (rule->ex && self >= 0)
+		present[self / WORD_BITS] &= ~self_bit;
+
+	for (i = 0; i < rule->num_alts; i++) {
+		if (alt_holds(r, &r->alts[rule->alts + i], present)) {
+			holds = !rule->ex;
+			break;
+		}
+	}
+
+	if (rule->ex && self >= 0)
+		present[self / WORD_BITS] = saved;
+
+	return holds;
+
+}
+
+
+/**
+ * Check the AIs of a message against the "req" and "ex" rules of the
+ * dictionary and, optionally, those of an application profile.
+ *
+ * The profile can differ from one message to the next. Its rules are
+ * evaluated against the same set of AIs as the dictionary rules, so selecting
+ * a profile does not require any further pass over the message.
+ *
+ * @param [in] dict The dictionary.
+ * @param [in] ais The AI data.
+ * @param [in] count The number of AIs.
+ * @param [in] profile A profile compiled against the dictionary, or `NULL`.
+ * @param [out] pos If not `NULL`, the position of the AI whose rule is not
+ *                  satisfied, or that is unknown. For a profile failure, the
+ *                  number of the profile rule that is not satisfied, counting
+ *                  from 0.
+ *
+ * @return #GS1_ASSOC_OK if all of the rules are satisfied, otherwise the
+ *         first failure that was found.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_assoc_err_t gs1_ai_check_associations(const gs1_dict_t* const dict, const gs1_ai_view_t* const ais, const size_t count,
+								    const gs1_profile_t* const profile, size_t* const pos)
+{
+
+	uint64_t present[BITSET_WORDS];
+	const struct dict_rules * const r = &dict->rules;
+	const struct dict_entry_rules *er;
+	size_t i, j;
+	int key, entry;
+
+	assert(dict);
+	assert(ais || count == 0);
+	assert(!profile || profile->dict == dict);
+	assert(r->words <= BITSET_WORDS);
+
+	memset(present, 0, r->words * sizeof(present[0]));
+
+	for (i = 0; i < count; i++) {
+		if ((key = gs1_dict_ai_key(ais[i].ai, ais[i].ai_len)) < 0 || (entry = (int)DICT_INDEX(dict, key) - 1) < 0) {
+			if (pos) *pos = i;
+			return GS1_ASSOC_UNKNOWN_AI;
+		}
+		present[entry / WORD_BITS] |= UINT64_C(1) << (entry % WORD_BITS);
+	}
+
+	for (i = 0; i < count; i++) {
+		entry = (int)DICT_INDEX(dict, gs1_dict_ai_key(ais[i].ai, ais[i].ai_len)) - 1;
+		er = &dict->entry_rules[entry];
+		for (j = 0; j < er->num_rules; j++) {
+			const struct dict_rule * const rule = &r->rules[er->rules + j];
+			if (!rule_holds(r, rule, present, entry)) {
+				if (pos) *pos = i;
+				return rule->ex ? GS1_ASSOC_INVALID_PAIR : GS1_ASSOC_REQUIRED_MISSING;
+			}
+		}
+	}
+
+	if (!profile)
+		return GS1_ASSOC_OK;
+
+	for (j = 0; j < profile->rules.num_rules; j++) {
+		const struct dict_rule * const rule = &profile->rules.rules[j];
+		if (!rule_holds(&profile->rules, rule, present, -1)) {
+			if (pos) *pos = j;
+			return rule->ex ? GS1_ASSOC_PROFILE_EXCLUDED : GS1_ASSOC_PROFILE_MISSING;
+		}
+	}
+
+	return GS1_ASSOC_OK;
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#include "unittest.h"
+
+
+static const char test_dict[] =
+	"00         *?  N18,csum,key                  dlpkey                                              # SSCC\n"
+	"01         *?  N14,csum,key                  ex=02,255,37 dlpkey=22,10,21|235                    # GTIN\n"
+	"02         *?  N14,csum,key                  req=00                                              # CONTENT\n"
+	"10          ?  X..20                         req=01,02,8006,8026                                 # BATCH/LOT\n"
+	"15         *?  N6,yymmd0                     req=01,02,8006,8026                                 # BEST BEFORE or BEST BY\n"
+	"17         *?  N6,yymmd0                     req=01,02,8006,8026                                 # USE BY or EXPIRY\n"
+	"21             X..20                         req=01,8006 ex=235                                  # SERIAL\n"
+	"235            X..28                         req=01                                              # TPX\n"
+	"250         ?  X..30                         req=01,8006 req=21                                  # SECONDARY SERIAL\n"
+	"3100-3105  *?  N6                            req=01,02 ex=310n                                   # NET WEIGHT (kg)\n"
+	"8006       *?  N14,csum N2 N2                ex=01,02,37                                         # ITIP\n";
+
+
+void test_associations_dictionary_rules(void)
+{
+
+	static const char test_dict_alts[] = "01 N14\n21 X..20\n02 N14\n3100-3105 N6\n99 X..90 req=01+21,02+31nn\n";
+	gs1_dict_t *dict;
+	gs1_ai_view_t ais[4];
+	size_t pos;
+
+	TEST_ASSERT(gs1_dict_load(test_dict, strlen(test_dict), &dict, NULL) == GS1_DICT_OK);
+
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 0, NULL, &pos) == GS1_ASSOC_OK);
+
+	set_ai(&ais[0], "01", "09521234543213");
+	set_ai(&ais[1], "10", "ABC");
+	set_ai(&ais[2], "3103", "000125");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, &pos) == GS1_ASSOC_OK);
+
+	/*
+	 * Requirements are satisfied irrespective of order.
+	 *
+	 */
+	set_ai(&ais[0], "10", "ABC");
+	set_ai(&ais[1], "01", "09521234543213");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, NULL) == GS1_ASSOC_OK);
+
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 1, NULL, &pos) == GS1_ASSOC_REQUIRED_MISSING);
+	TEST_CHECK(pos == 0);
+
+	/*
+	 * An AI matches its own "ex" pattern, but another AI in the range
+	 * does not.
+	 *
+	 */
+	set_ai(&ais[3], "3100", "000125");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 4, NULL, &pos) == GS1_ASSOC_INVALID_PAIR);
+	TEST_CHECK(pos == 2);
+
+	set_ai(&ais[2], "8006", "095212345432130102");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, &pos) == GS1_ASSOC_INVALID_PAIR);
+	TEST_CHECK(pos == 2);
+
+	/*
+	 * Both of two "req" attributes must be satisfied.
+	 *
+	 */
+	set_ai(&ais[0], "8006", "095212345432130102");
+	set_ai(&ais[1], "250", "X");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 2, NULL, &pos) == GS1_ASSOC_REQUIRED_MISSING);
+	TEST_CHECK(pos == 1);
+	set_ai(&ais[2], "21", "Y");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, &pos) == GS1_ASSOC_OK);
+
+	set_ai(&ais[2], "99", "Y");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, &pos) == GS1_ASSOC_UNKNOWN_AI);
+	TEST_CHECK(pos == 2);
+	set_ai(&ais[2], "1", "Y");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, &pos) == GS1_ASSOC_UNKNOWN_AI);
+
+	/*
+	 * Alternatives made up of several AIs, including those with patterns.
+	 *
+	 */
+	gs1_dict_free(dict);
+	TEST_ASSERT(gs1_dict_load(test_dict_alts, strlen(test_dict_alts), &dict, NULL) == GS1_DICT_OK);
+
+	set_ai(&ais[0], "99", "X");
+	set_ai(&ais[1], "01", "09521234543213");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 2, NULL, &pos) == GS1_ASSOC_REQUIRED_MISSING);
+	set_ai(&ais[2], "21", "Y");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, &pos) == GS1_ASSOC_OK);
+	set_ai(&ais[1], "02", "09521234543213");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, &pos) == GS1_ASSOC_REQUIRED_MISSING);
+	set_ai(&ais[2], "3105", "000001");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, &pos) == GS1_ASSOC_OK);
+
+	gs1_dict_free(dict);
+
+}
+
+
+void test_associations_profiles(void)
+{
+
+	gs1_dict_t *dict;
+	gs1_profile_t *fmd, *fresh, *profile;
+	gs1_ai_view_t ais[4];
+	size_t pos;
+
+#define COMPILE(t, p) gs1_profile_compile(dict, t, strlen(t), p)
+
+	TEST_ASSERT(gs1_dict_load(test_dict, strlen(test_dict), &dict, NULL) == GS1_DICT_OK);
+
+	TEST_ASSERT(COMPILE("01 17 10 21", &fmd) == GS1_DICT_OK);
+	TEST_ASSERT(COMPILE("01 310n 15\tex=17", &fresh) == GS1_DICT_OK);
+
+	set_ai(&ais[0], "01", "09521234543213");
+	set_ai(&ais[1], "17", "251231");
+	set_ai(&ais[2], "10", "ABC");
+	set_ai(&ais[3], "21", "XYZ");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 4, fmd, &pos) == GS1_ASSOC_OK);
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, fmd, &pos) == GS1_ASSOC_PROFILE_MISSING);
+	TEST_CHECK(pos == 3);
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, &pos) == GS1_ASSOC_OK);
+
+	/*
+	 * Dictionary rules are reported before the profile.
+	 *
+	 */
+	TEST_CHECK(gs1_ai_check_associations(dict, &ais[1], 3, fmd, &pos) == GS1_ASSOC_REQUIRED_MISSING);
+	TEST_CHECK(pos == 0);
+
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 4, fresh, &pos) == GS1_ASSOC_PROFILE_MISSING);
+	TEST_CHECK(pos == 1);
+	set_ai(&ais[1], "3103", "000125");
+	set_ai(&ais[2], "15", "251231");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 4, fresh, &pos) == GS1_ASSOC_OK);
+	set_ai(&ais[3], "17", "251231");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 4, fresh, &pos) == GS1_ASSOC_PROFILE_EXCLUDED);
+	TEST_CHECK(pos == 3);
+
+	/*
+	 * The empty profile, and alternatives.
+	 *
+	 */
+	TEST_ASSERT(COMPILE("", &profile) == GS1_DICT_OK);
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 0, profile, &pos) == GS1_ASSOC_OK);
+	gs1_profile_free(profile);
+
+	TEST_ASSERT(COMPILE("req=00,01+15", &profile) == GS1_DICT_OK);
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, profile, &pos) == GS1_ASSOC_OK);
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 2, profile, &pos) == GS1_ASSOC_PROFILE_MISSING);
+	gs1_profile_free(profile);
+
+	TEST_CHECK(COMPILE("0", &profile) == GS1_DICT_INVALID_ENTRY && profile == NULL);
+	TEST_CHECK(COMPILE("01234", &profile) == GS1_DICT_INVALID_ENTRY);
+	TEST_CHECK(COMPILE("01+", &profile) == GS1_DICT_INVALID_ENTRY);
+	TEST_CHECK(COMPILE("01,,02", &profile) == GS1_DICT_INVALID_ENTRY);
+	TEST_CHECK(COMPILE("req=", &profile) == GS1_DICT_INVALID_ENTRY);
+	TEST_CHECK(COMPILE("dlpkey=01", &profile) == GS1_DICT_INVALID_ENTRY);
+	TEST_CHECK(COMPILE("0A", &profile) == GS1_DICT_INVALID_ENTRY);
+
+	gs1_profile_free(fmd);
+	gs1_profile_free(fresh);
+	gs1_dict_free(dict);
+
+#undef COMPILE
+
+}
+
+
+/*
+ * Every rule of the dictionary distributed with the library compiles, and
+ * some representative messages are checked.
+ *
+ */
+void test_associations_dictionary_file(void)
+{
+
+	gs1_dict_t *dict;
+	gs1_ai_view_t ais[4];
+	size_t pos;
+
+	if ((dict = load_dictionary_file()) == NULL)
+		return;
+
+	set_ai(&ais[0], "01", "09521234543213");
+	set_ai(&ais[1], "17", "251231");
+	set_ai(&ais[2], "10", "ABC");
+	set_ai(&ais[3], "21", "XYZ");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 4, NULL, &pos) == GS1_ASSOC_OK);
+	TEST_CHECK(gs1_ai_check_associations(dict, &ais[1], 3, NULL, &pos) == GS1_ASSOC_REQUIRED_MISSING);
+
+	set_ai(&ais[1], "3922", "12345");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 2, NULL, &pos) == GS1_ASSOC_REQUIRED_MISSING);
+	TEST_MSG("Got %d", (int)pos);
+	set_ai(&ais[2], "30", "10");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 3, NULL, &pos) == GS1_ASSOC_OK);
+	set_ai(&ais[3], "3932", "97812345");
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 4, NULL, &pos) == GS1_ASSOC_INVALID_PAIR);
+	TEST_CHECK(pos == 1);
+
+	gs1_dict_free(dict);
+
+}
+
+#endif  /* UNIT_TESTS */
@@ -0,0 +1,289 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+
+
+/*
+ * Values of up to this length are null-terminated in a stack buffer before
+ * being passed to the linter. This comfortably exceeds the length of any AI
+ * component. Longer values fall back to a heap buffer.
+ *
+ */
+#define BATCH_STACK_BUF_LEN 256
+
+
+/*
+ * Pack a linter result into 32 bits, as written by the batch functions that
+ * report the error position and length.
+ *
+ * The position and length are discarded when err is GS1_LINTER_OK. Otherwise
+ * any that exceeds 255, which only occurs for overlong data, is clamped and
+ * GS1_LINT_RESULT_CLAMPED is set.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_lint_result_t gs1_lint_result_pack(const gs1_lint_err_t err, size_t err_pos, size_t err_len)
+{
+
+	gs1_lint_result_t flags = 0;
+
+	assert((unsigned int)err < 256);
+
+	if (err == GS1_LINTER_OK)
+		return 0;
+
+	if (err_pos > 255 || err_len > 255) {
+		flags = GS1_LINT_RESULT_CLAMPED;
+		if (err_pos > 255) err_pos = 255;
+		if (err_len > 255) err_len = 255;
+	}
+
+	return (gs1_lint_result_t)err | (gs1_lint_result_t)err_pos << 8 | (gs1_lint_result_t)err_len << 16 | flags << 24;
+
+}
+
+
+/*
+ * Unpack a result that was packed by gs1_lint_result_pack(), returning the
+ * linter return code and optionally the error position and length.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_result_unpack(const gs1_lint_result_t result, size_t* const err_pos, size_t* const err_len)
+{
+
+	if (err_pos) *err_pos = GS1_LINT_RESULT_POS(result);
+	if (err_len) *err_len = GS1_LINT_RESULT_LEN(result);
+
+	return GS1_LINT_RESULT_CODE(result);
+
+}
+
+
+/*
+ * Lint each value, writing either the return code alone to codes or the packed
+ * result to results.
+ *
+ */
+static size_t lint_batch(const gs1_linter_t linter, const char* const data, const uint32_t* const offsets, const size_t count,
+			 int32_t* const codes, gs1_lint_result_t* const results)
+{
+
+	char stackbuf[BATCH_STACK_BUF_LEN];
+	char *buf = stackbuf;
+	size_t bufsize = sizeof(stackbuf);
+	size_t i, fails = 0;
+
+	assert(linter);
+	assert(data || count == 0);
+	assert(offsets);
+	assert(codes || results || count == 0);
+
+	for (i = 0; i < count; i++) {
+
+		size_t len, pos = 0, elen = 0;
+		gs1_lint_err_t err;
+		const char *nul;
+
+		assert(offsets[i] <= offsets[i+1]);
+		len = offsets[i+1] - offsets[i];
+
+		/*
+		 * The linters see only the data up to the first NUL, so a value
+		 * with an embedded NUL must be rejected rather than truncated.
+		 *
+		 */
+		nul = memchr(&data[offsets[i]], '\0', len);
+		if (nul) {
+			err = GS1_LINTER_ILLEGAL_NUL_CHARACTER;
+			if (results)
+				results[i] = gs1_lint_result_pack(err, (size_t)(nul - &data[offsets[i]]), 1);
+			else
+				codes[i] = (int32_t)err;
+			fails++;
+			continue;
+		}
+
+		if (len >= bufsize) {
+			char *newbuf = malloc(len + 1);
+			if (!newbuf) {
+				fails = SIZE_MAX;
+				goto out;
+			}
+			if (buf != stackbuf)
+				free(buf);
+			buf = newbuf;
+			bufsize = len + 1;
+		}
+
+		memcpy(buf, &data[offsets[i]], len);
+		buf[len] = '\0';
+
+		if (results) {
+			err = linter(buf, &pos, &elen);
+			results[i] = gs1_lint_result_pack(err, pos, elen);
+		} else {
+			err = linter(buf, NULL, NULL);
+			codes[i] = (int32_t)err;
+		}
+		if (err != GS1_LINTER_OK)
+			fails++;
+
+	}
+
+out:
+
+	if (buf != stackbuf)
+		free(buf);
+
+	return fails;
+
+}
+
+
+/*
+ * Apply a linter to each of a batch of values that are packed end-to-end
+ * within a single buffer.
+ *
+ * Value i occupies data[offsets[i]] to data[offsets[i+1] - 1], so offsets
+ * has count + 1 entries and must be non-decreasing. The values need not be
+ * null-terminated within the buffer. A value containing a null is reported
+ * as GS1_LINTER_ILLEGAL_NUL_CHARACTER without being passed to the linter.
+ *
+ * The linter return code for value i is written to codes[i].
+ *
+ * Returns the number of values for which the linter reported an error, or
+ * SIZE_MAX if a buffer for an overlong value could not be allocated.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_lint_batch(const gs1_linter_t linter, const char* const data, const uint32_t* const offsets, const size_t count, int32_t* const codes)
+{
+	return lint_batch(linter, data, offsets, count, codes, NULL);
+}
+
+
+/*
+ * As gs1_lint_batch(), but the result for value i, including the error
+ * position and length, is written to results[i] as a gs1_lint_result_t.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_lint_batch_results(const gs1_linter_t linter, const char* const data, const uint32_t* const offsets, const size_t count, gs1_lint_result_t* const results)
+{
+	return lint_batch(linter, data, offsets, count, NULL, results);
+}
+
+
+#ifdef UNIT_TESTS
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+void test_batch_gs1_lint_batch(void)
+{
+
+	static const char data[] = "02345673" "12345673" "" "416000336108" "4160003361O8";
+	static const uint32_t offsets[] = { 0, 8, 16, 16, 28, 40 };
+	int32_t codes[5];
+	char longdata[2 * BATCH_STACK_BUF_LEN + 1];
+	uint32_t longoffsets[3];
+	static const char nuldata[] = "095\0XYZ" "826";
+	static const uint32_t nuloffsets[] = { 0, 7, 10 };
+
+	TEST_CHECK(gs1_lint_batch(gs1_lint_csum, data, offsets, 5, codes) == 3);
+	TEST_CHECK(codes[0] == GS1_LINTER_OK);
+	TEST_CHECK(codes[1] == GS1_LINTER_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(codes[2] == GS1_LINTER_TOO_SHORT_FOR_CHECK_DIGIT);
+	TEST_CHECK(codes[3] == GS1_LINTER_OK);
+	TEST_CHECK(codes[4] == GS1_LINTER_NON_DIGIT_CHARACTER);
+
+	TEST_CHECK(gs1_lint_batch(gs1_lint_csum, data, offsets, 0, codes) == 0);
+
+	/*
+	 * Values that exceed the stack buffer, either side of a short value.
+	 *
+	 */
+	memset(longdata, 'A', sizeof(longdata) - 1);
+	longdata[sizeof(longdata) - 1] = '\0';
+	longdata[BATCH_STACK_BUF_LEN + 10] = '~';
+	longoffsets[0] = 0;
+	longoffsets[1] = BATCH_STACK_BUF_LEN + 20;
+	longoffsets[2] = BATCH_STACK_BUF_LEN + 21;
+	TEST_CHECK(gs1_lint_batch(gs1_lint_cset82, longdata, longoffsets, 2, codes) == 1);
+	TEST_CHECK(codes[0] == GS1_LINTER_INVALID_CSET82_CHARACTER);
+	TEST_CHECK(codes[1] == GS1_LINTER_OK);
+
+	/*
+	 * A value with an embedded NUL is rejected, not truncated.
+	 *
+	 */
+	TEST_CHECK(gs1_lint_batch(gs1_lint_iso3166, nuldata, nuloffsets, 2, codes) == 1);
+	TEST_CHECK(codes[0] == GS1_LINTER_ILLEGAL_NUL_CHARACTER);
+	TEST_CHECK(codes[1] == GS1_LINTER_OK);
+
+}
+
+
+void test_batch_gs1_lint_batch_results(void)
+{
+
+	static const char data[] = "02345673" "12345673" "" "4160003361O8";
+	static const uint32_t offsets[] = { 0, 8, 16, 16, 28 };
+	gs1_lint_result_t results[4];
+	char longdata[300];
+	uint32_t longoffsets[2];
+	size_t pos, len;
+
+	TEST_CHECK(sizeof(gs1_lint_result_t) == 4);
+	TEST_CHECK(__GS1_LINTER_NUM_ERRS <= 256);
+
+	TEST_CHECK(gs1_lint_batch_results(gs1_lint_csum, data, offsets, 4, results) == 3);
+	TEST_CHECK(results[0] == 0);
+	TEST_CHECK(gs1_lint_result_unpack(results[1], &pos, &len) == GS1_LINTER_INCORRECT_CHECK_DIGIT && pos == 7 && len == 1);
+	TEST_CHECK(GS1_LINT_RESULT_CODE(results[2]) == GS1_LINTER_TOO_SHORT_FOR_CHECK_DIGIT);
+	TEST_CHECK(GS1_LINT_RESULT_CODE(results[3]) == GS1_LINTER_NON_DIGIT_CHARACTER);
+	TEST_CHECK(GS1_LINT_RESULT_POS(results[3]) == 10 && GS1_LINT_RESULT_LEN(results[3]) == 1);
+	TEST_CHECK(GS1_LINT_RESULT_FLAGS(results[3]) == 0);
+
+	/*
+	 * A position beyond 255 within overlong data is clamped.
+	 *
+	 */
+	memset(longdata, 'A', sizeof(longdata));
+	longdata[280] = '~';
+	longoffsets[0] = 0;
+	longoffsets[1] = sizeof(longdata);
+	TEST_CHECK(gs1_lint_batch_results(gs1_lint_cset82, longdata, longoffsets, 1, results) == 1);
+	TEST_CHECK(gs1_lint_result_unpack(results[0], &pos, &len) == GS1_LINTER_INVALID_CSET82_CHARACTER && pos == 255 && len == 1);
+	TEST_CHECK(GS1_LINT_RESULT_FLAGS(results[0]) == GS1_LINT_RESULT_CLAMPED);
+
+	longdata[0] = '0';
+	longdata[1] = '\0';
+	TEST_CHECK(gs1_lint_batch_results(gs1_lint_cset82, longdata, longoffsets, 1, results) == 1);
+	TEST_CHECK(gs1_lint_result_unpack(results[0], &pos, &len) == GS1_LINTER_ILLEGAL_NUL_CHARACTER && pos == 1 && len == 1);
+
+	TEST_CHECK(gs1_lint_result_pack(GS1_LINTER_OK, 3, 4) == 0);
+	TEST_CHECK(gs1_lint_result_unpack(gs1_lint_result_pack(GS1_LINTER_DATA_TOO_LONG, 90, 255), &pos, &len) == GS1_LINTER_DATA_TOO_LONG && pos == 90 && len == 255);
+	TEST_CHECK(GS1_LINT_RESULT_FLAGS(gs1_lint_result_pack(GS1_LINTER_DATA_TOO_LONG, 90, 256)) == GS1_LINT_RESULT_CLAMPED);
+
+}
+
+#endif  /* UNIT_TESTS */
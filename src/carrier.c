@@ -0,0 +1,1041 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Planning of the barcode symbol that carries AI data that has already been
+ * validated.
+ *
+ * A GS1-128 symbol is a sequence of Code 128 symbol characters, each 11
+ * modules wide. The element string is encoded with FNC1 in first position and
+ * an FNC1 separator after each AI that is neither of predefined length nor
+ * last. Code Set C encodes a pair of digits per character, Code Sets A and B
+ * encode one character each, and FNC1 is available in every set. Changing
+ * set costs a character, as does a SHIFT between A and B for one character.
+ *
+ * The shortest sequence is found by dynamic programming over the position in
+ * the element string and the current code set, which costs a few operations
+ * per character of data.
+ *
+ * The lengths in GS1 DataMatrix and GS1 QR Code are computed in the same way
+ * and looked up in each symbology's table of capacities, so that a carrier
+ * and symbol size can be chosen without trial encoding.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+
+
+/*
+ * A GS1-128 symbol has at most 48 data characters, so longer element strings
+ * can be rejected without being planned. Nor does any DataMatrix or QR Code
+ * symbol hold more than about 7000 characters.
+ *
+ */
+#define MAX_TOKENS		256
+#define MAX_AIS			(MAX_TOKENS / 3)
+#define MAX_ESTIMATE_TOKENS	8192
+#define MAX_ESTIMATE_AIS	(MAX_ESTIMATE_TOKENS / 3)
+
+#define GS1_128_MAX_DATA	48
+
+#define TOK_FNC1	0x100
+
+#define SET_A		0
+#define SET_B		1
+#define SET_C		2
+
+#define C128_SHIFT	98
+#define C128_CODE_C	99
+#define C128_CODE_B	100
+#define C128_CODE_A	101
+#define C128_FNC1	102
+#define C128_START_A	103
+#define C128_STOP	106
+
+#define COST_INF	UINT16_MAX
+
+enum step {
+	STEP_START,
+	STEP_SWITCH,
+	STEP_FNC1,
+	STEP_PAIR,
+	STEP_CHAR,
+	STEP_SHIFT,
+};
+
+struct cell {
+	uint16_t cost;
+	uint8_t step;
+	uint8_t from;		/* Previous set, for STEP_SWITCH */
+};
+
+
+#define IS_DIGIT(t)	((t) >= '0' && (t) <= '9')
+#define IN_SET(s, t)	((s) == SET_A ? (t) < 96 : (t) >= 32)
+
+
+static int fixed_length(const gs1_dict_t* const dict, const gs1_ai_view_t* const v)
+{
+
+	int entry;
+
+	return dict && (entry = gs1_dict_find(dict, v->ai, v->ai_len)) >= 0 &&
+		(gs1_dict_flags(dict, entry) & GS1_DICT_FLAG_FIXED_LENGTH);
+
+}
+
+
+/*
+ * Orders in which to try the AIs: as given; or, with GS1_128_REORDER, the AIs
+ * of predefined length followed by the others, rotating each of those in turn
+ * into last place where it needs no separator. Returns the number of orders.
+ *
+ */
+static size_t first_order(const gs1_ai_view_t* const ais, const size_t count, const gs1_dict_t* const dict,
+			  const unsigned int flags, uint16_t* const seq, size_t* const nfixed)
+{
+
+	size_t i, nvar;
+
+	*nfixed = 0;
+	for (i = 0; i < count; i++)
+		if (!(flags & GS1_128_REORDER) || fixed_length(dict, &ais[i]))
+			seq[(*nfixed)++] = (uint16_t)i;
+	for (nvar = 0, i = 0; i < count; i++)
+		if ((flags & GS1_128_REORDER) && !fixed_length(dict, &ais[i]))
+			seq[*nfixed + nvar++] = (uint16_t)i;
+
+	return nvar ? nvar : 1;
+
+}
+
+
+static void next_order(uint16_t* const seq, const size_t count, const size_t nfixed)
+{
+
+	const uint16_t last = seq[count - 1];
+
+	memmove(&seq[nfixed + 1], &seq[nfixed], (count - nfixed - 1) * sizeof(seq[0]));
+	seq[nfixed] = last;
+
+}
+
+
+/*
+ * The element string as a sequence of characters and FNC1s, or 0 if it is
+ * longer than max.
+ *
+ */
+static size_t tokenise(const gs1_ai_view_t* const ais, const size_t count, const gs1_dict_t* const dict,
+		       const uint16_t* const order, uint16_t* const tok, const size_t max)
+{
+
+	size_t k, i, n = 0;
+
+	tok[n++] = TOK_FNC1;
+
+	for (k = 0; k < count; k++) {
+
+		const gs1_ai_view_t* const v = &ais[order[k]];
+
+		if (v->ai_len + v->value_len + 1 > max - n)
+			return 0;
+
+		for (i = 0; i < v->ai_len; i++)
+			tok[n++] = (unsigned char)v->ai[i];
+		for (i = 0; i < v->value_len; i++)
+			tok[n++] = (unsigned char)v->value[i];
+
+		if (k < count - 1 && !fixed_length(dict, v))
+			tok[n++] = TOK_FNC1;
+
+	}
+
+	return n;
+
+}
+
+
+static void relax(struct cell* const c, const unsigned int cost, const enum step step, const int from)
+{
+	if (cost < c->cost) {
+		c->cost = (uint16_t)cost;
+		c->step = (uint8_t)step;
+		c->from = (uint8_t)from;
+	}
+}
+
+
+/*
+ * Fills dp[i][s] with the fewest symbol characters that encode the first i
+ * tokens, finishing in set s, and returns the set that finishes the cheapest
+ * encoding of all n tokens. Characters above 127 cannot be encoded, leaving
+ * the cost at COST_INF.
+ *
+ */
+static int shortest(const uint16_t* const tok, const size_t n, struct cell dp[][3])
+{
+
+	size_t i;
+	int s, m;
+
+	for (i = 0; i <= n; i++)
+		for (s = 0; s < 3; s++)
+			dp[i][s].cost = COST_INF;
+
+	for (s = 0; s < 3; s++)
+		relax(&dp[0][s], 0, STEP_START, s);
+
+	for (i = 0; ; i++) {
+
+		/*
+		 * Switching twice at the same position never helps, so each set
+		 * need only be reached from the cheapest.
+		 *
+		 */
+		for (m = 0, s = 1; s < 3; s++)
+			if (dp[i][s].cost < dp[i][m].cost)
+				m = s;
+		for (s = 0; s < 3; s++)
+			if (s != m)
+				relax(&dp[i][s], dp[i][m].cost + 1u, STEP_SWITCH, m);
+
+		if (i == n)
+			return m;
+
+		for (s = 0; s < 3; s++) {
+			const unsigned int cost = dp[i][s].cost;
+			const uint16_t t = tok[i];
+			if (cost == COST_INF)
+				continue;
+			if (t == TOK_FNC1)
+				relax(&dp[i+1][s], cost + 1, STEP_FNC1, s);
+			else if (s == SET_C) {
+				if (IS_DIGIT(t) && i + 1 < n && IS_DIGIT(tok[i+1]))
+					relax(&dp[i+2][s], cost + 1, STEP_PAIR, s);
+			} else if (t > 127)
+				continue;
+			else if (IN_SET(s, t))
+				relax(&dp[i+1][s], cost + 1, STEP_CHAR, s);
+			else
+				relax(&dp[i+1][s], cost + 2, STEP_SHIFT, s);
+		}
+
+	}
+
+}
+
+
+/*
+ * Writes the symbol characters of the encoding found by shortest(), from the
+ * start character to the stop character.
+ *
+ */
+static void emit(const uint16_t* const tok, const size_t n, struct cell dp[][3], int s, uint8_t* const codes)
+{
+
+	struct {
+		uint16_t i;
+		uint8_t s;
+		uint8_t step;
+	} path[2 * MAX_TOKENS + 1];
+	size_t i = n, p = 0, k, len;
+	unsigned int sum;
+
+	while (dp[i][s].step != STEP_START) {
+		path[p].i = (uint16_t)i;
+		path[p].s = (uint8_t)s;
+		path[p].step = dp[i][s].step;
+		p++;
+		switch (dp[i][s].step) {
+		case STEP_SWITCH: s = dp[i][s].from; break;
+		case STEP_PAIR:   i -= 2; break;
+		default:          i -= 1; break;
+		}
+	}
+
+	len = 0;
+	codes[len++] = (uint8_t)(C128_START_A + s);
+
+	while (p--) {
+		const int set = path[p].s;
+		const uint16_t t = tok[path[p].i - (path[p].step == STEP_PAIR ? 2 : 1)];
+		switch (path[p].step) {
+		case STEP_SWITCH:
+			codes[len++] = set == SET_A ? C128_CODE_A : set == SET_B ? C128_CODE_B : C128_CODE_C;
+			break;
+		case STEP_FNC1:
+			codes[len++] = C128_FNC1;
+			break;
+		case STEP_PAIR:
+			codes[len++] = (uint8_t)((t - '0') * 10 + tok[path[p].i - 1] - '0');
+			break;
+		case STEP_SHIFT:
+			codes[len++] = C128_SHIFT;
+			codes[len++] = (uint8_t)(t < 32 ? t + 64 : t - 32);
+			break;
+		default:
+			codes[len++] = (uint8_t)(t < 32 ? t + 64 : t - 32);
+			break;
+		}
+	}
+
+	for (sum = codes[0], k = 1; k < len; k++)
+		sum += (unsigned int)k * codes[k];
+	codes[len++] = (uint8_t)(sum % 103);
+	codes[len] = C128_STOP;
+
+}
+
+
+/*
+ * Body of gs1_128_plan(), which rejects data of more than max_data data
+ * characters. The estimate reports the length of overlong data as well.
+ *
+ */
+static size_t plan(const gs1_ai_view_t* const ais, const size_t count, const gs1_dict_t* const dict, const unsigned int flags,
+		   const size_t max_data, size_t* const order, uint8_t* const codes, const size_t codes_len)
+{
+
+	uint16_t tok[MAX_TOKENS];
+	struct cell dp[MAX_TOKENS + 1][3];
+	uint16_t seq[MAX_AIS], best[MAX_AIS];
+	size_t i, j, orders, nfixed, n, cost, min = COST_INF;
+	int s;
+
+	assert(ais || count == 0);
+
+	if (count > MAX_AIS)
+		return SIZE_MAX;
+
+	orders = first_order(ais, count, dict, flags, seq, &nfixed);
+	for (j = 0; j < orders; j++) {
+
+		if (j > 0)
+			next_order(seq, count, nfixed);
+
+		if ((n = tokenise(ais, count, dict, seq, tok, MAX_TOKENS)) == 0)
+			return SIZE_MAX;
+
+		s = shortest(tok, n, dp);
+		if ((cost = dp[n][s].cost) < min) {
+			min = cost;
+			memcpy(best, seq, count * sizeof(seq[0]));
+		}
+
+	}
+
+	if (min == COST_INF || min > max_data)
+		return SIZE_MAX;
+
+	if (order)
+		for (i = 0; i < count; i++)
+			order[i] = best[i];
+
+	if (!codes)
+		return min + 3;
+
+	if (min + 3 > codes_len)
+		return SIZE_MAX;
+
+	n = tokenise(ais, count, dict, best, tok, MAX_TOKENS);
+	s = shortest(tok, n, dp);
+	emit(tok, n, dp, s, codes);
+
+	return min + 3;
+
+}
+
+
+/**
+ * Plan the shortest GS1-128 symbol that carries some AI data.
+ *
+ * An FNC1 separator follows each AI except the last, unless the dictionary
+ * flags the AI as having a predefined length. Without a dictionary, every AI
+ * is separated. The sequence of code sets with the fewest symbol characters
+ * is found exactly.
+ *
+ * With #GS1_128_REORDER, the AIs of predefined length are placed first and
+ * each of the others is tried as the last, which needs no separator, to find
+ * the order that gives the shortest symbol.
+ *
+ * The width of the symbol, excluding the quiet zones, is 11 modules for each
+ * symbol character plus 2 for the stop pattern.
+ *
+ * @param [in] ais The AI data, which should have been validated.
+ * @param [in] count The number of AIs.
+ * @param [in] dict A dictionary providing the predefined-length flags, or
+ *                  `NULL`.
+ * @param [in] flags Either 0 or #GS1_128_REORDER.
+ * @param [out] order If not `NULL`, receives the index of each AI, in the
+ *                    order that they are encoded.
+ * @param [out] codes If not `NULL`, receives the Code 128 symbol character
+ *                    values, from the start character to the stop character.
+ * @param [in] codes_len The size of codes.
+ *
+ * @return the number of symbol characters, including the start, check and
+ *         stop characters, or SIZE_MAX if the data needs more than the 48
+ *         data characters that a GS1-128 symbol allows, contains a character
+ *         that it cannot encode, or the symbol characters do not fit in codes.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_128_plan(const gs1_ai_view_t* const ais, const size_t count, const gs1_dict_t* const dict,
+					      const unsigned int flags, size_t* const order, uint8_t* const codes, const size_t codes_len)
+{
+
+	return plan(ais, count, dict, flags, GS1_128_MAX_DATA, order, codes, codes_len);
+
+}
+
+
+/*
+ * ECC200 data capacities, in order of capacity, and for equal capacity in
+ * order of area.
+ *
+ */
+static const struct {
+	uint8_t rows;
+	uint8_t cols;
+	uint16_t codewords;
+} dm_sizes[] = {
+	{  10,  10,    3 }, {  12,  12,    5 }, {   8,  18,    5 }, {  14,  14,    8 },
+	{   8,  32,   10 }, {  16,  16,   12 }, {  12,  26,   16 }, {  18,  18,   18 },
+	{  20,  20,   22 }, {  12,  36,   22 }, {  22,  22,   30 }, {  16,  36,   32 },
+	{  24,  24,   36 }, {  26,  26,   44 }, {  16,  48,   49 }, {  32,  32,   62 },
+	{  36,  36,   86 }, {  40,  40,  114 }, {  44,  44,  144 }, {  48,  48,  174 },
+	{  52,  52,  204 }, {  64,  64,  280 }, {  72,  72,  368 }, {  80,  80,  456 },
+	{  88,  88,  576 }, {  96,  96,  696 }, { 104, 104,  816 }, { 120, 120, 1050 },
+	{ 132, 132, 1304 }, { 144, 144, 1558 },
+};
+
+
+/*
+ * QR Code data codewords for each version and error correction level.
+ *
+ */
+static const uint16_t qr_codewords[40][4] = {
+	{   19,   16,   13,    9 }, {   34,   28,   22,   16 }, {   55,   44,   34,   26 }, {   80,   64,   48,   36 },
+	{  108,   86,   62,   46 }, {  136,  108,   76,   60 }, {  156,  124,   88,   66 }, {  194,  154,  110,   86 },
+	{  232,  182,  132,  100 }, {  274,  216,  154,  122 }, {  324,  254,  180,  140 }, {  370,  290,  206,  158 },
+	{  428,  334,  244,  180 }, {  461,  365,  261,  197 }, {  523,  415,  295,  223 }, {  589,  453,  325,  253 },
+	{  647,  507,  367,  283 }, {  721,  563,  397,  313 }, {  795,  627,  445,  341 }, {  861,  669,  485,  385 },
+	{  932,  714,  512,  406 }, { 1006,  782,  568,  442 }, { 1094,  860,  614,  464 }, { 1174,  914,  664,  514 },
+	{ 1276, 1000,  718,  538 }, { 1370, 1062,  754,  596 }, { 1468, 1128,  808,  628 }, { 1531, 1193,  871,  661 },
+	{ 1631, 1267,  911,  701 }, { 1735, 1373,  985,  745 }, { 1843, 1455, 1033,  793 }, { 1955, 1541, 1115,  845 },
+	{ 2071, 1631, 1171,  901 }, { 2191, 1725, 1231,  961 }, { 2306, 1812, 1286,  986 }, { 2434, 1914, 1354, 1054 },
+	{ 2566, 1992, 1426, 1096 }, { 2702, 2102, 1502, 1142 }, { 2812, 2216, 1582, 1222 }, { 2956, 2334, 1666, 1276 },
+};
+
+#define QR_NUMERIC	0
+#define QR_ALNUM	1
+#define QR_BYTE		2
+
+#define QR_GROUP(v)	((v) < 10 ? 0 : (v) < 27 ? 1 : 2)
+
+
+/*
+ * DataMatrix ASCII encodation: a pair of digits, any other character up to
+ * 127 or FNC1 takes one codeword, and a character above 127 takes two, with
+ * Upper Shift. Pairing digits greedily is optimal.
+ *
+ */
+static size_t dm_length(const uint16_t* const tok, const size_t n)
+{
+
+	size_t i, cw = 0;
+
+	for (i = 0; i < n; i++, cw++) {
+		if (IS_DIGIT(tok[i]) && i + 1 < n && IS_DIGIT(tok[i+1]))
+			i++;
+		else if (tok[i] != TOK_FNC1 && tok[i] > 127)
+			cw++;
+	}
+
+	return cw;
+
+}
+
+
+static int qr_alnum(const uint16_t t)
+{
+	return IS_DIGIT(t) || (t >= 'A' && t <= 'Z') || (t != 0 && t < 128 && strchr(" $%*+-./:", t) != NULL);
+}
+
+
+/*
+ * The fewest bits that encode the element string in a QR Code symbol with
+ * the character count indicators of the given group of versions.
+ *
+ * The leading FNC1 is the FNC1 in first position mode indicator. Subsequent
+ * FNC1s are '%' in alphanumeric mode, where a literal '%' is doubled, or GS
+ * in byte mode. Segments are chosen by dynamic programming over the position
+ * and the current mode, with costs in sixths of a bit so that the 10 bits per
+ * 3 digits and 11 bits per 2 alphanumeric characters accrue per character,
+ * rounding up at the end of each segment.
+ *
+ */
+static size_t qr_length(const uint16_t* const tok, const size_t n, const int group)
+{
+
+	static const uint8_t count_bits[3][3] = {
+		{ 10,  9,  8 },
+		{ 12, 11, 16 },
+		{ 14, 13, 16 },
+	};
+
+	size_t cost[3], next[3], head[3], c, best = SIZE_MAX;
+	size_t i;
+	int m, j;
+
+	if (n <= 1)
+		return 4;
+
+	for (m = 0; m < 3; m++)
+		cost[m] = head[m] = (4u + count_bits[group][m]) * 6;
+
+	for (i = 1; i < n; i++) {
+
+		const uint16_t t = tok[i];
+
+		next[QR_NUMERIC] = IS_DIGIT(t) ? cost[QR_NUMERIC] + 20 : SIZE_MAX;
+		next[QR_ALNUM] = t == TOK_FNC1 || (t != '%' && qr_alnum(t)) ? cost[QR_ALNUM] + 33 :
+				 t == '%' ? cost[QR_ALNUM] + 66 : SIZE_MAX;
+		next[QR_BYTE] = cost[QR_BYTE] + 48;
+
+		for (j = 0; j < 3; j++)
+			for (m = 0; m < 3; m++)
+				if (next[m] != SIZE_MAX && (c = (next[m] + 5) / 6 * 6 + head[j]) < next[j])
+					next[j] = c;
+
+		memcpy(cost, next, sizeof(cost));
+
+	}
+
+	for (m = 0; m < 3; m++)
+		if ((cost[m] + 5) / 6 < best)
+			best = (cost[m] + 5) / 6;
+
+	return 4 + best;
+
+}
+
+
+/**
+ * Estimate the length of some AI data when encoded in each GS1 carrier, and
+ * the smallest symbol of each that holds it, without encoding it.
+ *
+ * The GS1-128 length is that found by gs1_128_plan(), and is also given for
+ * data that is too long for a GS1-128 symbol, whose width is then 0. The GS1
+ * DataMatrix length is for ASCII encodation with digit pairs, and the
+ * smallest square symbol is chosen, or the smallest of either shape with
+ * #GS1_CARRIER_DM_RECT. The GS1 QR Code length is for the optimal sequence
+ * of numeric, alphanumeric and byte mode segments, and the smallest version
+ * is chosen for the given error correction level.
+ *
+ * With #GS1_128_REORDER, the best order of the AIs is found for each carrier
+ * separately, as described for gs1_128_plan().
+ *
+ * @param [in] ais The AI data, which should have been validated.
+ * @param [in] count The number of AIs.
+ * @param [in] dict A dictionary providing the predefined-length flags, or
+ *                  `NULL`.
+ * @param [in] flags A combination of #GS1_128_REORDER and
+ *                   #GS1_CARRIER_DM_RECT.
+ * @param [in] ec The QR Code error correction level.
+ * @param [out] est The estimate for each carrier.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_carrier_estimate(const gs1_ai_view_t* const ais, const size_t count, const gs1_dict_t* const dict,
+						    const unsigned int flags, const gs1_qr_ec_t ec, gs1_carrier_estimate_t* const est)
+{
+
+	uint16_t tok[MAX_ESTIMATE_TOKENS];
+	uint16_t seq[MAX_ESTIMATE_AIS];
+	size_t qr[3] = { SIZE_MAX, SIZE_MAX, SIZE_MAX };
+	size_t i, j, orders, nfixed, n, len;
+	int g;
+
+	assert(ais || count == 0);
+	assert(est);
+	assert(ec >= GS1_QR_EC_L && ec <= GS1_QR_EC_H);
+
+	memset(est, 0, sizeof(*est));
+
+	len = plan(ais, count, dict, flags & GS1_128_REORDER, SIZE_MAX, NULL, NULL, 0);
+	if (len != SIZE_MAX) {
+		est->gs1_128_chars = len;
+		if (len - 3 <= GS1_128_MAX_DATA)
+			est->gs1_128_modules = 11 * len + 2;
+	}
+
+	if (count > MAX_ESTIMATE_AIS)
+		return;
+
+	est->dm_codewords = SIZE_MAX;
+	orders = first_order(ais, count, dict, flags, seq, &nfixed);
+	for (j = 0; j < orders; j++) {
+
+		if (j > 0)
+			next_order(seq, count, nfixed);
+
+		if ((n = tokenise(ais, count, dict, seq, tok, MAX_ESTIMATE_TOKENS)) == 0) {
+			est->dm_codewords = 0;
+			return;
+		}
+
+		if ((len = dm_length(tok, n)) < est->dm_codewords)
+			est->dm_codewords = len;
+		for (g = 0; g < 3; g++)
+			if ((len = qr_length(tok, n, g)) < qr[g])
+				qr[g] = len;
+
+	}
+
+	for (i = 0; i < sizeof(dm_sizes) / sizeof(dm_sizes[0]); i++) {
+		if (dm_sizes[i].rows != dm_sizes[i].cols && !(flags & GS1_CARRIER_DM_RECT))
+			continue;
+		if (dm_sizes[i].codewords >= est->dm_codewords) {
+			est->dm_rows = dm_sizes[i].rows;
+			est->dm_cols = dm_sizes[i].cols;
+			break;
+		}
+	}
+
+	est->qr_bits = qr[2];
+	for (i = 1; i <= 40; i++) {
+		if (qr[QR_GROUP(i)] <= qr_codewords[i-1][ec] * 8u) {
+			est->qr_bits = qr[QR_GROUP(i)];
+			est->qr_version = (unsigned int)i;
+			break;
+		}
+	}
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#include "unittest.h"
+
+
+static const char test_dict[] =
+	"00         *?  N18,csum,key                  ex=01,02                                            # SSCC\n"
+	"01         *?  N14,csum,key                  ex=02,255,37 dlpkey=22,10,21|235                    # GTIN\n"
+	"10          ?  X..20                         req=01,02,8006,8026                                 # BATCH/LOT\n"
+	"17         *?  N6,yymmd0                     req=01,02,255,8006,8026                             # USE BY or EXPIRY\n"
+	"21          ?  X..20                         req=01,8006 ex=235                                  # SERIAL\n"
+	"3100-3105  *?  N6                            req=01,02 ex=310n                                   # NET WEIGHT (kg)\n"
+	"37          ?  N..8                          req=02,8026                                         # COUNT\n";
+
+
+/*
+ * Reference: the cost of every assignment of code sets to the tokens, by
+ * exhaustive search, for short element strings.
+ *
+ */
+static unsigned int exhaustive(const uint16_t* const tok, const size_t n, const size_t i, const int s)
+{
+
+	unsigned int best = COST_INF, c;
+	int t;
+
+	if (i == n)
+		return 0;
+
+	for (t = 0; t < 3; t++) {
+		const unsigned int sw = s >= 0 && t != s;
+		if (tok[i] == TOK_FNC1)
+			c = 1 + exhaustive(tok, n, i + 1, t);
+		else if (t == SET_C)
+			c = IS_DIGIT(tok[i]) && i + 1 < n && IS_DIGIT(tok[i+1]) ? 1 + exhaustive(tok, n, i + 2, t) : COST_INF;
+		else
+			c = (IN_SET(t, tok[i]) ? 1 : 2) + exhaustive(tok, n, i + 1, t);
+		if (c < COST_INF && c + sw < best)
+			best = c + sw;
+	}
+
+	return best;
+
+}
+
+
+/*
+ * Decode the symbol characters back to the element string, with FNC1 shown
+ * as '^', verifying the check character.
+ *
+ */
+static int decode(const uint8_t* const codes, const size_t len, char* const out)
+{
+
+	size_t k, o = 0;
+	unsigned int sum = codes[0];
+	int set, shift = 0;
+
+	if (codes[0] < C128_START_A || codes[0] > C128_START_A + 2 || codes[len-1] != C128_STOP)
+		return 0;
+	set = codes[0] - C128_START_A;
+
+	for (k = 1; k < len - 2; k++) {
+		const int v = codes[k];
+		const int cur = shift ? (set == SET_A ? SET_B : SET_A) : set;
+		sum += (unsigned int)k * codes[k];
+		shift = 0;
+		if (v == C128_FNC1)
+			out[o++] = '^';
+		else if (cur == SET_C && v < 100) {
+			out[o++] = (char)('0' + v / 10);
+			out[o++] = (char)('0' + v % 10);
+		} else if (cur != SET_C && v < 96)
+			out[o++] = (char)(cur == SET_A && v >= 64 ? v - 64 : v + 32);
+		else if (v == C128_SHIFT && cur != SET_C)
+			shift = 1;
+		else if (v == C128_CODE_A || v == C128_CODE_B || v == C128_CODE_C)
+			set = v == C128_CODE_A ? SET_A : v == C128_CODE_B ? SET_B : SET_C;
+		else
+			return 0;
+	}
+	out[o] = '\0';
+
+	return sum % 103 == codes[len-2];
+
+}
+
+
+void test_carrier_gs1_128_plan(void)
+{
+
+	gs1_dict_t *dict;
+	gs1_ai_view_t ais[4];
+	uint8_t codes[64];
+	size_t order[4];
+	char buf[128];
+	size_t n;
+
+	TEST_ASSERT(gs1_dict_load(test_dict, strlen(test_dict), &dict, NULL) == GS1_DICT_OK);
+
+	/*
+	 * All digits: Start C, FNC1, 8 pairs, check, stop.
+	 *
+	 */
+	set_ai(&ais[0], "01", "09521234543213");
+	TEST_CHECK((n = gs1_128_plan(ais, 1, dict, 0, NULL, codes, sizeof(codes))) == 12);
+	TEST_CHECK(codes[0] == C128_START_A + SET_C && codes[1] == C128_FNC1 && codes[2] == 1 && codes[3] == 9);
+	TEST_CHECK(decode(codes, n, buf) && strcmp(buf, "^0109521234543213") == 0);
+	TEST_CHECK(gs1_128_plan(ais, 1, dict, 0, NULL, NULL, 0) == 12);
+	TEST_CHECK(gs1_128_plan(ais, 1, dict, 0, NULL, codes, 11) == SIZE_MAX);
+
+	/*
+	 * A variable-length AI that is not last is followed by FNC1, and a
+	 * lower-case character is taken in Code Set B.
+	 *
+	 */
+	set_ai(&ais[0], "10", "ABC123");
+	set_ai(&ais[1], "17", "251231");
+	TEST_CHECK((n = gs1_128_plan(ais, 2, dict, 0, NULL, codes, sizeof(codes))) != SIZE_MAX);
+	TEST_CHECK(decode(codes, n, buf) && strcmp(buf, "^10ABC123^17251231") == 0);
+
+	set_ai(&ais[0], "21", "abc");
+	TEST_CHECK((n = gs1_128_plan(ais, 1, dict, 0, NULL, codes, sizeof(codes))) != SIZE_MAX);
+	TEST_CHECK(decode(codes, n, buf) && strcmp(buf, "^21abc") == 0);
+	TEST_CHECK(n == 9);	/* Start C, FNC1, 21, Code B, a, b, c, check, stop */
+
+	/*
+	 * Without the dictionary, the predefined-length AI (01) is separated.
+	 *
+	 */
+	set_ai(&ais[0], "01", "09521234543213");
+	set_ai(&ais[1], "10", "ABC");
+	TEST_CHECK((n = gs1_128_plan(ais, 2, NULL, 0, NULL, codes, sizeof(codes))) != SIZE_MAX);
+	TEST_CHECK(decode(codes, n, buf) && strcmp(buf, "^0109521234543213^10ABC") == 0);
+	TEST_CHECK((n = gs1_128_plan(ais, 2, dict, 0, NULL, codes, sizeof(codes))) != SIZE_MAX);
+	TEST_CHECK(decode(codes, n, buf) && strcmp(buf, "^010952123454321310ABC") == 0);
+
+	/*
+	 * Reordering places the predefined-length AIs first and avoids a
+	 * separator after the longer variable-length AI.
+	 *
+	 */
+	set_ai(&ais[0], "10", "ABCDEF");
+	set_ai(&ais[1], "37", "12");
+	set_ai(&ais[2], "01", "09521234543213");
+	set_ai(&ais[3], "21", "12345678");
+	TEST_CHECK((n = gs1_128_plan(ais, 4, dict, GS1_128_REORDER, order, codes, sizeof(codes))) != SIZE_MAX);
+	TEST_CHECK(n <= gs1_128_plan(ais, 4, dict, 0, NULL, NULL, 0));
+	TEST_CHECK(order[0] == 2);
+	TEST_CHECK(decode(codes, n, buf));
+	TEST_MSG("Got: %s", buf);
+
+	/*
+	 * Unencodable and overlong data.
+	 *
+	 */
+	set_ai(&ais[0], "10", "AB\xe9");
+	TEST_CHECK(gs1_128_plan(ais, 1, dict, 0, NULL, codes, sizeof(codes)) == SIZE_MAX);
+	memset(buf, '1', sizeof(buf));
+	ais[0].value = buf;
+	ais[0].value_len = sizeof(buf);
+	set_ai(&ais[1], "10", "A");
+	ais[1].value = buf;
+	ais[1].value_len = sizeof(buf);
+	TEST_CHECK(gs1_128_plan(ais, 2, dict, 0, NULL, NULL, 0) == SIZE_MAX);
+
+	/*
+	 * FNC1 and 47 pairs of digits fill the 48 data characters; one more pair
+	 * is too long.
+	 *
+	 */
+	set_ai(&ais[0], "91", "");
+	ais[0].value = buf;
+	ais[0].value_len = 92;
+	TEST_CHECK(gs1_128_plan(ais, 1, NULL, 0, NULL, NULL, 0) == 51);
+	ais[0].value_len = 94;
+	TEST_CHECK(gs1_128_plan(ais, 1, NULL, 0, NULL, NULL, 0) == SIZE_MAX);
+
+	gs1_dict_free(dict);
+
+}
+
+
+/*
+ * The plan is no longer than the best found by exhaustive search, and decodes
+ * to the element string, for short mixtures of digits and characters of each
+ * code set.
+ *
+ */
+void test_carrier_gs1_128_optimal(void)
+{
+
+	static const char chars[] = "0123456789AZaz\x01/";
+	uint16_t tok[MAX_TOKENS];
+	uint8_t codes[64];
+	char value[12], expect[32], buf[128];
+	gs1_ai_view_t ai;
+	size_t n, len, i;
+	uint32_t x = 2463534242u;
+	int r, ok = 1;
+	uint16_t seq = 0;
+
+	for (r = 0; r < 3000 && ok; r++) {
+
+		x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+		len = 1 + x % (sizeof(value) - 1);
+		for (i = 0; i < len; i++) {
+			x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+			value[i] = chars[(x >> 8) % (i % 3 ? 10 : sizeof(chars) - 1)];
+		}
+		value[len] = '\0';
+		set_ai(&ai, "91", value);
+
+		n = tokenise(&ai, 1, NULL, &seq, tok, MAX_TOKENS);
+		TEST_ASSERT(n > 0);
+		if (gs1_128_plan(&ai, 1, NULL, 0, NULL, codes, sizeof(codes)) != exhaustive(tok, n, 0, -1) + 3u) {
+			ok = 0;
+			TEST_MSG("Not optimal for \"%s\"", value);
+		}
+		snprintf(expect, sizeof(expect), "^91%s", value);
+		if (!decode(codes, gs1_128_plan(&ai, 1, NULL, 0, NULL, codes, sizeof(codes)), buf) || strcmp(buf, expect) != 0) {
+			ok = 0;
+			TEST_MSG("Bad encoding for \"%s\"", value);
+		}
+
+	}
+
+	TEST_CHECK(ok);
+
+}
+
+
+void test_carrier_estimate(void)
+{
+
+	gs1_dict_t *dict;
+	gs1_ai_view_t ais[3];
+	gs1_carrier_estimate_t est;
+	char buf[3200];
+
+	TEST_ASSERT(gs1_dict_load(test_dict, strlen(test_dict), &dict, NULL) == GS1_DICT_OK);
+
+	/*
+	 * FNC1 and 8 digit pairs: 9 codewords. The 72 bits of QR Code data fill
+	 * version 1 even at level H.
+	 *
+	 */
+	set_ai(&ais[0], "01", "09521234543213");
+	gs1_carrier_estimate(ais, 1, dict, 0, GS1_QR_EC_H, &est);
+	TEST_CHECK(est.gs1_128_chars == 12);
+	TEST_CHECK(est.gs1_128_modules == 134);
+	TEST_CHECK(est.dm_codewords == 9);
+	TEST_CHECK(est.dm_rows == 16 && est.dm_cols == 16);
+	TEST_CHECK(est.qr_bits == 72);
+	TEST_CHECK(est.qr_version == 1);
+
+	gs1_carrier_estimate(ais, 1, dict, GS1_CARRIER_DM_RECT, GS1_QR_EC_H, &est);
+	TEST_CHECK(est.dm_rows == 8 && est.dm_cols == 32);
+
+	/*
+	 * Numeric then alphanumeric segments: 4 + 74 + 46 bits.
+	 *
+	 */
+	set_ai(&ais[1], "10", "ABC123");
+	gs1_carrier_estimate(ais, 2, dict, 0, GS1_QR_EC_M, &est);
+	TEST_CHECK(est.dm_codewords == 15);
+	TEST_CHECK(est.dm_rows == 18 && est.dm_cols == 18);
+	TEST_CHECK(est.qr_bits == 124);
+	TEST_CHECK(est.qr_version == 1);
+	gs1_carrier_estimate(ais, 2, dict, 0, GS1_QR_EC_Q, &est);
+	TEST_CHECK(est.qr_version == 2);
+
+	/*
+	 * Reordering avoids a separator in every carrier.
+	 *
+	 */
+	set_ai(&ais[0], "10", "ABC123");
+	set_ai(&ais[1], "21", "XYZ");
+	set_ai(&ais[2], "01", "09521234543213");
+	gs1_carrier_estimate(ais, 3, dict, 0, GS1_QR_EC_L, &est);
+	TEST_CHECK(est.dm_codewords == 21);
+	gs1_carrier_estimate(ais, 3, dict, GS1_128_REORDER, GS1_QR_EC_L, &est);
+	TEST_CHECK(est.dm_codewords == 20);
+
+	/*
+	 * A character above 127 takes two DataMatrix codewords and byte mode in
+	 * QR Code, and cannot be encoded in GS1-128.
+	 *
+	 */
+	set_ai(&ais[0], "91", "\xe9");
+	gs1_carrier_estimate(ais, 1, NULL, 0, GS1_QR_EC_L, &est);
+	TEST_CHECK(est.gs1_128_chars == 0 && est.gs1_128_modules == 0);
+	TEST_CHECK(est.dm_codewords == 4);
+	TEST_CHECK(est.qr_bits == 4 + 4 + 8 + 24);
+
+	/*
+	 * Too long for GS1-128, but not for the 2D carriers; then too long for
+	 * any.
+	 *
+	 */
+	memset(buf, '7', sizeof(buf));
+	ais[0].value = buf;
+	ais[0].value_len = 100;
+	gs1_carrier_estimate(ais, 1, NULL, 0, GS1_QR_EC_L, &est);
+	TEST_CHECK(est.gs1_128_chars == 55 && est.gs1_128_modules == 0);
+	TEST_CHECK(est.dm_codewords == 52);
+	TEST_CHECK(est.dm_rows == 32);
+	TEST_CHECK(est.qr_bits == 4 + 4 + 10 + 340);
+	TEST_CHECK(est.qr_version == 3);
+
+	ais[0].value_len = sizeof(buf);
+	gs1_carrier_estimate(ais, 1, NULL, 0, GS1_QR_EC_L, &est);
+	TEST_CHECK(est.dm_codewords == 1602);
+	TEST_CHECK(est.dm_rows == 0 && est.dm_cols == 0);
+	TEST_CHECK(est.qr_bits == 4 + 4 + 12 + 10670 + 4);
+	TEST_CHECK(est.qr_version == 26);
+	gs1_carrier_estimate(ais, 1, NULL, 0, GS1_QR_EC_H, &est);
+	TEST_CHECK(est.qr_bits == 4 + 4 + 14 + 10670 + 4);
+	TEST_CHECK(est.qr_version == 0);
+
+	gs1_dict_free(dict);
+
+}
+
+
+/*
+ * Reference: the fewest bits for the QR Code data from position i, by trying
+ * every mode for every segment with exact segment lengths, memoised.
+ *
+ */
+static size_t qr_segments(const uint16_t* const tok, const size_t n, const size_t i, const int group, size_t* const memo)
+{
+
+	static const size_t count_bits[3][3] = { { 10, 9, 8 }, { 12, 11, 16 }, { 14, 13, 16 } };
+	size_t best = SIZE_MAX, j, k, c, rest;
+	int m;
+
+	if (i == n)
+		return 0;
+	if (memo[i])
+		return memo[i];
+
+	for (m = 0; m < 3; m++) {
+		for (k = 0, j = i; j < n; j++) {
+			const uint16_t t = tok[j];
+			if (m == QR_NUMERIC && !IS_DIGIT(t))
+				break;
+			if (m == QR_ALNUM && t != TOK_FNC1 && !qr_alnum(t))
+				break;
+			k += m == QR_ALNUM && t == '%' ? 2 : 1;
+			c = m == QR_NUMERIC ? 10 * (k / 3) + (k % 3 == 1 ? 4 : k % 3 == 2 ? 7 : 0) :
+			    m == QR_ALNUM ? 11 * (k / 2) + 6 * (k % 2) : 8 * k;
+			if ((rest = qr_segments(tok, n, j + 1, group, memo)) != SIZE_MAX &&
+			    4 + count_bits[group][m] + c + rest < best)
+				best = 4 + count_bits[group][m] + c + rest;
+		}
+	}
+
+	return memo[i] = best;
+
+}
+
+
+void test_carrier_qr_optimal(void)
+{
+
+	static const char chars[] = "0123456789AZ%/az";
+	uint16_t tok[MAX_TOKENS];
+	uint16_t seq[2] = { 0, 1 };
+	size_t memo[MAX_TOKENS];
+	char value[2][8];
+	gs1_ai_view_t ais[2];
+	size_t n, len, i, k;
+	uint32_t x = 88172645u;
+	int r, g, ok = 1;
+
+	for (r = 0; r < 1000 && ok; r++) {
+
+		for (k = 0; k < 2; k++) {
+			x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+			len = x % sizeof(value[k]);
+			for (i = 0; i < len; i++) {
+				x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+				value[k][i] = chars[(x >> 8) % (i % 4 ? 10 : sizeof(chars) - 1)];
+			}
+			value[k][len] = '\0';
+			set_ai(&ais[k], k ? "92" : "91", value[k]);
+		}
+
+		n = tokenise(ais, 2, NULL, seq, tok, MAX_TOKENS);
+		TEST_ASSERT(n > 0);
+		for (g = 0; g < 3; g++) {
+			memset(memo, 0, sizeof(memo));
+			if (qr_length(tok, n, g) != 4 + qr_segments(tok, n, 1, g, memo)) {
+				ok = 0;
+				TEST_MSG("Not optimal for \"%s\", \"%s\" in group %d", value[0], value[1], g);
+			}
+		}
+
+	}
+
+	TEST_CHECK(ok);
+
+}
+
+
+#endif  /* UNIT_TESTS */
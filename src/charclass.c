@@ -0,0 +1,431 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Validation of data against a character class, being an arbitrary set of
+ * byte values, which underlies the character set linters and is available to
+ * applications for their own restricted alphabets.
+ *
+ * The 256-bit class mask is held transposed by nibble: byte value c is in the
+ * class if bit (c >> 4) & 7 of mask[(c & 15) | (c >> 7) << 4] is set. This
+ * allows a vector table lookup ("pshufb") to test 16 characters at once: the
+ * low nibble of each character selects a row of the mask and the high nibble
+ * selects a bit within that row. The scalar test uses the same layout.
+ *
+ * The SSSE3 backend is used when the compiler targets SSSE3, or otherwise on
+ * x86 with GCC or Clang when the processor supports it. Data shorter than 16
+ * characters, which includes most AI values, and other platforms use the
+ * scalar backend.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+#include "gs1syntaxdictionary-tables.h"
+#include "charclass.h"
+
+#if defined(__SSSE3__) || (defined(_MSC_VER) && defined(__AVX__))
+#  define CHARCLASS_SSSE3 1
+#  define SSSE3_TARGET
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#  define CHARCLASS_SSSE3 2
+#  define SSSE3_TARGET __attribute__((target("ssse3")))
+#endif
+
+#ifdef CHARCLASS_SSSE3
+#include <immintrin.h>
+#endif
+
+
+#define ROW(c) (((c) & 15) | ((c) >> 7) << 4)
+#define BIT(c) (1u << ((c) >> 4 & 7))
+#define IN_CLASS(cc, c) ((cc)->mask[ROW(c)] & BIT(c))
+
+
+/*
+ * Built-in classes, as generated by gs1_charclass_init() from the character
+ * lists in the unit tests.
+ *
+ */
+const gs1_charclass_t gs1_charclass_cset82 = { {
+	0xa8, 0xfc, 0xfc, 0xf8, 0xf8, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0x5c, 0x5c, 0x5c, 0x5c, 0x7c,
+} };
+
+const gs1_charclass_t gs1_charclass_cset39 = { {
+	0x28, 0x38, 0x38, 0x3c, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x30, 0x10, 0x10, 0x14, 0x10, 0x14,
+} };
+
+const gs1_charclass_t gs1_charclass_cset64 = { {
+	0xa8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf8, 0xf0, 0x50, 0x50, 0x54, 0x50, 0x70,
+} };
+
+const gs1_charclass_t gs1_charclass_cset32 = { {
+	0x20, 0x30, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x28, 0x30, 0x10, 0x10, 0x10, 0x10, 0x00,
+} };
+
+const gs1_charclass_t gs1_charclass_csetnumeric = { {
+	0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+} };
+
+const gs1_charclass_t gs1_charclass_iban = { {
+	0x28, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x38, 0x30, 0x10, 0x10, 0x10, 0x10, 0x10,
+} };
+
+
+/**
+ * Initialise a character class to contain the given characters.
+ *
+ * @param [in,out] cc The character class.
+ * @param [in] chars Null-terminated list of the characters in the class.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_charclass_init(gs1_charclass_t* const cc, const char* const chars)
+{
+
+	const unsigned char *p;
+
+	assert(cc);
+	assert(chars);
+
+	memset(cc->mask, 0, sizeof(cc->mask));
+	for (p = (const unsigned char*)chars; *p; p++)
+		cc->mask[ROW(*p)] |= (uint8_t)BIT(*p);
+
+}
+
+
+/**
+ * Add a range of byte values to a character class.
+ *
+ * @param [in,out] cc The character class.
+ * @param [in] first The first byte value in the range.
+ * @param [in] last The last byte value in the range.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_charclass_add_range(gs1_charclass_t* const cc, const unsigned char first, const unsigned char last)
+{
+
+	unsigned int c;
+
+	assert(cc);
+
+	for (c = first; c <= last; c++)
+		cc->mask[ROW(c)] |= (uint8_t)BIT(c);
+
+}
+
+
+/**
+ * Return one of the built-in character classes.
+ *
+ * The names are "cset82", "cset39", "cset64", "cset32", "csetnumeric",
+ * "iban" and "importeridx", being the characters permitted by the linters of
+ * the same name. (CSET 32 is used for the check character pair of the
+ * "csumalpha" linter.)
+ *
+ * @param [in] name The name of the class.
+ *
+ * @return the class, or `NULL` if the name is not known.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API const gs1_charclass_t* gs1_charclass_from_name(const char* const name)
+{
+
+	assert(name);
+
+	if (strcmp(name, "cset82") == 0)
+		return &gs1_charclass_cset82;
+	if (strcmp(name, "cset39") == 0)
+		return &gs1_charclass_cset39;
+	if (strcmp(name, "cset64") == 0 || strcmp(name, "importeridx") == 0)
+		return &gs1_charclass_cset64;
+	if (strcmp(name, "cset32") == 0)
+		return &gs1_charclass_cset32;
+	if (strcmp(name, "csetnumeric") == 0)
+		return &gs1_charclass_csetnumeric;
+	if (strcmp(name, "iban") == 0)
+		return &gs1_charclass_iban;
+
+	return NULL;
+
+}
+
+
+static size_t span_scalar(const gs1_charclass_t* const cc, const unsigned char* const p, const size_t len, size_t i)
+{
+
+	while (i < len && IN_CLASS(cc, p[i]))
+		i++;
+
+	return i;
+
+}
+
+
+#ifdef CHARCLASS_SSSE3
+
+static unsigned int lowest_bit(const unsigned int m)
+{
+#ifdef _MSC_VER
+	unsigned long i;
+	_BitScanForward(&i, m);
+	return (unsigned int)i;
+#else
+	return (unsigned int)__builtin_ctz(m);
+#endif
+}
+
+
+/*
+ * Requires len >= 16. The final 16 characters are tested with an
+ * overlapping load, rather than with the scalar loop, since any characters
+ * that they have in common with the previous block are in the class.
+ *
+ */
+SSSE3_TARGET static size_t span_ssse3(const gs1_charclass_t* const cc, const unsigned char* const p, const size_t len)
+{
+
+	const __m128i rows_lo = _mm_loadu_si128((const __m128i*)cc->mask);
+	const __m128i rows_hi = _mm_loadu_si128((const __m128i*)(cc->mask + 16));
+	const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+	const __m128i nibble = _mm_set1_epi8(0x0f);
+	const __m128i zero = _mm_setzero_si128();
+	size_t i = 0;
+
+	assert(len >= 16);
+
+	for (;;) {
+
+		const __m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+		const __m128i lo = _mm_and_si128(x, nibble);
+		const __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), nibble);
+		const __m128i top = _mm_cmplt_epi8(x, zero);
+		const __m128i row = _mm_or_si128(_mm_andnot_si128(top, _mm_shuffle_epi8(rows_lo, lo)),
+						 _mm_and_si128(top, _mm_shuffle_epi8(rows_hi, lo)));
+		const __m128i out = _mm_cmpeq_epi8(_mm_and_si128(row, _mm_shuffle_epi8(bits, hi)), zero);
+		const unsigned int m = (unsigned int)_mm_movemask_epi8(out);
+
+		if (m)
+			return i + lowest_bit(m);
+
+		if (i + 16 == len)
+			return len;
+
+		i = i + 32 <= len ? i + 16 : len - 16;
+
+	}
+
+}
+
+#endif  /* CHARCLASS_SSSE3 */
+
+
+/**
+ * Return the length of the initial part of the data that consists only of
+ * characters in the given class, i.e. the position of the first character
+ * that is not in the class, or len if there is none.
+ *
+ * @param [in] cc The character class.
+ * @param [in] data The data, which need not be null-terminated.
+ * @param [in] len The length of the data.
+ *
+ * @return the length of the initial part of the data that is in the class.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_charclass_span(const gs1_charclass_t* const cc, const char* const data, const size_t len)
+{
+
+	assert(cc);
+	assert(data || len == 0);
+
+#if CHARCLASS_SSSE3 == 1
+	if (len >= 16)
+		return span_ssse3(cc, (const unsigned char*)data, len);
+#elif CHARCLASS_SSSE3 == 2
+	if (len >= 16 && __builtin_cpu_supports("ssse3"))
+		return span_ssse3(cc, (const unsigned char*)data, len);
+#endif
+
+	return span_scalar(cc, (const unsigned char*)data, len, 0);
+
+}
+
+
+/**
+ * Used to validate that the data consists only of characters in the given
+ * class, e.g. a restricted alphabet for serial numbers that is agreed with a
+ * trading partner.
+ *
+ * @param [in] cc The character class.
+ * @param [in] data Pointer to the null-terminated data to be linted. Must not
+ *                  be `NULL`.
+ * @param [out] err_pos To facilitate error highlighting, the start position of
+ *                      the bad data is written to this pointer, if not `NULL`.
+ * @param [out] err_len The length of the bad data is written to this pointer, if
+ *                      not `NULL`.
+ *
+ * @return #GS1_LINTER_OK if okay.
+ * @return #GS1_LINTER_NOT_IN_CHARACTER_CLASS if the data contains a character
+ *         that is not in the class.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_charclass(const gs1_charclass_t* const cc, const char* const data, size_t* const err_pos, size_t* const err_len)
+{
+
+	size_t len, pos;
+
+	assert(cc);
+	assert(data);
+
+	len = strlen(data);
+
+	if ((pos = gs1_charclass_span(cc, data, len)) != len) {
+		if (err_pos) *err_pos = pos;
+		if (err_len) *err_len = 1;
+		return GS1_LINTER_NOT_IN_CHARACTER_CLASS;
+	}
+
+	return GS1_LINTER_OK;
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+
+void test_charclass_builtin(void)
+{
+
+	static const struct {
+		const char *name;
+		const char *chars;
+	} builtins[] = {
+		{ "cset82", GS1_SYNTAX_DICTIONARY_CSET82 },
+		{ "cset39", GS1_SYNTAX_DICTIONARY_CSET39 },
+		{ "cset64", GS1_SYNTAX_DICTIONARY_CSET64 },
+		{ "cset32", GS1_SYNTAX_DICTIONARY_CSET32 },
+		{ "csetnumeric", GS1_SYNTAX_DICTIONARY_CSETNUMERIC },
+		{ "iban", "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" },
+		{ "importeridx", "-0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz" },
+	};
+
+	gs1_charclass_t cc;
+	const gs1_charclass_t *b;
+	size_t i;
+	unsigned int c;
+
+	for (i = 0; i < sizeof(builtins) / sizeof(builtins[0]); i++) {
+		TEST_CASE(builtins[i].name);
+		gs1_charclass_init(&cc, builtins[i].chars);
+		TEST_ASSERT((b = gs1_charclass_from_name(builtins[i].name)) != NULL);
+		TEST_CHECK(memcmp(b, &cc, sizeof(cc)) == 0);
+		for (c = 1; c < 256; c++)
+			TEST_CHECK(!IN_CLASS(b, c) == !strchr(builtins[i].chars, (int)c));
+	}
+
+	TEST_CHECK(gs1_charclass_from_name("cset") == NULL);
+
+}
+
+
+/*
+ * Compare each backend with a direct search of the character list, for every
+ * length and position of a bad character within a block.
+ *
+ */
+void test_charclass_span(void)
+{
+
+	static const char* const lists[] = {
+		"0123456789",
+		"ABCDEFGHJKLMNPQRSTUVWXYZ",
+		"\x7f\x80\x81\xfe\xff !~",
+	};
+
+	char data[80];
+	gs1_charclass_t cc;
+	size_t i, j, len, pos;
+	unsigned int c;
+
+	for (i = 0; i < sizeof(lists) / sizeof(lists[0]); i++) {
+
+		const char* const chars = lists[i];
+
+		gs1_charclass_init(&cc, chars);
+
+		for (len = 0; len < sizeof(data); len++) {
+			for (j = 0; j < len; j++)
+				data[j] = chars[j % strlen(chars)];
+			TEST_CHECK(gs1_charclass_span(&cc, data, len) == len);
+			TEST_CHECK(span_scalar(&cc, (const unsigned char*)data, len, 0) == len);
+			for (pos = 0; pos < len; pos++) {
+				for (c = 1; c < 256; c += 7) {
+					const size_t expect = strchr(chars, (int)c) ? len : pos;
+					const char save = data[pos];
+					data[pos] = (char)c;
+					if (!TEST_CHECK(gs1_charclass_span(&cc, data, len) == expect))
+						TEST_MSG("List %d, length %d, byte %d at %d", (int)i, (int)len, (int)c, (int)pos);
+					if (!TEST_CHECK(span_scalar(&cc, (const unsigned char*)data, len, 0) == expect))
+						TEST_MSG("List %d, length %d, byte %d at %d", (int)i, (int)len, (int)c, (int)pos);
+					data[pos] = save;
+				}
+			}
+		}
+
+	}
+
+	gs1_charclass_init(&cc, "");
+	TEST_CHECK(gs1_charclass_span(&cc, "ABCDEFGHIJKLMNOPQRSTUVWXYZ", 26) == 0);
+	gs1_charclass_add_range(&cc, 'A', 'Y');
+	TEST_CHECK(gs1_charclass_span(&cc, "ABCDEFGHIJKLMNOPQRSTUVWXYZ", 26) == 25);
+	gs1_charclass_add_range(&cc, 0x80, 0xff);
+	TEST_CHECK(gs1_charclass_span(&cc, "ABCDEFGHIJKLMNOPQRSTUVWXY\xff\x80Z", 28) == 27);
+
+}
+
+
+void test_charclass_gs1_lint_charclass(void)
+{
+
+	gs1_charclass_t cc;
+	size_t pos = 0, len = 0;
+
+	/*
+	 * A partner-specific serial alphabet that excludes easily confused
+	 * characters.
+	 *
+	 */
+	gs1_charclass_init(&cc, "23456789ABCDEFGHJKLMNPQRSTUVWXYZ");
+
+	TEST_CHECK(gs1_lint_charclass(&cc, "", NULL, NULL) == GS1_LINTER_OK);
+	TEST_CHECK(gs1_lint_charclass(&cc, "ABC234", NULL, NULL) == GS1_LINTER_OK);
+	TEST_CHECK(gs1_lint_charclass(&cc, "ABC234XYZ789ABC234XYZ789", NULL, NULL) == GS1_LINTER_OK);
+	TEST_CHECK(gs1_lint_charclass(&cc, "ABC1", &pos, &len) == GS1_LINTER_NOT_IN_CHARACTER_CLASS);
+	TEST_CHECK(pos == 3 && len == 1);
+	TEST_CHECK(gs1_lint_charclass(&cc, "ABC234XYZ789ABC234XYZ78O", &pos, &len) == GS1_LINTER_NOT_IN_CHARACTER_CLASS);
+	TEST_CHECK(pos == 23 && len == 1);
+
+}
+
+#endif  /* UNIT_TESTS */
@@ -0,0 +1,39 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Built-in character classes used by the character set linters. This header
+ * is not installed; applications obtain these with gs1_charclass_from_name().
+ *
+ */
+
+#ifndef GS1_SYNTAXDICTIONARY_CHARCLASS_H
+#define GS1_SYNTAXDICTIONARY_CHARCLASS_H
+
+#include "gs1syntaxdictionary.h"
+
+
+extern const gs1_charclass_t gs1_charclass_cset82;
+extern const gs1_charclass_t gs1_charclass_cset39;
+extern const gs1_charclass_t gs1_charclass_cset64;	/* Also the Importer Index characters */
+extern const gs1_charclass_t gs1_charclass_cset32;
+extern const gs1_charclass_t gs1_charclass_csetnumeric;
+extern const gs1_charclass_t gs1_charclass_iban;
+
+
+#endif  /* GS1_SYNTAXDICTIONARY_CHARCLASS_H */
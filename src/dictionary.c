@@ -0,0 +1,1169 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Loader for the text of gs1-syntax-dictionary.txt, producing a run-time
+ * dictionary that maps each AI to its flags, specification, attributes and
+ * title.
+ *
+ * Each line of the form "AIs [Flags] Specification [Attributes...] [# Title]"
+ * is split into its fields, with an AI range such as "3100-3105" expanded
+ * into one entry per AI. The strings are stored once in a single blob and
+ * referenced by offset, and a dense index over all possible 2-, 3- and
+ * 4-digit AIs gives O(1) lookups.
+ *
+ * The entries and the index are held in fixed-size pages. A dictionary that
+ * is loaded against a base dictionary, such as a new release against the
+ * previous one, locates the entries of the AIs that are unchanged in the
+ * pages of the base and holds only the entries that differ, together with
+ * the strings that they refer to, and likewise shares the pages of the index
+ * that it would otherwise duplicate. The base is reference counted so that it remains for as
+ * long as a dictionary that shares its pages.
+ *
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <windows.h>
+typedef volatile LONG64 atomic_u64_t;
+#else
+#include <stdatomic.h>
+typedef _Atomic uint64_t atomic_u64_t;
+#endif
+
+#include "gs1syntaxdictionary.h"
+#include "dictionary.h"
+
+
+/*
+ * A dictionary is allocated along with its reference count: one for the
+ * caller and one for each dictionary that was loaded against it.
+ *
+ */
+struct dict_alloc {
+	atomic_u64_t refs;
+	struct gs1_dict dict;
+};
+
+#define DICT_ALLOC(d) ((struct dict_alloc *)((char *)(d) - offsetof(struct dict_alloc, dict)))
+
+
+/*
+ * Accumulates the dictionary whilst loading, before it is divided into pages.
+ *
+ */
+struct builder {
+	struct gs1_dict *dict;
+	const struct gs1_dict *base;
+	struct dict_entry *entries;
+	int *shared;		/* Entry of the base that is the same, or -1 */
+	size_t entries_cap;
+	char *blob;
+	size_t blob_len;
+	size_t blob_cap;
+	uint16_t *index;	/* DICT_INDEX_PAGES pages */
+};
+
+
+static void ref_get(const struct gs1_dict* const dict)
+{
+	struct dict_alloc * const a = DICT_ALLOC(dict);
+#ifdef _MSC_VER
+	InterlockedIncrement64(&a->refs);
+#else
+	atomic_fetch_add(&a->refs, 1);
+#endif
+}
+
+/*
+ * Drops a reference, returning non-zero if it was the last.
+ *
+ */
+static int ref_put(const struct gs1_dict* const dict)
+{
+	struct dict_alloc * const a = DICT_ALLOC(dict);
+#ifdef _MSC_VER
+	return InterlockedDecrement64(&a->refs) == 0;
+#else
+	return atomic_fetch_sub(&a->refs, 1) == 1;
+#endif
+}
+
+
+int gs1_dict_ai_key(const char* const ai, const size_t ai_len)
+{
+
+	int key = 0;
+	size_t i;
+
+	if (ai_len < 2 || ai_len > 4)
+		return -1;
+
+	for (i = 0; i < ai_len; i++) {
+		if (ai[i] < '0' || ai[i] > '9')
+			return -1;
+		key = key * 10 + (ai[i] - '0');
+	}
+
+	/*
+	 * Offset the 3- and 4-digit AIs past the shorter ones.
+	 *
+	 */
+	if (ai_len == 3)
+		key += 100;
+	else if (ai_len == 4)
+		key += 1100;
+
+	return key;
+
+}
+
+
+static int is_space(const char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char *skip_space(const char *p, const char* const end)
+{
+	while (p < end && is_space(*p))
+		p++;
+	return p;
+}
+
+static const char *token_end(const char *p, const char* const end)
+{
+	while (p < end && !is_space(*p))
+		p++;
+	return p;
+}
+
+/*
+ * A specification component begins with its type, optionally within "[".
+ *
+ */
+static int is_component(const char* const p, const char* const end)
+{
+	const char *q = p;
+	if (q < end && *q == '[')
+		q++;
+	return q + 1 < end && strchr("NXYZ", *q) && *q != '\0' && (q[1] == '.' || (q[1] >= '0' && q[1] <= '9'));
+}
+
+
+/*
+ * Appends a string to the blob, returning its offset, or 0 on allocation
+ * failure. Empty strings share offset 0.
+ *
+ */
+static uint32_t blob_add(struct builder* const b, const char* const s, const size_t len)
+{
+
+	uint32_t off;
+
+	if (len == 0)
+		return 0;
+
+	if (b->blob_len + len + 1 > b->blob_cap) {
+		size_t cap = b->blob_cap * 2;
+		char *blob;
+		while (cap < b->blob_len + len + 1)
+			cap *= 2;
+		if (cap > UINT32_MAX || (blob = realloc(b->blob, cap)) == NULL)
+			return 0;
+		b->blob = blob;
+		b->blob_cap = cap;
+	}
+
+	off = (uint32_t)b->blob_len;
+	memcpy(b->blob + off, s, len);
+	b->blob[off + len] = '\0';
+	b->blob_len += len + 1;
+
+	return off;
+
+}
+
+
+/*
+ * Appends the whitespace-separated tokens within [p, end) to the blob,
+ * separated by single spaces.
+ *
+ */
+static gs1_dict_err_t blob_add_tokens(struct builder* const b, const char *p, const char* const end, uint32_t* const off)
+{
+
+	char buf[256];
+	size_t len = 0;
+	const char *t;
+
+	for (p = skip_space(p, end); p < end; p = skip_space(t, end)) {
+		t = token_end(p, end);
+		if (len + (size_t)(t - p) + 1 > sizeof(buf))
+			return GS1_DICT_INVALID_ENTRY;
+		if (len)
+			buf[len++] = ' ';
+		memcpy(buf + len, p, (size_t)(t - p));
+		len += (size_t)(t - p);
+	}
+
+	if (len == 0) {
+		*off = 0;
+		return GS1_DICT_OK;
+	}
+
+	if ((*off = blob_add(b, buf, len)) == 0)
+		return GS1_DICT_NO_MEMORY;
+
+	return GS1_DICT_OK;
+
+}
+
+
+/*
+ * Returns the entry of the base for the same AI as an entry that was built,
+ * if it has the same flags and strings, or -1.
+ *
+ */
+static int shared_entry(const struct builder* const b, const struct dict_entry* const e, const struct gs1_dict* const base)
+{
+
+	const int key = gs1_dict_ai_key(e->ai, e->ai_len);
+	const struct dict_entry *be;
+	const char *blob;
+	int j;
+
+	assert(key >= 0);
+	if ((j = (int)DICT_INDEX(base, key) - 1) < 0)
+		return -1;
+
+	be = DICT_ENTRY(base, j);
+	blob = DICT_PAGE(base, j)->blob;
+	if (e->flags != be->flags || e->title_len != be->title_len ||
+	    strcmp(b->blob + e->title, blob + be->title) != 0 ||
+	    strcmp(b->blob + e->spec, blob + be->spec) != 0 ||
+	    strcmp(b->blob + e->attrs, blob + be->attrs) != 0)
+		return -1;
+
+	return j;
+
+}
+
+
+static gs1_dict_err_t add_entry(struct builder* const b, const int ai, const size_t ai_len, const struct dict_entry* const proto)
+{
+
+	static const int pow10[] = { 1, 10, 100, 1000 };
+
+	struct gs1_dict * const d = b->dict;
+	struct dict_entry *e;
+	int key, n;
+	size_t i;
+
+	if (ai_len < 2 || ai_len > 4)
+		return GS1_DICT_INVALID_AI;
+
+	if (d->count == b->entries_cap) {
+		const size_t cap = b->entries_cap * 2;
+		struct dict_entry *entries;
+		int *shared;
+		if ((entries = realloc(b->entries, cap * sizeof(*entries))) == NULL)
+			return GS1_DICT_NO_MEMORY;
+		b->entries = entries;
+		if ((shared = realloc(b->shared, cap * sizeof(*shared))) == NULL)
+			return GS1_DICT_NO_MEMORY;
+		b->shared = shared;
+		b->entries_cap = cap;
+	}
+
+	e = &b->entries[d->count];
+	*e = *proto;
+	e->ai_len = (uint8_t)ai_len;
+	for (i = 0, n = pow10[ai_len - 1]; i < ai_len; i++, n /= 10)
+		e->ai[i] = (char)('0' + ai / n % 10);
+	e->ai[ai_len] = '\0';
+
+	key = gs1_dict_ai_key(e->ai, ai_len);
+	assert(key >= 0);
+	if (b->index[key])
+		return GS1_DICT_DUPLICATE_AI;
+	b->shared[d->count] = b->base ? shared_entry(b, e, b->base) : -1;
+	b->index[key] = (uint16_t)(++d->count);
+
+	return GS1_DICT_OK;
+
+}
+
+
+static gs1_dict_err_t parse_line(struct builder* const b, const char *p, const char* const end)
+{
+
+	struct dict_entry proto;
+	const char *hash, *t, *spec_start, *title, *title_end;
+	size_t ai_len, i, n;
+	uint32_t code;
+	int first, last;
+	gs1_dict_err_t ret;
+
+	memset(&proto, 0, sizeof(proto));
+
+	if ((hash = memchr(p, '#', (size_t)(end - p))) == NULL)
+		hash = end;
+
+	/*
+	 * AI or AI range, with the same number of digits at either end.
+	 *
+	 */
+	t = token_end(p, hash);
+	for (ai_len = 0; p + ai_len < t && p[ai_len] >= '0' && p[ai_len] <= '9'; ai_len++);
+	if ((first = gs1_dict_ai_key(p, ai_len)) < 0)
+		return GS1_DICT_INVALID_AI;
+	last = first;
+	if (p + ai_len != t) {
+		if (p[ai_len] != '-' || (size_t)(t - p) != 2 * ai_len + 1 ||
+		    (last = gs1_dict_ai_key(p + ai_len + 1, ai_len)) < first)
+			return GS1_DICT_INVALID_AI;
+	}
+	p = skip_space(t, hash);
+
+	/*
+	 * Optional flags, consisting only of punctuation.
+	 *
+	 */
+	if (p < hash && !is_component(p, hash)) {
+		t = token_end(p, hash);
+		for (; p < t; p++) {
+			if ((*p >= '0' && *p <= '9') || (*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'))
+				return GS1_DICT_INVALID_FLAGS;
+			if (*p == '*')
+				proto.flags |= GS1_DICT_FLAG_FIXED_LENGTH;
+			else if (*p == '?')
+				proto.flags |= GS1_DICT_FLAG_DL_ATTR;
+		}
+		p = skip_space(t, hash);
+	}
+
+	/*
+	 * One or more specification components, then the attributes.
+	 *
+	 */
+	spec_start = p;
+	while (p < hash && is_component(p, hash))
+		p = skip_space(token_end(p, hash), hash);
+	if (p == spec_start)
+		return GS1_DICT_INVALID_SPEC;
+
+	if ((ret = blob_add_tokens(b, spec_start, p, &proto.spec)) != GS1_DICT_OK)
+		return ret;
+	if ((ret = gs1_dict_check_rules(p, hash)) != GS1_DICT_OK)
+		return ret;
+	if ((ret = blob_add_tokens(b, p, hash, &proto.attrs)) != GS1_DICT_OK)
+		return ret;
+
+	if (hash < end) {
+		title = skip_space(hash + 1, end);
+		for (title_end = end; title_end > title && is_space(title_end[-1]); title_end--);
+		if ((size_t)(title_end - title) > UINT16_MAX)
+			return GS1_DICT_INVALID_ENTRY;
+		proto.title_len = (uint16_t)(title_end - title);
+		proto.title = blob_add(b, title, proto.title_len);
+		if (proto.title_len && proto.title == 0)
+			return GS1_DICT_NO_MEMORY;
+	}
+
+	/*
+	 * Recover the AI numbers from the keys to expand the range.
+	 *
+	 */
+	if (ai_len == 3) {
+		first -= 100;
+		last -= 100;
+	} else if (ai_len == 4) {
+		first -= 1100;
+		last -= 1100;
+	}
+	n = b->dict->count;
+	for (i = (size_t)first; i <= (size_t)last; i++)
+		if ((ret = add_entry(b, (int)i, ai_len, &proto)) != GS1_DICT_OK)
+			return ret;
+
+	/*
+	 * The specification is compiled only if an entry of the line is not
+	 * shared with the base, since the entries that are shared run the
+	 * program of the base.
+	 *
+	 */
+	for (i = n; i < b->dict->count && b->shared[i] >= 0; i++);
+	if (i == b->dict->count)
+		return GS1_DICT_OK;
+
+	if ((ret = gs1_dict_compile_spec(&b->dict->code, b->blob + proto.spec, &code)) != GS1_DICT_OK)
+		return ret;
+	for (i = n; i < b->dict->count; i++)
+		b->entries[i].code = code;
+
+	return GS1_DICT_OK;
+
+}
+
+
+/*
+ * Whether page p of the index of the base holds the same AIs as the index
+ * that was built, with entry numbers that differ by a constant, which is
+ * returned as the bias.
+ *
+ */
+static int shared_index_page(const struct gs1_dict* const base, const size_t p, const uint16_t* const index, uint16_t* const bias)
+{
+
+	const uint16_t * const bi = base->index[p];
+	uint16_t diff = 0;
+	int found = 0;
+	size_t i;
+
+	for (i = 0; i < DICT_INDEX_PAGE_LEN; i++) {
+		if (!bi[i] != !index[i])
+			return 0;
+		if (!index[i])
+			continue;
+		if (!found) {
+			diff = (uint16_t)(index[i] - bi[i]);
+			found = 1;
+		} else if ((uint16_t)(index[i] - bi[i]) != diff) {
+			return 0;
+		}
+	}
+
+	*bias = diff;
+	return 1;
+
+}
+
+
+/*
+ * Copies a string of the builder's blob into the dictionary's own blob, once.
+ *
+ */
+static uint32_t blob_copy(struct gs1_dict* const d, uint32_t* const map, const char* const blob, const uint32_t off)
+{
+
+	size_t len;
+
+	if (off == 0 || map[off])
+		return map[off];
+
+	len = strlen(blob + off) + 1;
+	memcpy(d->blob + d->blob_len, blob + off, len);
+	map[off] = (uint32_t)d->blob_len;
+	d->blob_len += len;
+
+	return map[off];
+
+}
+
+
+/*
+ * Divides the entries and the index that were built into pages, sharing
+ * those that are unchanged from the base, if any.
+ *
+ */
+static gs1_dict_err_t build_pages(struct builder* const b, const struct gs1_dict* const base)
+{
+
+	struct gs1_dict * const d = b->dict;
+	struct dict_entry *e;
+	uint32_t *map, *page_map = NULL;
+	size_t i, p, k, num_shared, num_own = 0;
+	int j;
+
+	if ((d->entry_loc = malloc((d->count ? d->count : 1) * sizeof(uint32_t))) == NULL)
+		return GS1_DICT_NO_MEMORY;
+
+	/*
+	 * Each entry that is unchanged from the base is located in the page of
+	 * the base that holds it, so an AI that is added, removed or changed
+	 * leaves the entries of the other AIs shared. The pages of the base
+	 * that are used are numbered first, in order of use, and are followed
+	 * by the pages of the entries that differ.
+	 *
+	 */
+	if (base && (page_map = calloc(base->num_pages ? base->num_pages : 1, sizeof(uint32_t))) == NULL)
+		return GS1_DICT_NO_MEMORY;
+
+	for (i = 0; i < d->count; i++) {
+		if ((j = b->shared[i]) < 0) {
+			d->entry_loc[i] = UINT32_MAX;
+			num_own++;
+			continue;
+		}
+		p = base->entry_loc[j] / DICT_PAGE_ENTRIES;
+		if (!page_map[p])
+			page_map[p] = (uint32_t)++d->num_pages;
+		d->entry_loc[i] = (page_map[p] - 1) * DICT_PAGE_ENTRIES + base->entry_loc[j] % DICT_PAGE_ENTRIES;
+	}
+
+	num_shared = d->num_pages;
+	d->num_pages += (num_own + DICT_PAGE_ENTRIES - 1) / DICT_PAGE_ENTRIES;
+
+	if ((d->pages = malloc((d->num_pages ? d->num_pages : 1) * sizeof(*d->pages))) == NULL) {
+		free(page_map);
+		return GS1_DICT_NO_MEMORY;
+	}
+
+	if (base) {
+		for (p = 0; p < base->num_pages; p++)
+			if (page_map[p])
+				d->pages[page_map[p] - 1] = base->pages[p];
+		free(page_map);
+	}
+
+	if (num_own && (d->own_pages = malloc((d->num_pages - num_shared) * sizeof(struct dict_page))) == NULL)
+		return GS1_DICT_NO_MEMORY;
+
+	/*
+	 * Without a base every string is in use. Otherwise only the strings of
+	 * the entries that are not shared are kept.
+	 *
+	 */
+	if (!base) {
+		d->blob = b->blob;
+		d->blob_len = b->blob_len;
+		b->blob = NULL;
+		map = NULL;
+	} else {
+		if ((d->blob = malloc(b->blob_len)) == NULL || (map = calloc(b->blob_len, sizeof(uint32_t))) == NULL)
+			return GS1_DICT_NO_MEMORY;
+		d->blob[0] = '\0';
+		d->blob_len = 1;
+	}
+
+	for (p = num_shared; p < d->num_pages; p++) {
+		d->pages[p] = &d->own_pages[p - num_shared];
+		d->pages[p]->blob = d->blob;
+		d->pages[p]->code = &d->code;
+	}
+
+	for (i = 0, k = num_shared * DICT_PAGE_ENTRIES; i < d->count; i++) {
+		if (d->entry_loc[i] != UINT32_MAX)
+			continue;
+		d->entry_loc[i] = (uint32_t)k++;
+		e = DICT_ENTRY(d, i);
+		*e = b->entries[i];
+		if (map) {
+			e->title = blob_copy(d, map, b->blob, e->title);
+			e->spec = blob_copy(d, map, b->blob, e->spec);
+			e->attrs = blob_copy(d, map, b->blob, e->attrs);
+		}
+	}
+	free(map);
+
+	/*
+	 * Likewise the pages of the index, which are shared where the same AIs
+	 * have entry numbers that differ from those of the base by a constant.
+	 *
+	 */
+	if (!base) {
+		d->own_index = b->index;
+		b->index = NULL;
+		for (p = 0; p < DICT_INDEX_PAGES; p++)
+			d->index[p] = d->own_index + p * DICT_INDEX_PAGE_LEN;
+		return GS1_DICT_OK;
+	}
+
+	for (p = 0, num_own = 0; p < DICT_INDEX_PAGES; p++) {
+		if (shared_index_page(base, p, b->index + p * DICT_INDEX_PAGE_LEN, &d->index_bias[p]))
+			d->index[p] = base->index[p];
+		else
+			num_own++;
+	}
+
+	if (num_own && (d->own_index = malloc(num_own * DICT_INDEX_PAGE_LEN * sizeof(uint16_t))) == NULL)
+		return GS1_DICT_NO_MEMORY;
+
+	for (p = 0, num_own = 0; p < DICT_INDEX_PAGES; p++) {
+		if (d->index[p])
+			continue;
+		memcpy(d->own_index + num_own * DICT_INDEX_PAGE_LEN, b->index + p * DICT_INDEX_PAGE_LEN, DICT_INDEX_PAGE_LEN * sizeof(uint16_t));
+		d->index[p] = d->own_index + num_own++ * DICT_INDEX_PAGE_LEN;
+	}
+
+	return GS1_DICT_OK;
+
+}
+
+
+static gs1_dict_err_t load(const gs1_dict_t* const base, const char* const text, const size_t len, gs1_dict_t** const dict, size_t* const err_line)
+{
+
+	struct builder b;
+	struct dict_alloc *a;
+	const char *p = text, *eol;
+	const char * const end = text + len;
+	size_t line = 0;
+	gs1_dict_err_t ret = GS1_DICT_OK;
+
+	assert(text || len == 0);
+	assert(dict);
+
+	*dict = NULL;
+	if (err_line)
+		*err_line = 0;
+
+	if ((a = calloc(1, sizeof(struct dict_alloc))) == NULL)
+		return GS1_DICT_NO_MEMORY;
+	a->refs = 1;
+
+	memset(&b, 0, sizeof(b));
+	b.dict = &a->dict;
+	b.base = base;
+	b.entries_cap = 64;
+	b.blob_cap = 4096;
+	b.entries = malloc(b.entries_cap * sizeof(struct dict_entry));
+	b.shared = malloc(b.entries_cap * sizeof(int));
+	b.blob = malloc(b.blob_cap);
+	b.index = calloc(DICT_INDEX_PAGES * DICT_INDEX_PAGE_LEN, sizeof(uint16_t));
+	if (!b.entries || !b.shared || !b.blob || !b.index) {
+		ret = GS1_DICT_NO_MEMORY;
+		goto out;
+	}
+	b.blob[0] = '\0';
+	b.blob_len = 1;
+
+	for (; p < end; p = eol + 1) {
+
+		line++;
+		if ((eol = memchr(p, '\n', (size_t)(end - p))) == NULL)
+			eol = end;
+
+		if (skip_space(p, eol) == eol || *p == '#')
+			continue;
+
+		if ((ret = parse_line(&b, p, eol)) != GS1_DICT_OK) {
+			if (err_line)
+				*err_line = line;
+			goto out;
+		}
+
+		if (eol == end)
+			break;
+
+	}
+
+	if ((ret = build_pages(&b, base)) != GS1_DICT_OK)
+		goto out;
+
+	if (base) {
+		ref_get(base);
+		b.dict->base = base;
+	}
+
+	/*
+	 * The rules may refer to AIs that are defined further on.
+	 *
+	 */
+	ret = gs1_dict_compile_rules(b.dict);
+
+out:
+
+	free(b.entries);
+	free(b.shared);
+	free(b.blob);
+	free(b.index);
+
+	if (ret != GS1_DICT_OK) {
+		gs1_dict_free(b.dict);
+		return ret;
+	}
+
+	*dict = b.dict;
+	return GS1_DICT_OK;
+
+}
+
+
+/**
+ * Load a dictionary from the text of gs1-syntax-dictionary.txt.
+ *
+ * Blank lines and lines beginning with "#" are ignored. Every other line must
+ * have the form "AIs [Flags] Specification [Attributes...] [# Title]".
+ *
+ * @param [in] text The dictionary text, which need not be null-terminated.
+ * @param [in] len The length of the text.
+ * @param [out] dict The loaded dictionary, to be released with
+ *                   gs1_dict_free().
+ * @param [out] err_line The 1-based line number of an erroneous entry, if not
+ *                       `NULL`.
+ *
+ * @return #GS1_DICT_OK if okay, otherwise the reason that the dictionary
+ *         could not be loaded.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_dict_err_t gs1_dict_load(const char* const text, const size_t len, gs1_dict_t** const dict, size_t* const err_line)
+{
+	return load(NULL, text, len, dict, err_line);
+}
+
+
+/**
+ * Load a dictionary, such as a new release, against a base dictionary, such
+ * as the release that it supersedes, so that both may be used at once whilst
+ * sharing what they have in common.
+ *
+ * The result is the same as that of gs1_dict_load(), but the AI entries and
+ * the blocks of the index that are unchanged from the base, along with their
+ * titles, specifications, attributes and compiled specifications, are shared
+ * with the base rather than copied. Entries are matched by AI, so AIs that
+ * are added, removed or changed anywhere in the text leave the entries of the
+ * other AIs shared. The dictionary still holds a few bytes per AI to locate
+ * its entries, and its own "req" and "ex" rules, since these refer to AIs by
+ * entry number.
+ *
+ * The base is kept for as long as the new dictionary, so either may be freed
+ * first.
+ *
+ * @param [in] base The base dictionary.
+ * @param [in] text The dictionary text, which need not be null-terminated.
+ * @param [in] len The length of the text.
+ * @param [out] dict The loaded dictionary, to be released with
+ *                   gs1_dict_free().
+ * @param [out] err_line The 1-based line number of an erroneous entry, if not
+ *                       `NULL`.
+ *
+ * @return #GS1_DICT_OK if okay, otherwise the reason that the dictionary
+ *         could not be loaded.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_dict_err_t gs1_dict_load_derived(const gs1_dict_t* const base, const char* const text, const size_t len,
+							       gs1_dict_t** const dict, size_t* const err_line)
+{
+	assert(base);
+	return load(base, text, len, dict, err_line);
+}
+
+
+/**
+ * Release a dictionary that was loaded with gs1_dict_load() or
+ * gs1_dict_load_derived().
+ *
+ * @param [in] dict The dictionary, or `NULL`.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_dict_free(gs1_dict_t* const dict)
+{
+
+	struct gs1_dict *d = dict, *base;
+
+	/*
+	 * Iteratively, since releasing a dictionary may release its base.
+	 *
+	 */
+	while (d && ref_put(d)) {
+		base = (struct gs1_dict *)d->base;
+		free(d->pages);
+		free(d->entry_loc);
+		free(d->own_pages);
+		free(d->own_index);
+		free(d->blob);
+		free(d->entry_rules);
+		gs1_dict_free_rules(&d->rules);
+		gs1_dict_free_code(&d->code);
+		free(DICT_ALLOC(d));
+		d = base;
+	}
+
+}
+
+
+/**
+ * The number of AIs in a dictionary, with AI ranges expanded.
+ *
+ * Entries are numbered from 0 in the order that they appear in the
+ * dictionary text.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_dict_count(const gs1_dict_t* const dict)
+{
+	assert(dict);
+	return dict->count;
+}
+
+
+/**
+ * Find the entry for an AI.
+ *
+ * @param [in] dict The dictionary.
+ * @param [in] ai The AI digits, which need not be null-terminated.
+ * @param [in] ai_len The length of the AI.
+ *
+ * @return the entry number, or -1 if the AI is not in the dictionary.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API int gs1_dict_find(const gs1_dict_t* const dict, const char* const ai, const size_t ai_len)
+{
+
+	int key;
+
+	assert(dict);
+
+	if ((key = gs1_dict_ai_key(ai, ai_len)) < 0)
+		return -1;
+
+	return (int)DICT_INDEX(dict, key) - 1;
+
+}
+
+
+/**
+ * The AI of an entry.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API const char *gs1_dict_ai(const gs1_dict_t* const dict, const int entry)
+{
+	assert(dict && entry >= 0 && (size_t)entry < dict->count);
+	return DICT_ENTRY(dict, entry)->ai;
+}
+
+
+/**
+ * The flags of an entry, a combination of #GS1_DICT_FLAG_FIXED_LENGTH and
+ * #GS1_DICT_FLAG_DL_ATTR.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API unsigned int gs1_dict_flags(const gs1_dict_t* const dict, const int entry)
+{
+	assert(dict && entry >= 0 && (size_t)entry < dict->count);
+	return DICT_ENTRY(dict, entry)->flags;
+}
+
+
+/**
+ * The title of an entry, e.g. "GTIN", or an empty string if it has none.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API const char *gs1_dict_title(const gs1_dict_t* const dict, const int entry)
+{
+	assert(dict && entry >= 0 && (size_t)entry < dict->count);
+	return DICT_STR(dict, entry, DICT_ENTRY(dict, entry)->title);
+}
+
+
+/**
+ * The specification of an entry, e.g. "N14,csum,key", with its components
+ * separated by single spaces.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API const char *gs1_dict_spec(const gs1_dict_t* const dict, const int entry)
+{
+	assert(dict && entry >= 0 && (size_t)entry < dict->count);
+	return DICT_STR(dict, entry, DICT_ENTRY(dict, entry)->spec);
+}
+
+
+/**
+ * The attributes of an entry, e.g. "ex=02,255,37 dlpkey=22,10,21|235",
+ * separated by single spaces, or an empty string if it has none.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API const char *gs1_dict_attrs(const gs1_dict_t* const dict, const int entry)
+{
+	assert(dict && entry >= 0 && (size_t)entry < dict->count);
+	return DICT_STR(dict, entry, DICT_ENTRY(dict, entry)->attrs);
+}
+
+
+#ifdef UNIT_TESTS
+
+#include "unittest.h"
+
+
+static const char test_dict[] =
+	"# Comment\n"
+	"\n"
+	"00         *?  N18,csum,key                  dlpkey                                              # SSCC\n"
+	"01         *?  N14,csum,key                  ex=02,255,37 dlpkey=22,10,21|235                    # GTIN\r\n"
+	"10          ?  X..20                         req=01,02,8006,8026                                 # BATCH/LOT\n"
+	"235            X..28                         req=01                                              # TPX\n"
+	"3100-3105  *?  N6                            req=01,02 ex=310n                                   # NET WEIGHT (kg)\n"
+	"7007        ?  N6,yymmdd [N6],yymmdd         req=01,02                                           # HARVEST DATE\n"
+	"8010           Y..30,iso3166999\n";
+
+
+void test_dictionary_load(void)
+{
+
+	gs1_dict_t *dict;
+	size_t line;
+	int e;
+
+	TEST_ASSERT(gs1_dict_load(test_dict, strlen(test_dict), &dict, &line) == GS1_DICT_OK);
+	TEST_CHECK(gs1_dict_count(dict) == 12);
+
+	TEST_CHECK((e = gs1_dict_find(dict, "01", 2)) == 1);
+	TEST_CHECK(strcmp(gs1_dict_ai(dict, e), "01") == 0);
+	TEST_CHECK(gs1_dict_flags(dict, e) == (GS1_DICT_FLAG_FIXED_LENGTH | GS1_DICT_FLAG_DL_ATTR));
+	TEST_CHECK(strcmp(gs1_dict_spec(dict, e), "N14,csum,key") == 0);
+	TEST_CHECK(strcmp(gs1_dict_attrs(dict, e), "ex=02,255,37 dlpkey=22,10,21|235") == 0);
+	TEST_CHECK(strcmp(gs1_dict_title(dict, e), "GTIN") == 0);
+
+	TEST_CHECK((e = gs1_dict_find(dict, "10", 2)) == 2);
+	TEST_CHECK(gs1_dict_flags(dict, e) == GS1_DICT_FLAG_DL_ATTR);
+
+	TEST_CHECK((e = gs1_dict_find(dict, "235", 3)) == 3);
+	TEST_CHECK(gs1_dict_flags(dict, e) == 0);
+
+	TEST_CHECK(gs1_dict_find(dict, "3099", 4) == -1);
+	TEST_CHECK((e = gs1_dict_find(dict, "3100", 4)) == 4);
+	TEST_CHECK((e = gs1_dict_find(dict, "3105", 4)) == 9);
+	TEST_CHECK(strcmp(gs1_dict_ai(dict, e), "3105") == 0);
+	TEST_CHECK(strcmp(gs1_dict_title(dict, e), "NET WEIGHT (kg)") == 0);
+	TEST_CHECK(gs1_dict_title(dict, e) == gs1_dict_title(dict, 4));
+	TEST_CHECK(gs1_dict_find(dict, "3106", 4) == -1);
+
+	TEST_CHECK((e = gs1_dict_find(dict, "7007", 4)) == 10);
+	TEST_CHECK(strcmp(gs1_dict_spec(dict, e), "N6,yymmdd [N6],yymmdd") == 0);
+
+	TEST_CHECK((e = gs1_dict_find(dict, "8010", 4)) == 11);
+	TEST_CHECK(strcmp(gs1_dict_attrs(dict, e), "") == 0);
+	TEST_CHECK(strcmp(gs1_dict_title(dict, e), "") == 0);
+
+	TEST_CHECK(gs1_dict_find(dict, "1", 1) == -1);
+	TEST_CHECK(gs1_dict_find(dict, "00000", 5) == -1);
+	TEST_CHECK(gs1_dict_find(dict, "0A", 2) == -1);
+	TEST_CHECK(gs1_dict_find(dict, "010", 3) == -1);
+
+	gs1_dict_free(dict);
+
+}
+
+
+void test_dictionary_errors(void)
+{
+
+	gs1_dict_t *dict;
+	size_t line;
+
+#define LOAD(t) gs1_dict_load(t, strlen(t), &dict, &line)
+
+	TEST_CHECK(LOAD("") == GS1_DICT_OK && gs1_dict_count(dict) == 0);
+	gs1_dict_free(dict);
+
+	TEST_CHECK(LOAD("01 N14\n0 N1\n") == GS1_DICT_INVALID_AI && line == 2 && dict == NULL);
+	TEST_CHECK(LOAD("01234 N1\n") == GS1_DICT_INVALID_AI && line == 1);
+	TEST_CHECK(LOAD("3105-3100 N6\n") == GS1_DICT_INVALID_AI);
+	TEST_CHECK(LOAD("310-3105 N6\n") == GS1_DICT_INVALID_AI);
+	TEST_CHECK(LOAD("3100- N6\n") == GS1_DICT_INVALID_AI);
+	TEST_CHECK(LOAD(" 01 N14\n") == GS1_DICT_INVALID_AI);
+	TEST_CHECK(LOAD("01 *a N14\n") == GS1_DICT_INVALID_FLAGS);
+	TEST_CHECK(LOAD("01 *\n") == GS1_DICT_INVALID_SPEC);
+	TEST_CHECK(LOAD("01 req=02 # GTIN\n") == GS1_DICT_INVALID_FLAGS);
+	TEST_CHECK(LOAD("01 N14\n01 N14\n") == GS1_DICT_DUPLICATE_AI && line == 2);
+	TEST_CHECK(LOAD("3100-3105 N6\n3105 N6\n") == GS1_DICT_DUPLICATE_AI && line == 2);
+	TEST_CHECK(LOAD("01 N14\n02 N14 req=0\n") == GS1_DICT_INVALID_ENTRY && line == 2);
+	TEST_CHECK(LOAD("01 N14 ex=02,\n") == GS1_DICT_INVALID_ENTRY && line == 1);
+	TEST_CHECK(LOAD("01 N14 req=02+0A\n") == GS1_DICT_INVALID_ENTRY && line == 1);
+
+#undef LOAD
+
+}
+
+
+/*
+ * A dictionary loaded against a base shares the entries, and their strings,
+ * that are unchanged, and holds a reference to the base.
+ *
+ */
+void test_dictionary_load_derived(void)
+{
+
+	static const char range[] = "9100-9199      X..90                                                                             # INTERNAL\n";
+	static const char added[] = "8011           N..12                         req=8010                                            # CPID SERIAL\n";
+	static const char changed[] = "8010           Y..30,iso3166999                                                                  # CPID\n";
+	static const char inserted[] = "11          ?  N6,yymmdd                     req=01,02                                           # PROD DATE\n";
+	char base_text[sizeof(test_dict) + sizeof(range)];
+	char new_text[sizeof(base_text) + sizeof(added) + sizeof(changed) + sizeof(inserted)];
+	const char *q;
+	char *p;
+	gs1_dict_t *base, *dict;
+	gs1_ai_view_t ais[2];
+	struct dict_code code;
+	uint32_t off;
+	size_t i, line, pos;
+	int e;
+
+	strcpy(base_text, test_dict);
+	strcat(base_text, range);
+	TEST_ASSERT(gs1_dict_load(base_text, strlen(base_text), &base, NULL) == GS1_DICT_OK);
+	TEST_ASSERT(gs1_dict_count(base) == 112);
+
+	/*
+	 * An added AI is the only entry that is not shared.
+	 *
+	 */
+	strcpy(new_text, base_text);
+	strcat(new_text, added);
+	TEST_ASSERT(gs1_dict_load_derived(base, new_text, strlen(new_text), &dict, NULL) == GS1_DICT_OK);
+	TEST_CHECK(gs1_dict_count(dict) == 113);
+	for (i = 0; i < 112; i++)
+		TEST_CHECK(DICT_ENTRY(dict, i) == DICT_ENTRY(base, i));
+	TEST_CHECK(DICT_ENTRY(dict, 112) == &dict->own_pages[0].entries[0]);
+	TEST_CHECK(gs1_dict_title(dict, 1) == gs1_dict_title(base, 1));
+	TEST_CHECK((e = gs1_dict_find(dict, "9199", 4)) == 111);
+	TEST_CHECK(gs1_dict_title(dict, e) == gs1_dict_title(base, e));
+	TEST_CHECK(strcmp(gs1_dict_title(dict, e), "INTERNAL") == 0);
+	TEST_CHECK(gs1_dict_find(base, "8011", 4) == -1);
+	TEST_CHECK((e = gs1_dict_find(dict, "8011", 4)) == 112);
+	TEST_CHECK(strcmp(gs1_dict_title(dict, e), "CPID SERIAL") == 0);
+	TEST_CHECK(dict->index[0] == base->index[0]);
+	TEST_CHECK(dict->rules.alts[0].bits == base->rules.alts[0].bits);
+
+	/*
+	 * Only the added line is compiled, and the shared entries run the
+	 * programs of the base, with its linters.
+	 *
+	 */
+	memset(&code, 0, sizeof(code));
+	TEST_ASSERT(gs1_dict_compile_spec(&code, "N..12", &off) == GS1_DICT_OK);
+	TEST_CHECK(dict->code.len == code.len && dict->code.num_linters == 0);
+	gs1_dict_free_code(&code);
+	TEST_CHECK(DICT_CODE(dict, 1) == &base->code && DICT_PROG(dict, 1) == DICT_PROG(base, 1));
+	TEST_CHECK(DICT_CODE(dict, 112) == &dict->code);
+	TEST_CHECK(gs1_dict_validate(dict, 1, "09521234543213", 14, NULL, NULL) == GS1_LINTER_OK);
+	TEST_CHECK(gs1_dict_validate(dict, 1, "09521234543214", 14, NULL, NULL) == GS1_LINTER_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(gs1_dict_validate(dict, 112, "123", 3, NULL, NULL) == GS1_LINTER_OK);
+	TEST_CHECK(gs1_dict_validate(dict, 112, "12A", 3, NULL, NULL) != GS1_LINTER_OK);
+
+	/*
+	 * The rules are compiled for each dictionary, and the base remains
+	 * usable for as long as the new dictionary.
+	 *
+	 */
+	ais[0].ai = "8011";
+	ais[0].ai_len = 4;
+	ais[0].value = "1";
+	ais[0].value_len = 1;
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 1, NULL, &pos) == GS1_ASSOC_REQUIRED_MISSING);
+	ais[1].ai = "8010";
+	ais[1].ai_len = 4;
+	ais[1].value = "1";
+	ais[1].value_len = 1;
+	TEST_CHECK(gs1_ai_check_associations(dict, ais, 2, NULL, &pos) == GS1_ASSOC_OK);
+	TEST_CHECK(gs1_ai_check_associations(base, ais, 2, NULL, &pos) == GS1_ASSOC_UNKNOWN_AI);
+
+	gs1_dict_free(base);
+	TEST_CHECK(strcmp(gs1_dict_title(dict, 1), "GTIN") == 0);
+	TEST_CHECK(strcmp(gs1_dict_spec(dict, gs1_dict_find(dict, "9150", 4)), "X..90") == 0);
+
+	/*
+	 * A dictionary may serve as the base of another whilst having a base,
+	 * sharing the entries that it shares with its own base. Changing an
+	 * entry in place leaves the others shared.
+	 *
+	 */
+	base = dict;
+	strcpy(new_text, test_dict);
+	TEST_ASSERT((p = strstr(new_text, "8010")) != NULL);
+	strcpy(p, changed);
+	strcat(new_text, range);
+	strcat(new_text, added);
+	TEST_ASSERT(gs1_dict_load_derived(base, new_text, strlen(new_text), &dict, NULL) == GS1_DICT_OK);
+	TEST_CHECK(DICT_ENTRY(dict, 10) == DICT_ENTRY(base, 10));
+	TEST_CHECK(DICT_ENTRY(dict, 11) != DICT_ENTRY(base, 11));
+	TEST_CHECK(DICT_ENTRY(dict, 12) == DICT_ENTRY(base, 12));
+	TEST_CHECK(DICT_ENTRY(dict, 112) == DICT_ENTRY(base, 112));
+	TEST_CHECK(strcmp(gs1_dict_title(dict, 11), "CPID") == 0);
+	TEST_CHECK(strcmp(gs1_dict_title(base, 11), "") == 0);
+	TEST_CHECK(gs1_dict_title(dict, 112) == gs1_dict_title(base, 112));
+	TEST_CHECK(DICT_CODE(dict, 11) == &dict->code && dict->code.num_linters == 1);
+	TEST_CHECK(DICT_CODE(dict, 112) == &base->code && DICT_CODE(dict, 10) == DICT_CODE(base, 10));
+	TEST_CHECK(gs1_dict_validate(dict, 11, "999", 3, NULL, NULL) == GS1_LINTER_OK);
+	TEST_CHECK(gs1_dict_validate(dict, 11, "998", 3, NULL, NULL) != GS1_LINTER_OK);
+	TEST_CHECK(gs1_dict_validate(dict, 10, "250101", 6, NULL, NULL) == GS1_LINTER_OK);
+	TEST_CHECK(gs1_dict_validate(dict, 10, "251301", 6, NULL, NULL) != GS1_LINTER_OK);
+
+	gs1_dict_free(dict);
+
+	/*
+	 * An AI inserted before others leaves their entries shared, and the
+	 * pages of the index that hold only AIs whose entry numbers shift.
+	 *
+	 */
+	q = strstr(test_dict, "\n235") + 1;
+	memcpy(new_text, test_dict, (size_t)(q - test_dict));
+	strcpy(new_text + (q - test_dict), inserted);
+	strcat(new_text, q);
+	strcat(new_text, range);
+	strcat(new_text, added);
+	TEST_ASSERT(gs1_dict_load_derived(base, new_text, strlen(new_text), &dict, NULL) == GS1_DICT_OK);
+	TEST_CHECK(gs1_dict_count(dict) == 114);
+	TEST_CHECK((e = gs1_dict_find(dict, "11", 2)) == 3);
+	TEST_CHECK(strcmp(gs1_dict_title(dict, e), "PROD DATE") == 0);
+	for (i = 0; i < 113; i++)
+		TEST_CHECK(DICT_ENTRY(dict, i < 3 ? i : i + 1) == DICT_ENTRY(base, i));
+	TEST_CHECK(dict->index[0] != base->index[0]);
+	TEST_CHECK(dict->index[gs1_dict_ai_key("9150", 4) / DICT_INDEX_PAGE_LEN] == base->index[gs1_dict_ai_key("9150", 4) / DICT_INDEX_PAGE_LEN]);
+	TEST_CHECK(gs1_dict_find(dict, "9150", 4) == gs1_dict_find(base, "9150", 4) + 1);
+	TEST_CHECK(gs1_dict_find(dict, "8011", 4) == 113);
+	TEST_CHECK(gs1_dict_find(dict, "01", 2) == 1);
+	TEST_CHECK(gs1_dict_find(dict, "12", 2) == -1);
+
+	gs1_dict_free(dict);
+
+	/*
+	 * A failed load leaves the base untouched.
+	 *
+	 */
+	TEST_CHECK(gs1_dict_load_derived(base, "01 N14\n01 N14\n", 14, &dict, &line) == GS1_DICT_DUPLICATE_AI && line == 2 && dict == NULL);
+	TEST_CHECK(strcmp(gs1_dict_title(base, 1), "GTIN") == 0);
+
+	gs1_dict_free(base);
+
+}
+
+
+/*
+ * The dictionary distributed with the library loads, when the tests are run
+ * from the source directory.
+ *
+ */
+void test_dictionary_load_file(void)
+{
+
+	gs1_dict_t *dict;
+	int e;
+
+	if ((dict = load_dictionary_file()) == NULL)
+		return;
+
+	TEST_CHECK(gs1_dict_count(dict) > 500);
+	TEST_CHECK((e = gs1_dict_find(dict, "01", 2)) >= 0);
+	TEST_CHECK(strcmp(gs1_dict_title(dict, e), "GTIN") == 0);
+	TEST_CHECK((e = gs1_dict_find(dict, "3103", 4)) >= 0);
+	TEST_CHECK(strcmp(gs1_dict_spec(dict, e), "N6") == 0);
+	TEST_CHECK((e = gs1_dict_find(dict, "8200", 4)) >= 0);
+	TEST_CHECK(gs1_dict_flags(dict, e) == 0);
+
+	gs1_dict_free(dict);
+
+}
+
+#endif  /* UNIT_TESTS */
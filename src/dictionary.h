@@ -0,0 +1,224 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Internal representation of a loaded Syntax Dictionary, shared by the
+ * modules that consume it. This header is not installed.
+ *
+ * The functions declared here are not exported from the shared library, but
+ * are visible in a static link, so they carry the gs1_ prefix.
+ *
+ */
+
+#ifndef GS1_SYNTAXDICTIONARY_DICTIONARY_H
+#define GS1_SYNTAXDICTIONARY_DICTIONARY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gs1syntaxdictionary.h"
+
+
+/*
+ * Number of possible 2-, 3- and 4-digit AIs, which is the size of the dense
+ * index.
+ *
+ */
+#define DICT_INDEX_LEN (100 + 1000 + 10000)
+
+
+/*
+ * Compiled "req" and "ex" rules, of a dictionary or of a profile.
+ *
+ * A rule has one or more alternatives, each of which has one or more terms.
+ * A term is a bitset over the entry numbers of the AIs that match one AI
+ * pattern, such as "31nn", and an alternative holds if every one of its terms
+ * meets the set of AIs in the message. A "req" rule is satisfied if any of
+ * its alternatives holds; an "ex" rule if none do.
+ *
+ */
+struct dict_rule {
+	uint32_t alts;		/* First alternative */
+	uint16_t num_alts;
+	uint8_t ex;
+};
+
+struct dict_alt {
+	const uint64_t *bits;	/* The terms, once compiled */
+	uint32_t terms;		/* First term, whilst compiling */
+	uint16_t num_terms;
+};
+
+/*
+ * Once compiled, an alternative whose terms are the same as those of an
+ * earlier alternative, or of an alternative of the base dictionary, points at
+ * those, so terms holds only the distinct runs of terms.
+ *
+ */
+struct dict_rules {
+	struct dict_rule *rules;
+	size_t num_rules;
+	struct dict_alt *alts;
+	size_t num_alts;
+	uint64_t *terms;	/* words words per term */
+	size_t num_terms;
+	size_t words;
+};
+
+
+/*
+ * Specifications compiled to bytecode, one program per dictionary line, and
+ * the linters that the programs call by number.
+ *
+ */
+struct dict_code {
+	uint8_t *code;
+	size_t len;
+	size_t cap;
+	gs1_linter_t *linters;
+	size_t num_linters;
+};
+
+
+/*
+ * One per AI, with AI ranges expanded. Strings are held as offsets into the
+ * blob of the page that holds the entry; offset 0 is the empty string. The
+ * program is likewise an offset into the code of the page. The entries of an
+ * AI range share their strings and their program.
+ *
+ */
+struct dict_entry {
+	char ai[5];		/* Null-terminated */
+	uint8_t ai_len;
+	uint8_t flags;		/* GS1_DICT_FLAG_* */
+	uint16_t title_len;
+	uint32_t title;
+	uint32_t spec;
+	uint32_t attrs;
+	uint32_t code;
+};
+
+/*
+ * The rules of an entry. These are held apart from the entries since a rule
+ * refers to other AIs by entry number, so they are compiled for each
+ * dictionary even where its entries are shared.
+ *
+ */
+struct dict_entry_rules {
+	uint16_t rules;		/* First rule */
+	uint8_t num_rules;
+};
+
+/*
+ * The entries and the dense index are held in fixed-size pages, so that a
+ * dictionary loaded against a base dictionary can share what is unchanged
+ * from the base.
+ *
+ * Entries are shared by AI: each entry is located by the page and slot that
+ * hold it, so the entries of the AIs that are unchanged are found in the
+ * pages of the base wherever they are in the text, and the pages of the
+ * dictionary itself hold only the entries that are new or changed. Only the
+ * lines with such entries are compiled into the code of the dictionary.
+ *
+ * The index holds entry numbers, which shift when an AI is inserted before
+ * others. A page of the index is shared with the base where it holds the
+ * same AIs and their entry numbers differ by a constant, which is held as
+ * the bias of the page.
+ *
+ */
+#define DICT_PAGE_ENTRIES 64
+#define DICT_INDEX_PAGE_LEN 128
+#define DICT_INDEX_PAGES ((DICT_INDEX_LEN + DICT_INDEX_PAGE_LEN - 1) / DICT_INDEX_PAGE_LEN)
+
+struct dict_page {
+	const char *blob;
+	const struct dict_code *code;
+	struct dict_entry entries[DICT_PAGE_ENTRIES];
+};
+
+struct gs1_dict {
+	struct dict_page **pages;
+	size_t num_pages;
+	uint32_t *entry_loc;			/* Page * DICT_PAGE_ENTRIES + slot */
+	size_t count;
+	const uint16_t *index[DICT_INDEX_PAGES];	/* Entry number + 1 - bias, or 0 */
+	uint16_t index_bias[DICT_INDEX_PAGES];
+	struct dict_entry_rules *entry_rules;
+	struct dict_rules rules;
+	struct dict_code code;			/* Programs of the pages not shared */
+	struct dict_page *own_pages;		/* Pages not shared with the base */
+	uint16_t *own_index;
+	char *blob;
+	size_t blob_len;
+	const struct gs1_dict *base;		/* Holds a reference, or NULL */
+};
+
+#define DICT_INDEX_RAW(d, key) ((d)->index[(key) / DICT_INDEX_PAGE_LEN][(key) % DICT_INDEX_PAGE_LEN])
+#define DICT_INDEX(d, key) ((uint16_t)(DICT_INDEX_RAW(d, key) ? DICT_INDEX_RAW(d, key) + (d)->index_bias[(key) / DICT_INDEX_PAGE_LEN] : 0))
+#define DICT_PAGE(d, i) ((d)->pages[(d)->entry_loc[i] / DICT_PAGE_ENTRIES])
+#define DICT_ENTRY(d, i) (&DICT_PAGE(d, i)->entries[(d)->entry_loc[i] % DICT_PAGE_ENTRIES])
+#define DICT_STR(d, i, off) (DICT_PAGE(d, i)->blob + (off))
+#define DICT_CODE(d, i) (DICT_PAGE(d, i)->code)
+#define DICT_PROG(d, i) (DICT_CODE(d, i)->code + DICT_ENTRY(d, i)->code)
+
+
+/*
+ * Position of an AI within the dense index, or -1 if it is not 2 to 4 digits.
+ *
+ */
+int gs1_dict_ai_key(const char *ai, size_t ai_len);
+
+
+/*
+ * Checks the syntax of the "req" and "ex" attributes within [p, end).
+ *
+ */
+gs1_dict_err_t gs1_dict_check_rules(const char *p, const char *end);
+
+
+/*
+ * Compiles the "req" and "ex" attributes of every entry, once the whole
+ * dictionary has been loaded.
+ *
+ */
+gs1_dict_err_t gs1_dict_compile_rules(struct gs1_dict *dict);
+
+
+void gs1_dict_free_rules(struct dict_rules *rules);
+
+
+/*
+ * Appends the program for a specification, with its components separated by
+ * single spaces, returning its offset.
+ *
+ */
+gs1_dict_err_t gs1_dict_compile_spec(struct dict_code *code, const char *spec, uint32_t *off);
+
+
+void gs1_dict_free_code(struct dict_code *code);
+
+
+/*
+ * Validates data against a specification by working from its text, without
+ * compiling it. This is the reference for the compiled programs.
+ *
+ */
+gs1_lint_err_t gs1_dict_spec_interpret(const char *spec, const char *data, size_t len, size_t *err_pos, size_t *err_len);
+
+
+#endif  /* GS1_SYNTAXDICTIONARY_DICTIONARY_H */
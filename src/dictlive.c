@@ -0,0 +1,547 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Replacement of the dictionary used by a long-running service, e.g. with a
+ * new GS1 release, without pausing the threads that are validating with it.
+ *
+ * The current dictionary is published through an atomic pointer and is
+ * reclaimed using epochs. Each reader thread registers a slot. To begin a
+ * read it copies the global epoch into its slot and then loads the pointer;
+ * to end the read it clears its slot. Neither takes a lock.
+ *
+ * A swap publishes the new dictionary and then advances the global epoch to
+ * E, retiring the old dictionary at E. A reader whose slot holds E or later
+ * began after the swap and so cannot hold the old dictionary, therefore the
+ * old dictionary is freed once no slot holds an epoch earlier than E. This is
+ * checked on each swap and by gs1_dict_live_reclaim(). The atomic operations
+ * are sequentially consistent, which this argument relies upon.
+ *
+ * Only swaps and reclamation take the writer lock, which is a spin lock since
+ * these are rare and brief.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef _MSC_VER
+#include <windows.h>
+typedef volatile LONG64 atomic_u64_t;
+typedef PVOID volatile atomic_ptr_t;
+#else
+#include <stdatomic.h>
+typedef _Atomic uint64_t atomic_u64_t;
+typedef _Atomic(void *) atomic_ptr_t;
+#endif
+
+#include "gs1syntaxdictionary.h"
+
+
+#define CACHE_LINE 64
+
+struct gs1_dict_reader {
+	atomic_u64_t epoch;		/* Epoch at which the current read began, or 0 */
+	atomic_u64_t in_use;
+	struct gs1_dict_live *live;
+	char pad[CACHE_LINE - 2 * sizeof(uint64_t) - sizeof(void *)];
+};
+
+struct retired {
+	gs1_dict_t *dict;
+	uint64_t epoch;
+	struct retired *next;
+};
+
+struct gs1_dict_live {
+	atomic_ptr_t current;
+	atomic_u64_t epoch;
+	atomic_u64_t lock;
+	struct retired *retired;	/* Protected by the lock */
+	size_t num_readers;
+	struct gs1_dict_reader *readers;
+};
+
+
+static uint64_t load_u64(atomic_u64_t* const a)
+{
+#ifdef _MSC_VER
+	return (uint64_t)InterlockedOr64(a, 0);
+#else
+	return atomic_load(a);
+#endif
+}
+
+static void store_u64(atomic_u64_t* const a, const uint64_t v)
+{
+#ifdef _MSC_VER
+	InterlockedExchange64(a, (LONG64)v);
+#else
+	atomic_store(a, v);
+#endif
+}
+
+static uint64_t exchange_u64(atomic_u64_t* const a, const uint64_t v)
+{
+#ifdef _MSC_VER
+	return (uint64_t)InterlockedExchange64(a, (LONG64)v);
+#else
+	return atomic_exchange(a, v);
+#endif
+}
+
+static uint64_t increment_u64(atomic_u64_t* const a)
+{
+#ifdef _MSC_VER
+	return (uint64_t)InterlockedIncrement64(a);
+#else
+	return atomic_fetch_add(a, 1) + 1;
+#endif
+}
+
+static void *load_ptr(atomic_ptr_t* const a)
+{
+#ifdef _MSC_VER
+	return InterlockedCompareExchangePointer(a, NULL, NULL);
+#else
+	return atomic_load(a);
+#endif
+}
+
+static void *exchange_ptr(atomic_ptr_t* const a, void* const v)
+{
+#ifdef _MSC_VER
+	return InterlockedExchangePointer(a, v);
+#else
+	return atomic_exchange(a, v);
+#endif
+}
+
+
+static void lock(struct gs1_dict_live* const live)
+{
+	while (exchange_u64(&live->lock, 1) != 0)
+		while (load_u64(&live->lock) != 0);
+}
+
+static void unlock(struct gs1_dict_live* const live)
+{
+	store_u64(&live->lock, 0);
+}
+
+
+/*
+ * Frees the retired dictionaries that no reader can still hold. Must be
+ * called with the lock held.
+ *
+ */
+static size_t reclaim(struct gs1_dict_live* const live)
+{
+
+	struct retired **r, *dead;
+	uint64_t oldest = UINT64_MAX, e;
+	size_t i, pending = 0;
+
+	for (i = 0; i < live->num_readers; i++)
+		if ((e = load_u64(&live->readers[i].epoch)) != 0 && e < oldest)
+			oldest = e;
+
+	for (r = &live->retired; *r; ) {
+		if ((*r)->epoch <= oldest) {
+			dead = *r;
+			*r = dead->next;
+			gs1_dict_free(dead->dict);
+			free(dead);
+		} else {
+			pending++;
+			r = &(*r)->next;
+		}
+	}
+
+	return pending;
+
+}
+
+
+/**
+ * Create a holder for a dictionary that can be replaced while other threads
+ * are reading it.
+ *
+ * @param [in] dict The initial dictionary, which is then owned by the holder.
+ * @param [in] max_readers The maximum number of concurrently registered
+ *                         reader threads.
+ *
+ * @return the holder, to be released with gs1_dict_live_free(), or `NULL` if
+ *         memory could not be allocated.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_dict_live_t *gs1_dict_live_create(gs1_dict_t* const dict, const size_t max_readers)
+{
+
+	struct gs1_dict_live *live;
+	size_t i;
+
+	assert(dict);
+
+	if ((live = calloc(1, sizeof(struct gs1_dict_live))) == NULL)
+		return NULL;
+
+	if ((live->readers = calloc(max_readers ? max_readers : 1, sizeof(struct gs1_dict_reader))) == NULL) {
+		free(live);
+		return NULL;
+	}
+	live->num_readers = max_readers;
+
+#ifdef _MSC_VER
+	live->current = dict;
+	live->epoch = 1;
+#else
+	atomic_init(&live->current, dict);
+	atomic_init(&live->epoch, 1);
+	atomic_init(&live->lock, 0);
+	for (i = 0; i < max_readers; i++) {
+		atomic_init(&live->readers[i].epoch, 0);
+		atomic_init(&live->readers[i].in_use, 0);
+	}
+#endif
+	for (i = 0; i < max_readers; i++)
+		live->readers[i].live = live;
+
+	return live;
+
+}
+
+
+/**
+ * Release a dictionary holder, including its current dictionary and any that
+ * have been replaced but not yet reclaimed.
+ *
+ * All readers must have been unregistered.
+ *
+ * @param [in] live The holder, or `NULL`.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_dict_live_free(gs1_dict_live_t* const live)
+{
+
+	struct retired *r, *next;
+
+	if (!live)
+		return;
+
+	for (r = live->retired; r; r = next) {
+		next = r->next;
+		gs1_dict_free(r->dict);
+		free(r);
+	}
+	gs1_dict_free((gs1_dict_t *)load_ptr(&live->current));
+	free(live->readers);
+	free(live);
+
+}
+
+
+/**
+ * Replace the current dictionary.
+ *
+ * Reads that begin after this returns see the new dictionary. Reads that are
+ * in progress continue with the old dictionary, which is freed by a later
+ * call to this function or gs1_dict_live_reclaim() once they have ended.
+ *
+ * @param [in] live The holder.
+ * @param [in] dict The new dictionary, which is then owned by the holder.
+ *
+ * @return #GS1_DICT_OK if okay, or #GS1_DICT_NO_MEMORY, in which case the
+ *         current dictionary is unchanged and dict remains owned by the
+ *         caller.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_dict_err_t gs1_dict_live_swap(gs1_dict_live_t* const live, gs1_dict_t* const dict)
+{
+
+	struct retired *r;
+
+	assert(live);
+	assert(dict);
+
+	if ((r = malloc(sizeof(struct retired))) == NULL)
+		return GS1_DICT_NO_MEMORY;
+
+	lock(live);
+
+	r->dict = (gs1_dict_t *)exchange_ptr(&live->current, dict);
+	r->epoch = increment_u64(&live->epoch);
+	r->next = live->retired;
+	live->retired = r;
+
+	reclaim(live);
+
+	unlock(live);
+
+	return GS1_DICT_OK;
+
+}
+
+
+/**
+ * Load a dictionary from the text of gs1-syntax-dictionary.txt, as for
+ * gs1_dict_load(), and make it the current dictionary.
+ *
+ * @param [in] live The holder.
+ * @param [in] text The dictionary text, which need not be null-terminated.
+ * @param [in] len The length of the text.
+ * @param [out] err_line The 1-based line number of an erroneous entry, if not
+ *                       `NULL`.
+ *
+ * @return #GS1_DICT_OK if okay, otherwise the reason that the dictionary
+ *         could not be loaded, in which case the current dictionary is
+ *         unchanged.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_dict_err_t gs1_dict_live_load(gs1_dict_live_t* const live, const char* const text, const size_t len,
+							   size_t* const err_line)
+{
+
+	gs1_dict_t *dict;
+	gs1_dict_err_t ret;
+
+	assert(live);
+
+	if ((ret = gs1_dict_load(text, len, &dict, err_line)) != GS1_DICT_OK)
+		return ret;
+
+	if ((ret = gs1_dict_live_swap(live, dict)) != GS1_DICT_OK)
+		gs1_dict_free(dict);
+
+	return ret;
+
+}
+
+
+/**
+ * Free the replaced dictionaries that are no longer in use by any reader.
+ *
+ * @param [in] live The holder.
+ *
+ * @return the number of replaced dictionaries that are still in use.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_dict_live_reclaim(gs1_dict_live_t* const live)
+{
+
+	size_t pending;
+
+	assert(live);
+
+	lock(live);
+	pending = reclaim(live);
+	unlock(live);
+
+	return pending;
+
+}
+
+
+/**
+ * Register the calling thread as a reader of a dictionary holder.
+ *
+ * A reader must only be used by one thread at a time.
+ *
+ * @param [in] live The holder.
+ *
+ * @return the reader, to be released with gs1_dict_reader_unregister(), or
+ *         `NULL` if the maximum number of readers are registered.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_dict_reader_t *gs1_dict_reader_register(gs1_dict_live_t* const live)
+{
+
+	size_t i;
+
+	assert(live);
+
+	for (i = 0; i < live->num_readers; i++)
+		if (exchange_u64(&live->readers[i].in_use, 1) == 0)
+			return &live->readers[i];
+
+	return NULL;
+
+}
+
+
+/**
+ * Release a reader.
+ *
+ * @param [in] reader The reader, which must not be within a read.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_dict_reader_unregister(gs1_dict_reader_t* const reader)
+{
+
+	assert(reader);
+	assert(load_u64(&reader->epoch) == 0);
+
+	store_u64(&reader->in_use, 0);
+
+}
+
+
+/**
+ * Begin a read, returning the current dictionary.
+ *
+ * The dictionary remains valid until the matching call to
+ * gs1_dict_read_end(), even if it is replaced in the meantime. Reads must not
+ * be nested.
+ *
+ * @param [in] reader The reader of the calling thread.
+ *
+ * @return the current dictionary.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API const gs1_dict_t *gs1_dict_read_begin(gs1_dict_reader_t* const reader)
+{
+
+	assert(reader);
+	assert(load_u64(&reader->epoch) == 0);
+
+	store_u64(&reader->epoch, load_u64(&reader->live->epoch));
+
+	return (const gs1_dict_t *)load_ptr(&reader->live->current);
+
+}
+
+
+/**
+ * End a read that was begun with gs1_dict_read_begin().
+ *
+ * @param [in] reader The reader of the calling thread.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_dict_read_end(gs1_dict_reader_t* const reader)
+{
+
+	assert(reader);
+
+	store_u64(&reader->epoch, 0);
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+#include <string.h>
+
+
+static const char test_dict_v1[] =
+	"01         *?  N14,csum,key                  # GTIN\n"
+	"10          ?  X..20                         # BATCH/LOT\n";
+
+static const char test_dict_v2[] =
+	"01         *?  N14,csum,key                  # GTIN\n"
+	"10          ?  X..20                         # BATCH/LOT\n"
+	"7250        ?  N8,yyyymmdd                   # DOB\n";
+
+
+void test_dictlive_swap(void)
+{
+
+	gs1_dict_t *dict;
+	gs1_dict_live_t *live;
+	gs1_dict_reader_t *r1, *r2;
+	const gs1_dict_t *d1, *d2;
+	size_t err_line;
+
+	TEST_ASSERT(gs1_dict_load(test_dict_v1, strlen(test_dict_v1), &dict, NULL) == GS1_DICT_OK);
+	TEST_ASSERT((live = gs1_dict_live_create(dict, 2)) != NULL);
+
+	TEST_ASSERT((r1 = gs1_dict_reader_register(live)) != NULL);
+	TEST_ASSERT((r2 = gs1_dict_reader_register(live)) != NULL);
+	TEST_CHECK(gs1_dict_reader_register(live) == NULL);
+
+	d1 = gs1_dict_read_begin(r1);
+	TEST_CHECK(d1 == dict);
+	TEST_CHECK(gs1_dict_find(d1, "7250", 4) < 0);
+
+	/*
+	 * Replaced while r1 is reading, so the old dictionary is retained.
+	 *
+	 */
+	TEST_CHECK(gs1_dict_live_load(live, test_dict_v2, strlen(test_dict_v2), NULL) == GS1_DICT_OK);
+	TEST_CHECK(gs1_dict_live_reclaim(live) == 1);
+
+	d2 = gs1_dict_read_begin(r2);
+	TEST_CHECK(d2 != d1);
+	TEST_CHECK(gs1_dict_find(d2, "7250", 4) >= 0);
+	TEST_CHECK(gs1_dict_find(d1, "10", 2) >= 0);
+	gs1_dict_read_end(r2);
+
+	TEST_CHECK(gs1_dict_live_reclaim(live) == 1);
+	gs1_dict_read_end(r1);
+	TEST_CHECK(gs1_dict_live_reclaim(live) == 0);
+
+	/*
+	 * A reader that began after a swap does not hold back the
+	 * reclamation of the dictionary that was replaced.
+	 *
+	 */
+	TEST_CHECK(gs1_dict_live_load(live, test_dict_v1, strlen(test_dict_v1), NULL) == GS1_DICT_OK);
+	TEST_CHECK(gs1_dict_live_reclaim(live) == 0);
+	d1 = gs1_dict_read_begin(r1);
+	TEST_CHECK(gs1_dict_live_load(live, test_dict_v2, strlen(test_dict_v2), NULL) == GS1_DICT_OK);
+	TEST_CHECK(gs1_dict_live_reclaim(live) == 1);
+	TEST_CHECK(gs1_dict_find(d1, "7250", 4) < 0);
+	gs1_dict_read_end(r1);
+	d1 = gs1_dict_read_begin(r1);
+	TEST_CHECK(gs1_dict_live_reclaim(live) == 0);
+	TEST_CHECK(gs1_dict_find(d1, "7250", 4) >= 0);
+	gs1_dict_read_end(r1);
+
+	/*
+	 * A dictionary that fails to load leaves the current one in place.
+	 *
+	 */
+	TEST_CHECK(gs1_dict_live_load(live, "XX N1\n", 6, &err_line) == GS1_DICT_INVALID_AI);
+	TEST_CHECK(err_line == 1);
+	d1 = gs1_dict_read_begin(r1);
+	TEST_CHECK(gs1_dict_find(d1, "7250", 4) >= 0);
+	gs1_dict_read_end(r1);
+
+	gs1_dict_reader_unregister(r2);
+	TEST_CHECK((r2 = gs1_dict_reader_register(live)) != NULL);
+	gs1_dict_reader_unregister(r1);
+	gs1_dict_reader_unregister(r2);
+
+	/*
+	 * Retired dictionaries that are pending are freed with the holder.
+	 *
+	 */
+	r1 = gs1_dict_reader_register(live);
+	gs1_dict_read_begin(r1);
+	TEST_CHECK(gs1_dict_live_load(live, test_dict_v1, strlen(test_dict_v1), NULL) == GS1_DICT_OK);
+	gs1_dict_read_end(r1);
+	gs1_dict_reader_unregister(r1);
+
+	gs1_dict_live_free(live);
+
+}
+
+#endif  /* UNIT_TESTS */
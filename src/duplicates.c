@@ -0,0 +1,238 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Detection of AIs that occur more than once within a message, e.g. where the
+ * data of several carriers marking the same item have been concatenated.
+ *
+ * A repeated AI is permitted only if each occurrence has the same value, in
+ * which case the repeats can be discarded. Conflicting values are an error.
+ *
+ * Each AI is mapped to a slot in a dense index: the dictionary entry number
+ * when a dictionary is given, otherwise the position of the AI among all
+ * possible 2-, 3- and 4-digit AIs. A bitset records which slots have been
+ * seen, alongside the position of the first occurrence, so the check is a
+ * single O(n) pass. Only the part of the bitset that is in use is cleared.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+#include "dictionary.h"
+
+
+#define WORD_BITS 64
+#define BITSET_WORDS ((DICT_INDEX_LEN + WORD_BITS - 1) / WORD_BITS)
+
+
+/**
+ * Detect conflicting occurrences of an AI within a message and discard
+ * identical repeats.
+ *
+ * If an AI occurs more than once with the same value then only its first
+ * occurrence is kept: the array is compacted in place, preserving order, and
+ * count is updated. This happens only if there are no conflicts.
+ *
+ * @param [in] dict A dictionary with which to check that each AI is defined,
+ *                  or `NULL`.
+ * @param [in,out] ais The AI data.
+ * @param [in,out] count The number of AIs.
+ * @param [out] pos The position of the first occurrence of a conflicting AI,
+ *                  if not `NULL`.
+ * @param [out] dup_pos The position of the occurrence that conflicts with the
+ *                      first, or of an unknown AI, if not `NULL`.
+ *
+ * @return #GS1_DUP_OK if there are no conflicts, otherwise the first problem
+ *         that was found.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_dup_err_t gs1_ai_dedup(const gs1_dict_t* const dict, gs1_ai_view_t* const ais, size_t* const count,
+						     size_t* const pos, size_t* const dup_pos)
+{
+
+	uint64_t seen[BITSET_WORDS];
+	uint16_t first[DICT_INDEX_LEN];
+	const size_t n = *count;
+	size_t i, j, w, words;
+	int slot, repeats = 0;
+
+	assert(ais || n == 0);
+
+	if (n > UINT16_MAX)
+		return GS1_DUP_TOO_MANY_AIS;
+
+	/*
+	 * With a dictionary, the slots are the entry numbers, so only a few
+	 * words of the bitset are in use.
+	 *
+	 */
+	words = dict ? (dict->count + WORD_BITS - 1) / WORD_BITS : BITSET_WORDS;
+	memset(seen, 0, words * sizeof(seen[0]));
+
+	for (i = 0; i < n; i++) {
+
+		if ((slot = gs1_dict_ai_key(ais[i].ai, ais[i].ai_len)) >= 0 && dict)
+			slot = (int)DICT_INDEX(dict, slot) - 1;
+
+		if (slot < 0) {
+			if (pos) *pos = i;
+			if (dup_pos) *dup_pos = i;
+			return GS1_DUP_UNKNOWN_AI;
+		}
+
+		if (!(seen[slot / WORD_BITS] & (UINT64_C(1) << (slot % WORD_BITS)))) {
+			seen[slot / WORD_BITS] |= UINT64_C(1) << (slot % WORD_BITS);
+			first[slot] = (uint16_t)i;
+			continue;
+		}
+
+		j = first[slot];
+		if (ais[j].value_len != ais[i].value_len || memcmp(ais[j].value, ais[i].value, ais[i].value_len) != 0) {
+			if (pos) *pos = j;
+			if (dup_pos) *dup_pos = i;
+			return GS1_DUP_CONFLICT;
+		}
+
+		repeats = 1;
+
+	}
+
+	if (!repeats)
+		return GS1_DUP_OK;
+
+	/*
+	 * Keep the first occurrence of each AI. The slots are recomputed
+	 * rather than stored since repeats are uncommon.
+	 *
+	 */
+	for (i = 0, w = 0; i < n; i++) {
+		slot = gs1_dict_ai_key(ais[i].ai, ais[i].ai_len);
+		if (dict)
+			slot = (int)DICT_INDEX(dict, slot) - 1;
+		if (first[slot] == i)
+			ais[w++] = ais[i];
+	}
+	*count = w;
+
+	return GS1_DUP_OK;
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#include "unittest.h"
+
+
+static const char test_dict[] =
+	"01         *?  N14,csum,key                  ex=02,255,37 dlpkey=22,10,21|235                    # GTIN\n"
+	"10          ?  X..20                         req=01,02,8006,8026                                 # BATCH/LOT\n"
+	"17         *?  N6,yymmd0                     req=01,02,255,8006,8026                             # USE BY or EXPIRY\n"
+	"21             X..20                         req=01,8006 ex=235                                  # SERIAL\n"
+	"3100-3105  *?  N6                            req=01,02 ex=310n                                   # NET WEIGHT (kg)\n";
+
+
+void test_duplicates_gs1_ai_dedup(void)
+{
+
+	gs1_dict_t *dict;
+	gs1_ai_view_t ais[8];
+	size_t count, pos, dup_pos;
+	int with_dict;
+
+	TEST_ASSERT(gs1_dict_load(test_dict, strlen(test_dict), &dict, NULL) == GS1_DICT_OK);
+
+	for (with_dict = 0; with_dict < 2; with_dict++) {
+
+		const gs1_dict_t * const d = with_dict ? dict : NULL;
+
+		TEST_CASE(with_dict ? "With dictionary" : "Without dictionary");
+
+		count = 0;
+		TEST_CHECK(gs1_ai_dedup(d, ais, &count, &pos, &dup_pos) == GS1_DUP_OK && count == 0);
+
+		set_ai(&ais[0], "01", "09521234543213");
+		set_ai(&ais[1], "10", "ABC");
+		set_ai(&ais[2], "3103", "000125");
+		set_ai(&ais[3], "3100", "000125");
+		count = 4;
+		TEST_CHECK(gs1_ai_dedup(d, ais, &count, &pos, &dup_pos) == GS1_DUP_OK && count == 4);
+
+		/*
+		 * Identical repeats, such as from concatenated symbols, are
+		 * collapsed.
+		 *
+		 */
+		set_ai(&ais[4], "10", "ABC");
+		set_ai(&ais[5], "01", "09521234543213");
+		set_ai(&ais[6], "17", "251231");
+		set_ai(&ais[7], "01", "09521234543213");
+		count = 8;
+		TEST_CHECK(gs1_ai_dedup(d, ais, &count, &pos, &dup_pos) == GS1_DUP_OK && count == 5);
+		TEST_CHECK(memcmp(ais[0].ai, "01", 2) == 0);
+		TEST_CHECK(memcmp(ais[1].ai, "10", 2) == 0);
+		TEST_CHECK(memcmp(ais[2].ai, "3103", 4) == 0);
+		TEST_CHECK(memcmp(ais[3].ai, "3100", 4) == 0);
+		TEST_CHECK(memcmp(ais[4].ai, "17", 2) == 0);
+
+		/*
+		 * Conflicting values, reported without modifying the data.
+		 *
+		 */
+		set_ai(&ais[5], "10", "ABD");
+		count = 6;
+		TEST_CHECK(gs1_ai_dedup(d, ais, &count, &pos, &dup_pos) == GS1_DUP_CONFLICT && count == 6);
+		TEST_CHECK(pos == 1 && dup_pos == 5);
+
+		set_ai(&ais[5], "10", "AB");
+		TEST_CHECK(gs1_ai_dedup(d, ais, &count, &pos, &dup_pos) == GS1_DUP_CONFLICT);
+		TEST_CHECK(pos == 1 && dup_pos == 5);
+
+		set_ai(&ais[5], "01", "09521234543213");
+		set_ai(&ais[6], "01", "09521234543213");
+		set_ai(&ais[7], "17", "251230");
+		count = 8;
+		TEST_CHECK(gs1_ai_dedup(d, ais, &count, NULL, NULL) == GS1_DUP_CONFLICT && count == 8);
+		TEST_CHECK(gs1_ai_dedup(d, ais, &count, &pos, &dup_pos) == GS1_DUP_CONFLICT);
+		TEST_CHECK(pos == 4 && dup_pos == 7);
+
+		set_ai(&ais[2], "1", "X");
+		count = 3;
+		TEST_CHECK(gs1_ai_dedup(d, ais, &count, &pos, &dup_pos) == GS1_DUP_UNKNOWN_AI);
+		TEST_CHECK(pos == 2 && dup_pos == 2);
+
+	}
+
+	/*
+	 * AIs that are not in the dictionary.
+	 *
+	 */
+	set_ai(&ais[2], "3106", "000125");
+	count = 3;
+	TEST_CHECK(gs1_ai_dedup(dict, ais, &count, &pos, &dup_pos) == GS1_DUP_UNKNOWN_AI);
+	TEST_CHECK(pos == 2 && dup_pos == 2);
+	TEST_CHECK(gs1_ai_dedup(NULL, ais, &count, &pos, &dup_pos) == GS1_DUP_OK);
+
+	gs1_dict_free(dict);
+
+}
+
+#endif  /* UNIT_TESTS */
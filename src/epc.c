@@ -0,0 +1,1687 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Conversion between AI element data and 96-bit EPC binary encodings, as
+ * defined by the GS1 EPC Tag Data Standard (TDS), for the SGTIN-96, SSCC-96
+ * and SGLN-96 schemes, and between AI element data and the corresponding EPC
+ * pure identity and tag URIs.
+ *
+ * The 96 bits are accumulated in a pair of 64-bit integers, so no big integer
+ * arithmetic is required: the largest field is the 58-bit SSCC serial
+ * reference.
+ *
+ * The position of the GS1 Company Prefix (GCP) within the key, which
+ * determines the partition value and the split between the components of a
+ * URI, is provided by a caller-supplied resolver.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+
+
+#define EPC96_HEADER_SGTIN	0x30
+#define EPC96_HEADER_SSCC	0x31
+#define EPC96_HEADER_SGLN	0x32
+
+#define EPC96_SGTIN_SERIAL_BITS	38
+#define EPC96_SGLN_EXT_BITS	41
+#define EPC96_SSCC_RESERVED_BITS	24
+
+
+/*
+ * TDS partition tables, indexed by partition value: the number of bits and
+ * digits for the GCP and for the reference that follows it.
+ *
+ */
+struct partition {
+	unsigned char gcp_bits;
+	unsigned char gcp_digits;
+	unsigned char ref_bits;
+	unsigned char ref_digits;
+};
+
+static const struct partition sgtin_partitions[] = {
+	{ 40, 12,  4, 1 },
+	{ 37, 11,  7, 2 },
+	{ 34, 10, 10, 3 },
+	{ 30,  9, 14, 4 },
+	{ 27,  8, 17, 5 },
+	{ 24,  7, 20, 6 },
+	{ 20,  6, 24, 7 },
+};
+
+static const struct partition sscc_partitions[] = {
+	{ 40, 12, 18,  5 },
+	{ 37, 11, 21,  6 },
+	{ 34, 10, 24,  7 },
+	{ 30,  9, 28,  8 },
+	{ 27,  8, 31,  9 },
+	{ 24,  7, 34, 10 },
+	{ 20,  6, 38, 11 },
+};
+
+static const struct partition sgln_partitions[] = {
+	{ 40, 12,  1, 0 },
+	{ 37, 11,  4, 1 },
+	{ 34, 10,  7, 2 },
+	{ 30,  9, 11, 3 },
+	{ 27,  8, 14, 4 },
+	{ 24,  7, 17, 5 },
+	{ 20,  6, 21, 6 },
+};
+
+#define NUM_PARTITIONS (sizeof(sgtin_partitions) / sizeof(sgtin_partitions[0]))
+
+
+static const uint64_t pow10[] = {
+	UINT64_C(1), UINT64_C(10), UINT64_C(100), UINT64_C(1000),
+	UINT64_C(10000), UINT64_C(100000), UINT64_C(1000000),
+	UINT64_C(10000000), UINT64_C(100000000), UINT64_C(1000000000),
+	UINT64_C(10000000000), UINT64_C(100000000000),
+	UINT64_C(1000000000000), UINT64_C(10000000000000),
+};
+
+
+/*
+ * 96-bit big-endian bit string, held as the top 32 bits in hi and the bottom
+ * 64 bits in lo.
+ *
+ */
+struct bits96 {
+	uint64_t hi;
+	uint64_t lo;
+};
+
+static void put_bits(struct bits96* const b, const uint64_t v, const unsigned int n)
+{
+	assert(n > 0 && n < 64);
+	assert(v >> n == 0);
+	b->hi = (b->hi << n) | (b->lo >> (64 - n));
+	b->lo = (b->lo << n) | v;
+}
+
+static uint64_t get_bits(const struct bits96* const b, unsigned int* const pos, const unsigned int n)
+{
+
+	const unsigned int shift = 96 - *pos - n;
+	uint64_t v;
+
+	assert(n > 0 && n < 64 && *pos + n <= 96);
+
+	if (shift >= 64)
+		v = b->hi >> (shift - 64);
+	else if (shift == 0)
+		v = b->lo;
+	else
+		v = (b->lo >> shift) | (b->hi << (64 - shift));
+
+	*pos += n;
+	return v & ((UINT64_C(1) << n) - 1);
+
+}
+
+static void bits_to_bytes(const struct bits96* const b, uint8_t* const epc)
+{
+	int i;
+	for (i = 0; i < 4; i++)
+		epc[i] = (uint8_t)(b->hi >> (24 - 8 * i));
+	for (i = 0; i < 8; i++)
+		epc[4 + i] = (uint8_t)(b->lo >> (56 - 8 * i));
+}
+
+static void bytes_to_bits(const uint8_t* const epc, struct bits96* const b)
+{
+	int i;
+	b->hi = b->lo = 0;
+	for (i = 0; i < 4; i++)
+		b->hi = (b->hi << 8) | epc[i];
+	for (i = 4; i < 12; i++)
+		b->lo = (b->lo << 8) | epc[i];
+}
+
+
+static const gs1_ai_view_t *find_ai(const gs1_ai_view_t* const ais, const size_t count, const char* const ai)
+{
+	const size_t len = strlen(ai);
+	size_t i;
+	for (i = 0; i < count; i++)
+		if (ais[i].ai_len == len && memcmp(ais[i].ai, ai, len) == 0)
+			return &ais[i];
+	return NULL;
+}
+
+
+/*
+ * Value of a string of at most 19 digits. Returns 0 if any character is not
+ * a digit.
+ *
+ */
+static int digits_to_u64(const char* const s, const size_t len, uint64_t* const v)
+{
+	size_t i;
+	assert(len < 20);
+	*v = 0;
+	for (i = 0; i < len; i++) {
+		if (s[i] < '0' || s[i] > '9')
+			return 0;
+		*v = *v * 10 + (uint64_t)(s[i] - '0');
+	}
+	return 1;
+}
+
+static void u64_to_digits(char* const s, uint64_t v, const size_t len)
+{
+	size_t i = len;
+	while (i > 0) {
+		s[--i] = (char)('0' + v % 10);
+		v /= 10;
+	}
+}
+
+/*
+ * Writes v without leading zeros, returning the number of digits.
+ *
+ */
+static size_t u64_to_str(char* const s, uint64_t v)
+{
+	size_t len = 1;
+	while (len < sizeof(pow10) / sizeof(pow10[0]) && v >= pow10[len])
+		len++;
+	u64_to_digits(s, v, len);
+	return len;
+}
+
+/*
+ * GS1 check digit for the given digits, which precede it.
+ *
+ */
+static char check_digit(const char* const s, const size_t len)
+{
+	unsigned int sum = 0, weight = 3;
+	size_t i = len;
+	while (i > 0) {
+		sum += weight * (unsigned int)(s[--i] - '0');
+		weight = 4 - weight;
+	}
+	return (char)('0' + (10 - sum % 10) % 10);
+}
+
+/*
+ * A key of exactly len digits with a correct check digit.
+ *
+ */
+static int valid_key(const gs1_ai_view_t* const v, const size_t len)
+{
+	uint64_t unused;
+	return v->value_len == len &&
+	       digits_to_u64(v->value, len / 2, &unused) &&
+	       digits_to_u64(v->value + len / 2, len - len / 2, &unused) &&
+	       check_digit(v->value, len - 1) == v->value[len - 1];
+}
+
+/*
+ * A numeric serial component without leading zeros that fits in the given
+ * number of bits.
+ *
+ */
+static int serial_value(const char* const s, const size_t len, const unsigned int bits, uint64_t* const v)
+{
+	if (len == 0 || len > 13 || (len > 1 && s[0] == '0'))
+		return 0;
+	return digits_to_u64(s, len, v) && *v >> bits == 0;
+}
+
+static gs1_epc_err_t resolve_partition(const gs1_gcp_length_resolver_t resolver, void* const ctx,
+				       const char* const key, const size_t key_len,
+				       const struct partition* const partitions, unsigned int* const partition)
+{
+
+	size_t gcp_len;
+	unsigned int p;
+
+	assert(resolver);
+
+	if ((gcp_len = resolver(ctx, key, key_len)) == 0)
+		return GS1_EPC_UNKNOWN_GCP;
+
+	for (p = 0; p < NUM_PARTITIONS; p++) {
+		if (partitions[p].gcp_digits == gcp_len) {
+			*partition = p;
+			return GS1_EPC_OK;
+		}
+	}
+
+	return GS1_EPC_INVALID_GCP_LENGTH;
+
+}
+
+
+static gs1_epc_err_t encode_sgtin96(const gs1_ai_view_t* const ais, const size_t count, const unsigned int filter,
+				    const gs1_gcp_length_resolver_t resolver, void* const ctx, struct bits96* const b)
+{
+
+	const gs1_ai_view_t *gtin, *serial;
+	const struct partition *part;
+	unsigned int p;
+	uint64_t gcp, ref, ser;
+	gs1_epc_err_t ret;
+
+	if ((gtin = find_ai(ais, count, "01")) == NULL || (serial = find_ai(ais, count, "21")) == NULL)
+		return GS1_EPC_MISSING_AI;
+
+	if (!valid_key(gtin, 14))
+		return GS1_EPC_INVALID_KEY;
+
+	if (!serial_value(serial->value, serial->value_len, EPC96_SGTIN_SERIAL_BITS, &ser))
+		return GS1_EPC_INVALID_SERIAL;
+
+	/*
+	 * The GCP follows the indicator digit. The item reference is the
+	 * indicator digit followed by the remaining digits before the check
+	 * digit.
+	 *
+	 */
+	if ((ret = resolve_partition(resolver, ctx, gtin->value + 1, 13, sgtin_partitions, &p)) != GS1_EPC_OK)
+		return ret;
+	part = &sgtin_partitions[p];
+
+	digits_to_u64(gtin->value + 1, part->gcp_digits, &gcp);
+	digits_to_u64(gtin->value + 1 + part->gcp_digits, 12u - part->gcp_digits, &ref);
+	ref += (uint64_t)(gtin->value[0] - '0') * pow10[12 - part->gcp_digits];
+
+	put_bits(b, EPC96_HEADER_SGTIN, 8);
+	put_bits(b, filter, 3);
+	put_bits(b, p, 3);
+	put_bits(b, gcp, part->gcp_bits);
+	put_bits(b, ref, part->ref_bits);
+	put_bits(b, ser, EPC96_SGTIN_SERIAL_BITS);
+
+	return GS1_EPC_OK;
+
+}
+
+
+static gs1_epc_err_t encode_sscc96(const gs1_ai_view_t* const ais, const size_t count, const unsigned int filter,
+				   const gs1_gcp_length_resolver_t resolver, void* const ctx, struct bits96* const b)
+{
+
+	const gs1_ai_view_t *sscc;
+	const struct partition *part;
+	unsigned int p;
+	uint64_t gcp, ref;
+	gs1_epc_err_t ret;
+
+	if ((sscc = find_ai(ais, count, "00")) == NULL)
+		return GS1_EPC_MISSING_AI;
+
+	if (!valid_key(sscc, 18))
+		return GS1_EPC_INVALID_KEY;
+
+	/*
+	 * The GCP follows the extension digit. The serial reference is the
+	 * extension digit followed by the remaining digits before the check
+	 * digit.
+	 *
+	 */
+	if ((ret = resolve_partition(resolver, ctx, sscc->value + 1, 17, sscc_partitions, &p)) != GS1_EPC_OK)
+		return ret;
+	part = &sscc_partitions[p];
+
+	digits_to_u64(sscc->value + 1, part->gcp_digits, &gcp);
+	digits_to_u64(sscc->value + 1 + part->gcp_digits, 16u - part->gcp_digits, &ref);
+	ref += (uint64_t)(sscc->value[0] - '0') * pow10[16 - part->gcp_digits];
+
+	put_bits(b, EPC96_HEADER_SSCC, 8);
+	put_bits(b, filter, 3);
+	put_bits(b, p, 3);
+	put_bits(b, gcp, part->gcp_bits);
+	put_bits(b, ref, part->ref_bits);
+	put_bits(b, 0, EPC96_SSCC_RESERVED_BITS);
+
+	return GS1_EPC_OK;
+
+}
+
+
+static gs1_epc_err_t encode_sgln96(const gs1_ai_view_t* const ais, const size_t count, const unsigned int filter,
+				   const gs1_gcp_length_resolver_t resolver, void* const ctx, struct bits96* const b)
+{
+
+	const gs1_ai_view_t *gln, *ext;
+	const struct partition *part;
+	unsigned int p;
+	uint64_t gcp, ref = 0, extension = 0;
+	gs1_epc_err_t ret;
+
+	if ((gln = find_ai(ais, count, "414")) == NULL)
+		return GS1_EPC_MISSING_AI;
+
+	if (!valid_key(gln, 13))
+		return GS1_EPC_INVALID_KEY;
+
+	/*
+	 * An absent extension is encoded as zero.
+	 *
+	 */
+	ext = find_ai(ais, count, "254");
+	if (ext && !serial_value(ext->value, ext->value_len, EPC96_SGLN_EXT_BITS, &extension))
+		return GS1_EPC_INVALID_SERIAL;
+
+	if ((ret = resolve_partition(resolver, ctx, gln->value, 13, sgln_partitions, &p)) != GS1_EPC_OK)
+		return ret;
+	part = &sgln_partitions[p];
+
+	digits_to_u64(gln->value, part->gcp_digits, &gcp);
+	digits_to_u64(gln->value + part->gcp_digits, part->ref_digits, &ref);
+
+	put_bits(b, EPC96_HEADER_SGLN, 8);
+	put_bits(b, filter, 3);
+	put_bits(b, p, 3);
+	put_bits(b, gcp, part->gcp_bits);
+	put_bits(b, ref, part->ref_bits);
+	put_bits(b, extension, EPC96_SGLN_EXT_BITS);
+
+	return GS1_EPC_OK;
+
+}
+
+
+/**
+ * Encode AI data as a 96-bit binary EPC.
+ *
+ * @param [in] scheme The EPC scheme: #GS1_EPC_SGTIN_96 requires AIs (01) and
+ *                    (21), #GS1_EPC_SSCC_96 requires (00) and
+ *                    #GS1_EPC_SGLN_96 requires (414) with optional (254).
+ *                    Other AIs are ignored.
+ * @param [in] ais The AI data, which should have been validated.
+ * @param [in] count The number of AIs.
+ * @param [in] filter The EPC filter value, 0 to 7.
+ * @param [in] resolver Determines the length of the GCP within the key.
+ * @param [in] ctx Passed to the resolver.
+ * @param [out] epc The 12 bytes of the binary EPC, most significant first.
+ *
+ * @return #GS1_EPC_OK if okay, otherwise the reason that the data cannot be
+ *         encoded.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_epc_err_t gs1_epc_encode96(const gs1_epc_scheme_t scheme, const gs1_ai_view_t* const ais, const size_t count, const unsigned int filter,
+							 const gs1_gcp_length_resolver_t resolver, void* const ctx, uint8_t* const epc)
+{
+
+	struct bits96 b = { 0, 0 };
+	gs1_epc_err_t ret;
+
+	assert(ais || count == 0);
+	assert(epc);
+
+	if (filter > 7)
+		return GS1_EPC_INVALID_FILTER;
+
+	switch (scheme) {
+	case GS1_EPC_SGTIN_96:
+		ret = encode_sgtin96(ais, count, filter, resolver, ctx, &b);
+		break;
+	case GS1_EPC_SSCC_96:
+		ret = encode_sscc96(ais, count, filter, resolver, ctx, &b);
+		break;
+	case GS1_EPC_SGLN_96:
+		ret = encode_sgln96(ais, count, filter, resolver, ctx, &b);
+		break;
+	default:
+		ret = GS1_EPC_INVALID_HEADER;
+		break;
+	}
+
+	if (ret == GS1_EPC_OK)
+		bits_to_bytes(&b, epc);
+
+	return ret;
+
+}
+
+
+/*
+ * Writes an AI and its value into buf, setting the view.
+ *
+ */
+static char *put_ai(char *p, const char* const ai, gs1_ai_view_t* const v)
+{
+	const size_t len = strlen(ai);
+	memcpy(p, ai, len);
+	v->ai = p;
+	v->ai_len = len;
+	v->value = p + len;
+	return p + len;
+}
+
+static char *put_str(char* const p, const char* const s)
+{
+	const size_t len = strlen(s);
+	memcpy(p, s, len);
+	return p + len;
+}
+
+
+/**
+ * Decode a 96-bit binary EPC into AI data.
+ *
+ * The AIs and their values are written into buf, which should have at least
+ * #GS1_EPC96_DECODE_BUF_LEN bytes, and ais is set to views of them (at most
+ * two).
+ *
+ * @param [in] epc The 12 bytes of the binary EPC, most significant first.
+ * @param [out] scheme The EPC scheme, if not `NULL`.
+ * @param [out] filter The filter value, if not `NULL`.
+ * @param [out] buf Storage for the AI data.
+ * @param [in] buf_len The size of buf.
+ * @param [out] ais Views of the decoded AIs, with room for two.
+ * @param [out] count The number of decoded AIs.
+ *
+ * @return #GS1_EPC_OK if okay, otherwise the reason that the EPC cannot be
+ *         decoded.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_epc_err_t gs1_epc_decode96(const uint8_t* const epc, gs1_epc_scheme_t* const scheme, unsigned int* const filter,
+							 char* const buf, const size_t buf_len, gs1_ai_view_t* const ais, size_t* const count)
+{
+
+	const struct partition *part;
+	struct bits96 b;
+	unsigned int pos = 0, p;
+	uint64_t header, gcp, ref, extra;
+	char *q = buf;
+
+	assert(epc);
+	assert(buf);
+	assert(ais);
+	assert(count);
+
+	if (buf_len < GS1_EPC96_DECODE_BUF_LEN)
+		return GS1_EPC_BUFFER_TOO_SMALL;
+
+	bytes_to_bits(epc, &b);
+
+	header = get_bits(&b, &pos, 8);
+	if (filter)
+		*filter = (unsigned int)get_bits(&b, &pos, 3);
+	else
+		pos += 3;
+	p = (unsigned int)get_bits(&b, &pos, 3);
+
+	if (p >= NUM_PARTITIONS)
+		return GS1_EPC_INVALID_PARTITION;
+
+	switch (header) {
+
+	case EPC96_HEADER_SGTIN:
+		part = &sgtin_partitions[p];
+		gcp = get_bits(&b, &pos, part->gcp_bits);
+		ref = get_bits(&b, &pos, part->ref_bits);
+		extra = get_bits(&b, &pos, EPC96_SGTIN_SERIAL_BITS);
+		if (gcp >= pow10[part->gcp_digits] || ref >= pow10[part->ref_digits])
+			return GS1_EPC_INVALID_ENCODING;
+
+		/*
+		 * Indicator digit, GCP, item reference, check digit.
+		 *
+		 */
+		q = put_ai(q, "01", &ais[0]);
+		u64_to_digits(q, ref / pow10[part->ref_digits - 1], 1);
+		u64_to_digits(q + 1, gcp, part->gcp_digits);
+		u64_to_digits(q + 1 + part->gcp_digits, ref % pow10[part->ref_digits - 1], part->ref_digits - 1u);
+		q[13] = check_digit(q, 13);
+		ais[0].value_len = 14;
+		q += 14;
+
+		q = put_ai(q, "21", &ais[1]);
+		ais[1].value_len = u64_to_str(q, extra);
+		*count = 2;
+
+		if (scheme) *scheme = GS1_EPC_SGTIN_96;
+		break;
+
+	case EPC96_HEADER_SSCC:
+		part = &sscc_partitions[p];
+		gcp = get_bits(&b, &pos, part->gcp_bits);
+		ref = get_bits(&b, &pos, part->ref_bits);
+		if (gcp >= pow10[part->gcp_digits] || ref >= pow10[part->ref_digits])
+			return GS1_EPC_INVALID_ENCODING;
+
+		/*
+		 * Extension digit, GCP, serial reference, check digit.
+		 *
+		 */
+		q = put_ai(q, "00", &ais[0]);
+		u64_to_digits(q, ref / pow10[part->ref_digits - 1], 1);
+		u64_to_digits(q + 1, gcp, part->gcp_digits);
+		u64_to_digits(q + 1 + part->gcp_digits, ref % pow10[part->ref_digits - 1], part->ref_digits - 1u);
+		q[17] = check_digit(q, 17);
+		ais[0].value_len = 18;
+		*count = 1;
+
+		if (scheme) *scheme = GS1_EPC_SSCC_96;
+		break;
+
+	case EPC96_HEADER_SGLN:
+		part = &sgln_partitions[p];
+		gcp = get_bits(&b, &pos, part->gcp_bits);
+		ref = get_bits(&b, &pos, part->ref_bits);
+		extra = get_bits(&b, &pos, EPC96_SGLN_EXT_BITS);
+		if (gcp >= pow10[part->gcp_digits] || ref >= pow10[part->ref_digits])
+			return GS1_EPC_INVALID_ENCODING;
+
+		/*
+		 * GCP, location reference, check digit.
+		 *
+		 */
+		q = put_ai(q, "414", &ais[0]);
+		u64_to_digits(q, gcp, part->gcp_digits);
+		u64_to_digits(q + part->gcp_digits, ref, part->ref_digits);
+		q[12] = check_digit(q, 12);
+		ais[0].value_len = 13;
+		q += 13;
+		*count = 1;
+
+		/*
+		 * A zero extension indicates that there is no (254).
+		 *
+		 */
+		if (extra != 0) {
+			q = put_ai(q, "254", &ais[1]);
+			ais[1].value_len = u64_to_str(q, extra);
+			*count = 2;
+		}
+
+		if (scheme) *scheme = GS1_EPC_SGLN_96;
+		break;
+
+	default:
+		return GS1_EPC_INVALID_HEADER;
+
+	}
+
+	return GS1_EPC_OK;
+
+}
+
+
+/**
+ * Encode a batch of messages as 96-bit binary EPCs.
+ *
+ * The AIs of message i are ais[offsets[i]] to ais[offsets[i+1] - 1], so
+ * offsets has count + 1 entries. The EPC for message i is written to
+ * epcs[12*i] and the return code to codes[i].
+ *
+ * @return the number of messages that could not be encoded.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_epc_encode96_batch(const gs1_epc_scheme_t scheme, const gs1_ai_view_t* const ais, const uint32_t* const offsets, const size_t count,
+							const unsigned int filter, const gs1_gcp_length_resolver_t resolver, void* const ctx,
+							uint8_t* const epcs, int32_t* const codes)
+{
+
+	size_t i, fails = 0;
+
+	assert(offsets);
+	assert(epcs || count == 0);
+	assert(codes || count == 0);
+
+	for (i = 0; i < count; i++) {
+		const gs1_epc_err_t ret = gs1_epc_encode96(scheme, &ais[offsets[i]], offsets[i+1] - offsets[i], filter, resolver, ctx, &epcs[12 * i]);
+		codes[i] = (int32_t)ret;
+		if (ret != GS1_EPC_OK)
+			fails++;
+	}
+
+	return fails;
+
+}
+
+
+/**
+ * Decode a batch of 96-bit binary EPCs.
+ *
+ * EPC i is read from epcs[12*i]. Its AI data is written to buf starting at
+ * buf[i * #GS1_EPC96_DECODE_BUF_LEN], with views of the AIs written to ais[2*i]
+ * and ais[2*i + 1], their number to ai_counts[i] and the return code to
+ * codes[i].
+ *
+ * @return the number of EPCs that could not be decoded.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_epc_decode96_batch(const uint8_t* const epcs, const size_t count, char* const buf,
+							gs1_ai_view_t* const ais, size_t* const ai_counts, int32_t* const codes)
+{
+
+	size_t i, fails = 0;
+
+	assert(epcs || count == 0);
+	assert(buf || count == 0);
+	assert(ais || count == 0);
+	assert(ai_counts || count == 0);
+	assert(codes || count == 0);
+
+	for (i = 0; i < count; i++) {
+		const gs1_epc_err_t ret = gs1_epc_decode96(&epcs[12 * i], NULL, NULL, &buf[i * GS1_EPC96_DECODE_BUF_LEN],
+							   GS1_EPC96_DECODE_BUF_LEN, &ais[2 * i], &ai_counts[i]);
+		codes[i] = (int32_t)ret;
+		if (ret != GS1_EPC_OK) {
+			ai_counts[i] = 0;
+			fails++;
+		}
+	}
+
+	return fails;
+
+}
+
+
+/*
+ * EPC URI prefixes, indexed by form and scheme.
+ *
+ */
+static const char uri_prefixes[2][3][22] = {
+	{ "urn:epc:id:sgtin:", "urn:epc:id:sscc:", "urn:epc:id:sgln:" },
+	{ "urn:epc:tag:sgtin-96:", "urn:epc:tag:sscc-96:", "urn:epc:tag:sgln-96:" },
+};
+
+/*
+ * Characters of CSET 82 that must be percent-encoded within the serial
+ * component of a pure identity URI.
+ *
+ */
+static const char uri_escaped[] = "\"%&/<>?";
+
+#define URI_MAX_SERIAL_LEN 20
+
+
+static int must_escape(const char c)
+{
+	return c != '\0' && strchr(uri_escaped, c) != NULL;
+}
+
+/*
+ * A serial component of a pure identity URI: 1 to 20 CSET 82 characters.
+ *
+ */
+static int cset82_value(const char* const s, const size_t len)
+{
+	char tmp[URI_MAX_SERIAL_LEN + 1];
+
+	if (len == 0 || len > URI_MAX_SERIAL_LEN || memchr(s, '\0', len))
+		return 0;
+	memcpy(tmp, s, len);
+	tmp[len] = '\0';
+	return gs1_lint_cset82(tmp, NULL, NULL) == GS1_LINTER_OK;
+}
+
+static int hex_value(const char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+static char *put_escaped(char *q, const char* const s, const size_t len)
+{
+	static const char hex[] = "0123456789ABCDEF";
+	size_t i;
+	for (i = 0; i < len; i++) {
+		if (must_escape(s[i])) {
+			*q++ = '%';
+			*q++ = hex[(unsigned char)s[i] >> 4];
+			*q++ = hex[(unsigned char)s[i] & 15];
+		} else
+			*q++ = s[i];
+	}
+	return q;
+}
+
+/*
+ * Decodes the serial component of a pure identity URI into q, which must
+ * have room for URI_MAX_SERIAL_LEN characters.
+ *
+ */
+static gs1_epc_err_t get_unescaped(const char* const s, const size_t len, char* const q, size_t* const out_len)
+{
+
+	size_t i, n = 0;
+	int hi, lo;
+	char c;
+
+	for (i = 0; i < len; i++) {
+		c = s[i];
+		if (c == '%') {
+			if (len - i < 3 || (hi = hex_value(s[i+1])) < 0 || (lo = hex_value(s[i+2])) < 0)
+				return GS1_EPC_INVALID_URI;
+			c = (char)(hi << 4 | lo);
+			i += 2;
+		} else if (must_escape(c))
+			return GS1_EPC_INVALID_URI;
+		if (n == URI_MAX_SERIAL_LEN)
+			return GS1_EPC_INVALID_SERIAL;
+		q[n++] = c;
+	}
+
+	if (!cset82_value(q, n))
+		return GS1_EPC_INVALID_SERIAL;
+
+	*out_len = n;
+	return GS1_EPC_OK;
+
+}
+
+
+/*
+ * Writes the URI for the given AI data into out, which must have room for
+ * GS1_EPC_URI_BUF_LEN - 1 characters. The URI is not null-terminated.
+ *
+ */
+static gs1_epc_err_t ais_to_uri(const gs1_epc_scheme_t scheme, const gs1_epc_uri_form_t form, const unsigned int filter,
+				const gs1_ai_view_t* const ais, const size_t count,
+				const gs1_gcp_length_resolver_t resolver, void* const ctx,
+				char* const out, size_t* const len)
+{
+
+	const gs1_ai_view_t *key, *serial = NULL;
+	const struct partition *partitions;
+	size_t key_len, gcp_len, ind;
+	unsigned int p, serial_bits;
+	uint64_t unused;
+	gs1_epc_err_t ret;
+	char *q = out;
+
+	switch (scheme) {
+	case GS1_EPC_SGTIN_96:
+		if ((serial = find_ai(ais, count, "21")) == NULL)
+			return GS1_EPC_MISSING_AI;
+		key = find_ai(ais, count, "01");
+		key_len = 14;
+		partitions = sgtin_partitions;
+		serial_bits = EPC96_SGTIN_SERIAL_BITS;
+		break;
+	case GS1_EPC_SSCC_96:
+		key = find_ai(ais, count, "00");
+		key_len = 18;
+		partitions = sscc_partitions;
+		serial_bits = 0;
+		break;
+	case GS1_EPC_SGLN_96:
+		key = find_ai(ais, count, "414");
+		serial = find_ai(ais, count, "254");
+		key_len = 13;
+		partitions = sgln_partitions;
+		serial_bits = EPC96_SGLN_EXT_BITS;
+		break;
+	default:
+		return GS1_EPC_INVALID_HEADER;
+	}
+
+	if (form != GS1_EPC_URI_ID && form != GS1_EPC_URI_TAG)
+		return GS1_EPC_INVALID_URI;
+
+	if (form == GS1_EPC_URI_TAG && filter > 7)
+		return GS1_EPC_INVALID_FILTER;
+
+	if (!key)
+		return GS1_EPC_MISSING_AI;
+
+	if (!valid_key(key, key_len))
+		return GS1_EPC_INVALID_KEY;
+
+	/*
+	 * The serial component of a tag URI is limited to what its binary
+	 * encoding can represent.
+	 *
+	 */
+	if (serial && !(form == GS1_EPC_URI_TAG ?
+			serial_value(serial->value, serial->value_len, serial_bits, &unused) :
+			cset82_value(serial->value, serial->value_len)))
+		return GS1_EPC_INVALID_SERIAL;
+
+	/*
+	 * The GCP of a GTIN or SSCC follows its indicator or extension digit,
+	 * which is moved to the start of the reference component.
+	 *
+	 */
+	ind = scheme == GS1_EPC_SGLN_96 ? 0 : 1;
+	if ((ret = resolve_partition(resolver, ctx, key->value + ind, key_len - ind, partitions, &p)) != GS1_EPC_OK)
+		return ret;
+	gcp_len = partitions[p].gcp_digits;
+
+	q = put_str(q, uri_prefixes[form][scheme]);
+	if (form == GS1_EPC_URI_TAG) {
+		*q++ = (char)('0' + filter);
+		*q++ = '.';
+	}
+
+	memcpy(q, key->value + ind, gcp_len);
+	q += gcp_len;
+	*q++ = '.';
+	if (ind)
+		*q++ = key->value[0];
+	memcpy(q, key->value + ind + gcp_len, key_len - 1 - ind - gcp_len);
+	q += key_len - 1 - ind - gcp_len;
+
+	/*
+	 * An absent GLN extension is represented as "0".
+	 *
+	 */
+	if (scheme != GS1_EPC_SSCC_96) {
+		*q++ = '.';
+		if (!serial)
+			*q++ = '0';
+		else if (form == GS1_EPC_URI_TAG) {
+			memcpy(q, serial->value, serial->value_len);
+			q += serial->value_len;
+		} else
+			q = put_escaped(q, serial->value, serial->value_len);
+	}
+
+	*len = (size_t)(q - out);
+	assert(*len < GS1_EPC_URI_BUF_LEN);
+
+	return GS1_EPC_OK;
+
+}
+
+
+/**
+ * Convert AI data to an EPC pure identity URI or tag URI.
+ *
+ * For example, (01) 80614141123458 (21) 6789 with a seven digit GCP becomes
+ * "urn:epc:id:sgtin:0614141.812345.6789" or, as a tag URI with filter 3,
+ * "urn:epc:tag:sgtin-96:3.0614141.812345.6789".
+ *
+ * The serial component of a pure identity URI may contain any CSET 82
+ * characters, which are percent-encoded where required. The serial component
+ * of a tag URI must satisfy the constraints of the 96-bit binary encoding.
+ *
+ * @param [in] scheme The EPC scheme, which determines the AIs that are
+ *                    required, as for gs1_epc_encode96().
+ * @param [in] form #GS1_EPC_URI_ID or #GS1_EPC_URI_TAG.
+ * @param [in] filter The EPC filter value, 0 to 7, for a tag URI.
+ * @param [in] ais The AI data, which should have been validated.
+ * @param [in] count The number of AIs.
+ * @param [in] resolver Determines the length of the GCP within the key.
+ * @param [in] ctx Passed to the resolver.
+ * @param [out] uri Buffer that receives the null-terminated URI.
+ *                  #GS1_EPC_URI_BUF_LEN bytes are always sufficient.
+ * @param [in] uri_len The size of the uri buffer.
+ * @param [out] len The length of the URI, if not `NULL`.
+ *
+ * @return #GS1_EPC_OK if okay, otherwise the reason that the data cannot be
+ *         converted.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_epc_err_t gs1_epc_to_uri(const gs1_epc_scheme_t scheme, const gs1_epc_uri_form_t form, const unsigned int filter,
+						       const gs1_ai_view_t* const ais, const size_t count,
+						       const gs1_gcp_length_resolver_t resolver, void* const ctx,
+						       char* const uri, const size_t uri_len, size_t* const len)
+{
+
+	char tmp[GS1_EPC_URI_BUF_LEN];
+	size_t n = 0;
+	gs1_epc_err_t ret;
+
+	assert(ais || count == 0);
+	assert(uri);
+
+	/*
+	 * Write directly into a buffer that is known to be large enough.
+	 *
+	 */
+	if ((ret = ais_to_uri(scheme, form, filter, ais, count, resolver, ctx,
+			      uri_len >= GS1_EPC_URI_BUF_LEN ? uri : tmp, &n)) != GS1_EPC_OK)
+		return ret;
+
+	if (uri_len < GS1_EPC_URI_BUF_LEN) {
+		if (n >= uri_len)
+			return GS1_EPC_BUFFER_TOO_SMALL;
+		memcpy(uri, tmp, n);
+	}
+	uri[n] = '\0';
+
+	if (len)
+		*len = n;
+
+	return GS1_EPC_OK;
+
+}
+
+
+/*
+ * Number of leading digits.
+ *
+ */
+static size_t digit_run(const char* const s, const size_t len)
+{
+	size_t i = 0;
+	while (i < len && s[i] >= '0' && s[i] <= '9')
+		i++;
+	return i;
+}
+
+
+/**
+ * Convert an EPC pure identity URI or tag URI to AI data.
+ *
+ * The AIs and their values are written into buf, which should have at least
+ * #GS1_EPC_URI_DECODE_BUF_LEN bytes, and ais is set to views of them (at
+ * most two). No GCP lookup is required since the URI delimits the GCP.
+ *
+ * @param [in] uri The URI, which need not be null-terminated.
+ * @param [in] uri_len The length of the URI.
+ * @param [out] scheme The EPC scheme, if not `NULL`.
+ * @param [out] form The form of the URI, if not `NULL`.
+ * @param [out] filter The filter value of a tag URI, or 0 for a pure
+ *                     identity URI, if not `NULL`.
+ * @param [out] buf Storage for the AI data.
+ * @param [in] buf_len The size of buf.
+ * @param [out] ais Views of the AIs, with room for two.
+ * @param [out] count The number of AIs.
+ *
+ * @return #GS1_EPC_OK if okay, otherwise the reason that the URI cannot be
+ *         converted.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_epc_err_t gs1_epc_from_uri(const char* const uri, const size_t uri_len,
+							 gs1_epc_scheme_t* const scheme, gs1_epc_uri_form_t* const form, unsigned int* const filter,
+							 char* const buf, const size_t buf_len, gs1_ai_view_t* const ais, size_t* const count)
+{
+
+	const struct partition *partitions = NULL, *part = NULL;
+	const char *p, *end, *gcp, *ref;
+	size_t plen, gcp_len, ref_len;
+	unsigned int f, s = 0, fv = 0, i;
+	uint64_t v;
+	gs1_epc_err_t ret;
+	char *q = buf;
+
+	assert(uri || uri_len == 0);
+	assert(buf);
+	assert(ais);
+	assert(count);
+
+	if (buf_len < GS1_EPC_URI_DECODE_BUF_LEN)
+		return GS1_EPC_BUFFER_TOO_SMALL;
+
+	for (f = 0; f < 2; f++) {
+		for (s = 0; s < 3; s++) {
+			plen = strlen(uri_prefixes[f][s]);
+			if (uri_len >= plen && memcmp(uri, uri_prefixes[f][s], plen) == 0)
+				goto found;
+		}
+	}
+	return GS1_EPC_INVALID_URI;
+
+found:
+
+	p = uri + plen;
+	end = uri + uri_len;
+
+	if (f == GS1_EPC_URI_TAG) {
+		if (end - p < 2 || p[0] < '0' || p[0] > '7' || p[1] != '.')
+			return GS1_EPC_INVALID_URI;
+		fv = (unsigned int)(p[0] - '0');
+		p += 2;
+	}
+
+	switch (s) {
+	case GS1_EPC_SGTIN_96:
+		partitions = sgtin_partitions;
+		break;
+	case GS1_EPC_SSCC_96:
+		partitions = sscc_partitions;
+		break;
+	case GS1_EPC_SGLN_96:
+		partitions = sgln_partitions;
+		break;
+	}
+	assert(partitions);
+
+	/*
+	 * The length of the GCP component selects the partition, which
+	 * determines the length of the reference component.
+	 *
+	 */
+	gcp = p;
+	gcp_len = digit_run(p, (size_t)(end - p));
+	for (i = 0; i < NUM_PARTITIONS; i++)
+		if (partitions[i].gcp_digits == gcp_len)
+			part = &partitions[i];
+	if (!part)
+		return GS1_EPC_INVALID_URI;
+	p += gcp_len;
+	if (p == end || *p++ != '.')
+		return GS1_EPC_INVALID_URI;
+
+	ref = p;
+	ref_len = digit_run(p, (size_t)(end - p));
+	if (ref_len != part->ref_digits)
+		return GS1_EPC_INVALID_URI;
+	p += ref_len;
+
+	switch (s) {
+	case GS1_EPC_SGTIN_96:
+		q = put_ai(q, "01", &ais[0]);
+		q[0] = ref[0];
+		memcpy(q + 1, gcp, gcp_len);
+		memcpy(q + 1 + gcp_len, ref + 1, ref_len - 1);
+		q[13] = check_digit(q, 13);
+		ais[0].value_len = 14;
+		break;
+	case GS1_EPC_SSCC_96:
+		q = put_ai(q, "00", &ais[0]);
+		q[0] = ref[0];
+		memcpy(q + 1, gcp, gcp_len);
+		memcpy(q + 1 + gcp_len, ref + 1, ref_len - 1);
+		q[17] = check_digit(q, 17);
+		ais[0].value_len = 18;
+		break;
+	case GS1_EPC_SGLN_96:
+		q = put_ai(q, "414", &ais[0]);
+		memcpy(q, gcp, gcp_len);
+		memcpy(q + gcp_len, ref, ref_len);
+		q[12] = check_digit(q, 12);
+		ais[0].value_len = 13;
+		break;
+	}
+	q += ais[0].value_len;
+	*count = 1;
+
+	if (s == GS1_EPC_SSCC_96) {
+		if (p != end)
+			return GS1_EPC_INVALID_URI;
+		goto out;
+	}
+
+	if (p == end || *p++ != '.')
+		return GS1_EPC_INVALID_URI;
+
+	/*
+	 * A GLN extension of "0" indicates that there is no (254).
+	 *
+	 */
+	if (s == GS1_EPC_SGLN_96 && end - p == 1 && *p == '0')
+		goto out;
+
+	q = put_ai(q, s == GS1_EPC_SGTIN_96 ? "21" : "254", &ais[1]);
+	if (f == GS1_EPC_URI_TAG) {
+		if (!serial_value(p, (size_t)(end - p), s == GS1_EPC_SGTIN_96 ? EPC96_SGTIN_SERIAL_BITS : EPC96_SGLN_EXT_BITS, &v))
+			return GS1_EPC_INVALID_SERIAL;
+		memcpy(q, p, (size_t)(end - p));
+		ais[1].value_len = (size_t)(end - p);
+	} else if ((ret = get_unescaped(p, (size_t)(end - p), q, &ais[1].value_len)) != GS1_EPC_OK)
+		return ret;
+	*count = 2;
+
+out:
+
+	if (scheme) *scheme = (gs1_epc_scheme_t)s;
+	if (form) *form = (gs1_epc_uri_form_t)f;
+	if (filter) *filter = fv;
+
+	return GS1_EPC_OK;
+
+}
+
+
+/**
+ * Convert a batch of messages to EPC URIs.
+ *
+ * The AIs of message i are ais[offsets[i]] to ais[offsets[i+1] - 1], so
+ * offsets has count + 1 entries. The URIs are written end-to-end into out,
+ * without null terminators, with URI i occupying out[out_offsets[i]] to
+ * out[out_offsets[i+1] - 1], so out_offsets also has count + 1 entries. The
+ * return code for message i is written to codes[i] and a message that cannot
+ * be converted yields an empty URI.
+ *
+ * An out buffer of count * (#GS1_EPC_URI_BUF_LEN - 1) bytes is always
+ * sufficient. Otherwise, messages whose URIs do not fit are given the code
+ * #GS1_EPC_BUFFER_TOO_SMALL. Since out_offsets are 32-bit, no more than
+ * UINT32_MAX bytes of out are used.
+ *
+ * @return the number of messages that could not be converted.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_epc_to_uri_batch(const gs1_epc_scheme_t scheme, const gs1_epc_uri_form_t form, const unsigned int filter,
+						      const gs1_ai_view_t* const ais, const uint32_t* const offsets, const size_t count,
+						      const gs1_gcp_length_resolver_t resolver, void* const ctx,
+						      char* const out, const size_t out_len, uint32_t* const out_offsets, int32_t* const codes)
+{
+
+	char tmp[GS1_EPC_URI_BUF_LEN];
+	const size_t avail = out_len < UINT32_MAX ? out_len : UINT32_MAX;
+	size_t i, pos = 0, len, fails = 0;
+	gs1_epc_err_t ret;
+	int direct;
+
+	assert(offsets);
+	assert(out || out_len == 0);
+	assert(out_offsets);
+	assert(codes || count == 0);
+
+	out_offsets[0] = 0;
+
+	for (i = 0; i < count; i++) {
+
+		/*
+		 * Only stage the URI when it might not fit in what remains.
+		 *
+		 */
+		direct = avail - pos >= GS1_EPC_URI_BUF_LEN - 1;
+		ret = ais_to_uri(scheme, form, filter, &ais[offsets[i]], offsets[i+1] - offsets[i], resolver, ctx,
+				 direct ? &out[pos] : tmp, &len);
+
+		if (ret == GS1_EPC_OK && !direct) {
+			if (len > avail - pos)
+				ret = GS1_EPC_BUFFER_TOO_SMALL;
+			else
+				memcpy(&out[pos], tmp, len);
+		}
+
+		if (ret == GS1_EPC_OK)
+			pos += len;
+		else
+			fails++;
+
+		codes[i] = (int32_t)ret;
+		out_offsets[i+1] = (uint32_t)pos;
+
+	}
+
+	return fails;
+
+}
+
+
+/**
+ * Convert a batch of EPC URIs to AI data.
+ *
+ * URI i occupies uris[offsets[i]] to uris[offsets[i+1] - 1], so offsets has
+ * count + 1 entries. Its AI data is written to buf starting at
+ * buf[i * #GS1_EPC_URI_DECODE_BUF_LEN], with views of the AIs written to
+ * ais[2*i] and ais[2*i + 1], their number to ai_counts[i] and the return code
+ * to codes[i].
+ *
+ * @return the number of URIs that could not be converted.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_epc_from_uri_batch(const char* const uris, const uint32_t* const offsets, const size_t count,
+							char* const buf, gs1_ai_view_t* const ais, size_t* const ai_counts, int32_t* const codes)
+{
+
+	size_t i, fails = 0;
+
+	assert(uris || count == 0);
+	assert(offsets);
+	assert(buf || count == 0);
+	assert(ais || count == 0);
+	assert(ai_counts || count == 0);
+	assert(codes || count == 0);
+
+	for (i = 0; i < count; i++) {
+		const gs1_epc_err_t ret = gs1_epc_from_uri(&uris[offsets[i]], offsets[i+1] - offsets[i], NULL, NULL, NULL,
+							   &buf[i * GS1_EPC_URI_DECODE_BUF_LEN], GS1_EPC_URI_DECODE_BUF_LEN,
+							   &ais[2 * i], &ai_counts[i]);
+		codes[i] = (int32_t)ret;
+		if (ret != GS1_EPC_OK) {
+			ai_counts[i] = 0;
+			fails++;
+		}
+	}
+
+	return fails;
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#include "unittest.h"
+
+
+/*
+ * Test resolver: GCPs are the given prefixes.
+ *
+ */
+static size_t test_resolver(void *ctx, const char *key, size_t key_len)
+{
+	const char* const *gcp;
+	for (gcp = (const char* const *)ctx; *gcp; gcp++)
+		if (strlen(*gcp) <= key_len && memcmp(*gcp, key, strlen(*gcp)) == 0)
+			return strlen(*gcp);
+	return 0;
+}
+
+static const char* const test_gcps[] = {
+	"0614141", "952123", "95212345", "952999999999", "9521111111", "95200000000", NULL
+};
+
+static void to_hex(const uint8_t *epc, char *hex)
+{
+	static const char digits[] = "0123456789ABCDEF";
+	int i;
+	for (i = 0; i < 12; i++) {
+		hex[2*i] = digits[epc[i] >> 4];
+		hex[2*i + 1] = digits[epc[i] & 15];
+	}
+	hex[24] = '\0';
+}
+
+static int round_trips(gs1_epc_scheme_t scheme, const gs1_ai_view_t *ais, size_t count)
+{
+
+	uint8_t epc[12];
+	char buf[GS1_EPC96_DECODE_BUF_LEN];
+	gs1_ai_view_t out[2];
+	gs1_epc_scheme_t s;
+	unsigned int filter;
+	size_t n, i;
+
+	if (gs1_epc_encode96(scheme, ais, count, 5, test_resolver, (void *)test_gcps, epc) != GS1_EPC_OK)
+		return 0;
+	if (gs1_epc_decode96(epc, &s, &filter, buf, sizeof(buf), out, &n) != GS1_EPC_OK)
+		return 0;
+	if (s != scheme || filter != 5 || n != count)
+		return 0;
+	for (i = 0; i < n; i++)
+		if (out[i].ai_len != ais[i].ai_len || memcmp(out[i].ai, ais[i].ai, out[i].ai_len) != 0 ||
+		    out[i].value_len != ais[i].value_len || memcmp(out[i].value, ais[i].value, out[i].value_len) != 0)
+			return 0;
+	return 1;
+
+}
+
+
+void test_epc_encode96(void)
+{
+
+	gs1_ai_view_t ais[3];
+	uint8_t epc[12];
+	char hex[25];
+
+	/*
+	 * Examples from the EPC Tag Data Standard.
+	 *
+	 */
+	set_ai(&ais[0], "01", "80614141123458");
+	set_ai(&ais[1], "21", "6789");
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, ais, 2, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_OK);
+	to_hex(epc, hex);
+	TEST_CHECK(strcmp(hex, "3074257BF7194E4000001A85") == 0);
+	TEST_MSG("Got %s", hex);
+
+	set_ai(&ais[0], "00", "106141412345678908");
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SSCC_96, ais, 1, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_OK);
+	to_hex(epc, hex);
+	TEST_CHECK(strcmp(hex, "3174257BF4499602D2000000") == 0);
+	TEST_MSG("Got %s", hex);
+
+	set_ai(&ais[0], "414", "0614141123452");
+	set_ai(&ais[1], "254", "5678");
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGLN_96, ais, 2, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_OK);
+	to_hex(epc, hex);
+	TEST_CHECK(strcmp(hex, "3274257BF46072000000162E") == 0);
+	TEST_MSG("Got %s", hex);
+
+	/*
+	 * Other AIs are ignored, irrespective of order.
+	 *
+	 */
+	set_ai(&ais[0], "10", "ABC");
+	set_ai(&ais[1], "21", "6789");
+	set_ai(&ais[2], "01", "80614141123458");
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, ais, 3, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_OK);
+	to_hex(epc, hex);
+	TEST_CHECK(strcmp(hex, "3074257BF7194E4000001A85") == 0);
+
+	/*
+	 * Failures.
+	 *
+	 */
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, ais, 2, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_MISSING_AI);
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, &ais[1], 2, 8, test_resolver, (void *)test_gcps, epc) == GS1_EPC_INVALID_FILTER);
+
+	set_ai(&ais[2], "01", "80614141123459");
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, &ais[1], 2, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_INVALID_KEY);
+	set_ai(&ais[2], "01", "8061414112345");
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, &ais[1], 2, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_INVALID_KEY);
+
+	set_ai(&ais[2], "01", "80614141123458");
+	set_ai(&ais[1], "21", "06789");
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, &ais[1], 2, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_INVALID_SERIAL);
+	set_ai(&ais[1], "21", "ABC");
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, &ais[1], 2, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_INVALID_SERIAL);
+	set_ai(&ais[1], "21", "274877906944");		/* 2^38 */
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, &ais[1], 2, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_INVALID_SERIAL);
+	set_ai(&ais[1], "21", "274877906943");
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, &ais[1], 2, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_OK);
+
+	set_ai(&ais[2], "01", "18888888888885");
+	TEST_CHECK(gs1_epc_encode96(GS1_EPC_SGTIN_96, &ais[1], 2, 3, test_resolver, (void *)test_gcps, epc) == GS1_EPC_UNKNOWN_GCP);
+
+}
+
+
+void test_epc_decode96(void)
+{
+
+	static const char* const gtins[] = {
+		"09521234543213", "19521234500008", "99521234500004", "09529999999993",
+		"09521111111115", "09520000000004", "80614141123458",
+	};
+	static const char* const ssccs[] = {
+		"095212345678901235", "395212300000000001", "095299999999999991", "106141412345678908",
+	};
+	static const char* const glns[] = {
+		"9521234543213", "9529999999993", "9521111111115", "0614141123452",
+	};
+	static const uint8_t bad_header[12] = { 0x33 };
+	static const uint8_t bad_partition[12] = { 0x30, 0x1C };
+
+	gs1_ai_view_t ais[2];
+	char buf[GS1_EPC96_DECODE_BUF_LEN];
+	size_t i, n;
+
+	for (i = 0; i < sizeof(gtins) / sizeof(gtins[0]); i++) {
+		set_ai(&ais[0], "01", gtins[i]);
+		set_ai(&ais[1], "21", "0");
+		TEST_CHECK(round_trips(GS1_EPC_SGTIN_96, ais, 2));
+		set_ai(&ais[1], "21", "274877906943");
+		TEST_CHECK(round_trips(GS1_EPC_SGTIN_96, ais, 2));
+		TEST_MSG("For %s", gtins[i]);
+	}
+
+	for (i = 0; i < sizeof(ssccs) / sizeof(ssccs[0]); i++) {
+		set_ai(&ais[0], "00", ssccs[i]);
+		TEST_CHECK(round_trips(GS1_EPC_SSCC_96, ais, 1));
+		TEST_MSG("For %s", ssccs[i]);
+	}
+
+	for (i = 0; i < sizeof(glns) / sizeof(glns[0]); i++) {
+		set_ai(&ais[0], "414", glns[i]);
+		TEST_CHECK(round_trips(GS1_EPC_SGLN_96, ais, 1));
+		set_ai(&ais[1], "254", "2199023255551");	/* 2^41 - 1 */
+		TEST_CHECK(round_trips(GS1_EPC_SGLN_96, ais, 2));
+		TEST_MSG("For %s", glns[i]);
+	}
+
+	TEST_CHECK(gs1_epc_decode96(bad_header, NULL, NULL, buf, sizeof(buf), ais, &n) == GS1_EPC_INVALID_HEADER);
+	TEST_CHECK(gs1_epc_decode96(bad_partition, NULL, NULL, buf, sizeof(buf), ais, &n) == GS1_EPC_INVALID_PARTITION);
+	TEST_CHECK(gs1_epc_decode96(bad_header, NULL, NULL, buf, sizeof(buf) - 1, ais, &n) == GS1_EPC_BUFFER_TOO_SMALL);
+
+}
+
+
+void test_epc_batch(void)
+{
+
+	gs1_ai_view_t ais[5], out[6];
+	static const uint32_t offsets[] = { 0, 2, 3, 5 };
+	uint8_t epcs[36];
+	int32_t codes[3];
+	char buf[3 * GS1_EPC96_DECODE_BUF_LEN];
+	size_t counts[3];
+
+	set_ai(&ais[0], "01", "09521234543213");
+	set_ai(&ais[1], "21", "12345");
+	set_ai(&ais[2], "01", "09521234543213");
+	set_ai(&ais[3], "01", "80614141123458");
+	set_ai(&ais[4], "21", "6789");
+
+	TEST_CHECK(gs1_epc_encode96_batch(GS1_EPC_SGTIN_96, ais, offsets, 3, 3, test_resolver, (void *)test_gcps, epcs, codes) == 1);
+	TEST_CHECK(codes[0] == GS1_EPC_OK);
+	TEST_CHECK(codes[1] == GS1_EPC_MISSING_AI);
+	TEST_CHECK(codes[2] == GS1_EPC_OK);
+
+	epcs[12] = 0x00;	/* Invalid header */
+	TEST_CHECK(gs1_epc_decode96_batch(epcs, 3, buf, out, counts, codes) == 1);
+	TEST_CHECK(codes[0] == GS1_EPC_OK && counts[0] == 2);
+	TEST_CHECK(codes[1] == GS1_EPC_INVALID_HEADER && counts[1] == 0);
+	TEST_CHECK(codes[2] == GS1_EPC_OK && counts[2] == 2);
+	TEST_CHECK(out[0].value_len == 14 && memcmp(out[0].value, "09521234543213", 14) == 0);
+	TEST_CHECK(out[1].value_len == 5 && memcmp(out[1].value, "12345", 5) == 0);
+	TEST_CHECK(out[4].value_len == 14 && memcmp(out[4].value, "80614141123458", 14) == 0);
+	TEST_CHECK(out[5].value_len == 4 && memcmp(out[5].value, "6789", 4) == 0);
+
+}
+
+static int uri_is(gs1_epc_scheme_t scheme, gs1_epc_uri_form_t form, const gs1_ai_view_t *ais, size_t count, const char *expect)
+{
+
+	char uri[GS1_EPC_URI_BUF_LEN];
+	size_t len;
+
+	if (gs1_epc_to_uri(scheme, form, 3, ais, count, test_resolver, (void *)test_gcps, uri, sizeof(uri), &len) != GS1_EPC_OK)
+		return 0;
+	TEST_MSG("Got %s", uri);
+	return len == strlen(expect) && strcmp(uri, expect) == 0;
+
+}
+
+static int uri_round_trips(const char *uri)
+{
+
+	gs1_ai_view_t ais[2];
+	char buf[GS1_EPC_URI_DECODE_BUF_LEN], out[GS1_EPC_URI_BUF_LEN];
+	gs1_epc_scheme_t scheme;
+	gs1_epc_uri_form_t form;
+	unsigned int filter;
+	size_t n;
+
+	if (gs1_epc_from_uri(uri, strlen(uri), &scheme, &form, &filter, buf, sizeof(buf), ais, &n) != GS1_EPC_OK)
+		return 0;
+	if (gs1_epc_to_uri(scheme, form, filter, ais, n, test_resolver, (void *)test_gcps, out, sizeof(out), NULL) != GS1_EPC_OK)
+		return 0;
+	TEST_MSG("Got %s", out);
+	return strcmp(uri, out) == 0;
+
+}
+
+
+void test_epc_to_uri(void)
+{
+
+	gs1_ai_view_t ais[3];
+	char uri[GS1_EPC_URI_BUF_LEN];
+	size_t len;
+
+	/*
+	 * Examples from the EPC Tag Data Standard.
+	 *
+	 */
+	set_ai(&ais[0], "01", "80614141123458");
+	set_ai(&ais[1], "21", "6789");
+	TEST_CHECK(uri_is(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, ais, 2, "urn:epc:id:sgtin:0614141.812345.6789"));
+	TEST_CHECK(uri_is(GS1_EPC_SGTIN_96, GS1_EPC_URI_TAG, ais, 2, "urn:epc:tag:sgtin-96:3.0614141.812345.6789"));
+
+	set_ai(&ais[0], "00", "106141412345678908");
+	TEST_CHECK(uri_is(GS1_EPC_SSCC_96, GS1_EPC_URI_ID, ais, 1, "urn:epc:id:sscc:0614141.1234567890"));
+	TEST_CHECK(uri_is(GS1_EPC_SSCC_96, GS1_EPC_URI_TAG, ais, 1, "urn:epc:tag:sscc-96:3.0614141.1234567890"));
+
+	set_ai(&ais[0], "414", "0614141123452");
+	set_ai(&ais[1], "254", "5678");
+	TEST_CHECK(uri_is(GS1_EPC_SGLN_96, GS1_EPC_URI_ID, ais, 2, "urn:epc:id:sgln:0614141.12345.5678"));
+	TEST_CHECK(uri_is(GS1_EPC_SGLN_96, GS1_EPC_URI_TAG, ais, 2, "urn:epc:tag:sgln-96:3.0614141.12345.5678"));
+	TEST_CHECK(uri_is(GS1_EPC_SGLN_96, GS1_EPC_URI_ID, ais, 1, "urn:epc:id:sgln:0614141.12345.0"));
+
+	/*
+	 * GCP lengths at the extremes of the partition table.
+	 *
+	 */
+	set_ai(&ais[0], "414", "9529999999993");
+	TEST_CHECK(uri_is(GS1_EPC_SGLN_96, GS1_EPC_URI_ID, ais, 1, "urn:epc:id:sgln:952999999999..0"));
+	set_ai(&ais[0], "01", "19521234500008");
+	set_ai(&ais[1], "21", "0");
+	TEST_CHECK(uri_is(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, ais, 2, "urn:epc:id:sgtin:952123.1450000.0"));
+
+	/*
+	 * Serials of pure identity URIs are escaped; tag URIs are restricted
+	 * to what can be encoded as binary.
+	 *
+	 */
+	set_ai(&ais[0], "01", "80614141123458");
+	set_ai(&ais[1], "21", "A/b%\"&<>?'!z");
+	TEST_CHECK(uri_is(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, ais, 2, "urn:epc:id:sgtin:0614141.812345.A%2Fb%25%22%26%3C%3E%3F'!z"));
+	TEST_CHECK(gs1_epc_to_uri(GS1_EPC_SGTIN_96, GS1_EPC_URI_TAG, 3, ais, 2, test_resolver, (void *)test_gcps, uri, sizeof(uri), &len) == GS1_EPC_INVALID_SERIAL);
+	set_ai(&ais[1], "21", "//////////////////////");
+	TEST_CHECK(gs1_epc_to_uri(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, 3, ais, 2, test_resolver, (void *)test_gcps, uri, sizeof(uri), &len) == GS1_EPC_INVALID_SERIAL);
+	set_ai(&ais[1], "21", "////////////////////");
+	TEST_CHECK(gs1_epc_to_uri(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, 3, ais, 2, test_resolver, (void *)test_gcps, uri, sizeof(uri), &len) == GS1_EPC_OK);
+	TEST_CHECK(len == 92);
+	set_ai(&ais[1], "21", "A#B");
+	TEST_CHECK(gs1_epc_to_uri(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, 3, ais, 2, test_resolver, (void *)test_gcps, uri, sizeof(uri), &len) == GS1_EPC_INVALID_SERIAL);
+
+	/*
+	 * Failures.
+	 *
+	 */
+	set_ai(&ais[1], "21", "6789");
+	TEST_CHECK(gs1_epc_to_uri(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, 3, ais, 1, test_resolver, (void *)test_gcps, uri, sizeof(uri), &len) == GS1_EPC_MISSING_AI);
+	TEST_CHECK(gs1_epc_to_uri(GS1_EPC_SGTIN_96, GS1_EPC_URI_TAG, 8, ais, 2, test_resolver, (void *)test_gcps, uri, sizeof(uri), &len) == GS1_EPC_INVALID_FILTER);
+	TEST_CHECK(gs1_epc_to_uri(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, 3, ais, 2, test_resolver, (void *)test_gcps, uri, 36, &len) == GS1_EPC_BUFFER_TOO_SMALL);
+	TEST_CHECK(gs1_epc_to_uri(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, 3, ais, 2, test_resolver, (void *)test_gcps, uri, 37, &len) == GS1_EPC_OK);
+	TEST_CHECK(strcmp(uri, "urn:epc:id:sgtin:0614141.812345.6789") == 0);
+	set_ai(&ais[0], "01", "18888888888885");
+	TEST_CHECK(gs1_epc_to_uri(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, 3, ais, 2, test_resolver, (void *)test_gcps, uri, sizeof(uri), &len) == GS1_EPC_UNKNOWN_GCP);
+	set_ai(&ais[0], "01", "80614141123459");
+	TEST_CHECK(gs1_epc_to_uri(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, 3, ais, 2, test_resolver, (void *)test_gcps, uri, sizeof(uri), &len) == GS1_EPC_INVALID_KEY);
+
+}
+
+
+void test_epc_from_uri(void)
+{
+
+	gs1_ai_view_t ais[2];
+	char buf[GS1_EPC_URI_DECODE_BUF_LEN];
+	gs1_epc_scheme_t scheme;
+	gs1_epc_uri_form_t form;
+	unsigned int filter;
+	size_t n;
+
+#define FROM_URI(u) gs1_epc_from_uri(u, strlen(u), &scheme, &form, &filter, buf, sizeof(buf), ais, &n)
+
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.812345.6789") == GS1_EPC_OK);
+	TEST_CHECK(scheme == GS1_EPC_SGTIN_96 && form == GS1_EPC_URI_ID && filter == 0 && n == 2);
+	TEST_CHECK(ais[0].ai_len == 2 && memcmp(ais[0].ai, "01", 2) == 0);
+	TEST_CHECK(ais[0].value_len == 14 && memcmp(ais[0].value, "80614141123458", 14) == 0);
+	TEST_CHECK(ais[1].ai_len == 2 && memcmp(ais[1].ai, "21", 2) == 0);
+	TEST_CHECK(ais[1].value_len == 4 && memcmp(ais[1].value, "6789", 4) == 0);
+
+	TEST_CHECK(FROM_URI("urn:epc:tag:sscc-96:5.0614141.1234567890") == GS1_EPC_OK);
+	TEST_CHECK(scheme == GS1_EPC_SSCC_96 && form == GS1_EPC_URI_TAG && filter == 5 && n == 1);
+	TEST_CHECK(ais[0].value_len == 18 && memcmp(ais[0].value, "106141412345678908", 18) == 0);
+
+	TEST_CHECK(FROM_URI("urn:epc:id:sgln:0614141.12345.0") == GS1_EPC_OK);
+	TEST_CHECK(scheme == GS1_EPC_SGLN_96 && n == 1);
+	TEST_CHECK(ais[0].ai_len == 3 && memcmp(ais[0].ai, "414", 3) == 0);
+	TEST_CHECK(ais[0].value_len == 13 && memcmp(ais[0].value, "0614141123452", 13) == 0);
+
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.812345.A%2fb%25%22") == GS1_EPC_OK);
+	TEST_CHECK(ais[1].value_len == 5 && memcmp(ais[1].value, "A/b%\"", 5) == 0);
+
+	TEST_CHECK(uri_round_trips("urn:epc:id:sgtin:0614141.812345.6789"));
+	TEST_CHECK(uri_round_trips("urn:epc:id:sgtin:0614141.812345.A%2Fb%25%22%26%3C%3E%3F'!z"));
+	TEST_CHECK(uri_round_trips("urn:epc:tag:sgtin-96:0.952123.1450000.274877906943"));
+	TEST_CHECK(uri_round_trips("urn:epc:id:sscc:952999999999.09999"));
+	TEST_CHECK(uri_round_trips("urn:epc:id:sgln:952999999999..ABC"));
+	TEST_CHECK(uri_round_trips("urn:epc:tag:sgln-96:7.0614141.12345.2199023255551"));
+
+	/*
+	 * Failures.
+	 *
+	 */
+	TEST_CHECK(FROM_URI("") == GS1_EPC_INVALID_URI);
+	TEST_CHECK(FROM_URI("urn:epc:id:giai:0614141.12345") == GS1_EPC_INVALID_URI);
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.812345") == GS1_EPC_INVALID_URI);
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.812345.") == GS1_EPC_INVALID_SERIAL);
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.81234.6789") == GS1_EPC_INVALID_URI);
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:06141.8123456.6789") == GS1_EPC_INVALID_URI);
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.812345.67/89") == GS1_EPC_INVALID_URI);
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.812345.67%2") == GS1_EPC_INVALID_URI);
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.812345.67%G0") == GS1_EPC_INVALID_URI);
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.812345.67%00") == GS1_EPC_INVALID_SERIAL);
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.812345.67#") == GS1_EPC_INVALID_SERIAL);
+	TEST_CHECK(FROM_URI("urn:epc:id:sgtin:0614141.812345.123456789012345678901") == GS1_EPC_INVALID_SERIAL);
+	TEST_CHECK(FROM_URI("urn:epc:id:sscc:0614141.1234567890.1") == GS1_EPC_INVALID_URI);
+	TEST_CHECK(FROM_URI("urn:epc:tag:sgtin-96:8.0614141.812345.6789") == GS1_EPC_INVALID_URI);
+	TEST_CHECK(FROM_URI("urn:epc:tag:sgtin-96:3.0614141.812345.06789") == GS1_EPC_INVALID_SERIAL);
+	TEST_CHECK(FROM_URI("urn:epc:tag:sgtin-96:3.0614141.812345.274877906944") == GS1_EPC_INVALID_SERIAL);
+	TEST_CHECK(gs1_epc_from_uri("urn:epc:id:sscc:0614141.1234567890", 34, NULL, NULL, NULL, buf, sizeof(buf) - 1, ais, &n) == GS1_EPC_BUFFER_TOO_SMALL);
+
+#undef FROM_URI
+
+}
+
+
+void test_epc_uri_batch(void)
+{
+
+	gs1_ai_view_t ais[5], out[6];
+	static const uint32_t offsets[] = { 0, 2, 3, 5 };
+	char uris[3 * (GS1_EPC_URI_BUF_LEN - 1)];
+	uint32_t uri_offsets[4];
+	int32_t codes[3];
+	char buf[3 * GS1_EPC_URI_DECODE_BUF_LEN];
+	size_t counts[3];
+
+	set_ai(&ais[0], "01", "09521234543213");
+	set_ai(&ais[1], "21", "A/1");
+	set_ai(&ais[2], "01", "09521234543213");
+	set_ai(&ais[3], "01", "80614141123458");
+	set_ai(&ais[4], "21", "6789");
+
+	TEST_CHECK(gs1_epc_to_uri_batch(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, 0, ais, offsets, 3, test_resolver, (void *)test_gcps,
+					uris, sizeof(uris), uri_offsets, codes) == 1);
+	TEST_CHECK(codes[0] == GS1_EPC_OK && codes[1] == GS1_EPC_MISSING_AI && codes[2] == GS1_EPC_OK);
+	TEST_CHECK(uri_offsets[0] == 0 && uri_offsets[1] == 37 && uri_offsets[2] == 37 && uri_offsets[3] == 73);
+	TEST_CHECK(memcmp(uris, "urn:epc:id:sgtin:952123.0454321.A%2F1urn:epc:id:sgtin:0614141.812345.6789", 73) == 0);
+
+	TEST_CHECK(gs1_epc_from_uri_batch(uris, uri_offsets, 3, buf, out, counts, codes) == 1);
+	TEST_CHECK(codes[0] == GS1_EPC_OK && counts[0] == 2);
+	TEST_CHECK(codes[1] == GS1_EPC_INVALID_URI && counts[1] == 0);
+	TEST_CHECK(codes[2] == GS1_EPC_OK && counts[2] == 2);
+	TEST_CHECK(out[0].value_len == 14 && memcmp(out[0].value, "09521234543213", 14) == 0);
+	TEST_CHECK(out[1].value_len == 3 && memcmp(out[1].value, "A/1", 3) == 0);
+	TEST_CHECK(out[4].value_len == 14 && memcmp(out[4].value, "80614141123458", 14) == 0);
+	TEST_CHECK(out[5].value_len == 4 && memcmp(out[5].value, "6789", 4) == 0);
+
+	/*
+	 * URIs that do not fit are reported and leave the buffer intact.
+	 *
+	 */
+	TEST_CHECK(gs1_epc_to_uri_batch(GS1_EPC_SGTIN_96, GS1_EPC_URI_ID, 0, ais, offsets, 3, test_resolver, (void *)test_gcps,
+					uris, 40, uri_offsets, codes) == 2);
+	TEST_CHECK(codes[0] == GS1_EPC_OK && codes[2] == GS1_EPC_BUFFER_TOO_SMALL);
+	TEST_CHECK(uri_offsets[3] == 37);
+
+}
+
+#endif  /* UNIT_TESTS */
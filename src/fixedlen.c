@@ -0,0 +1,459 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Length-specialised kernels for linters that are applied to fixed-length
+ * components: csum for N13 (GLN), N14 (GTIN) and N18 (SSCC), and yymmd0 and
+ * yymmdd for N6 dates.
+ *
+ * Each kernel is a drop-in replacement for the generic linter. The common
+ * case, in which the data has the expected length and is valid, is accepted
+ * using a few whole-word loads with the digits processed eight at a time
+ * within a 64-bit integer ("SIMD within a register"), without per-character
+ * loop control. Anything else is passed to the generic linter so that the
+ * return code and error position are always identical to it.
+ *
+ */
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+
+
+#define ONES UINT64_C(0x0101010101010101)
+
+
+/*
+ * Little-endian load of eight characters, which compilers reduce to a single
+ * (unaligned) load on common platforms.
+ *
+ */
+static uint64_t load64(const char* const data)
+{
+	const unsigned char* const p = (const unsigned char*)data;
+
+	return (uint64_t)p[0]       | (uint64_t)p[1] <<  8 |
+	       (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24 |
+	       (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 |
+	       (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+
+/*
+ * All eight bytes are "0" to "9". If every high nibble is 3 then adding 6 to
+ * each byte cannot carry between bytes, and leaves the high nibble as 3 only
+ * for "0" to "9".
+ *
+ */
+static int all_digits(const uint64_t x)
+{
+	return (x & (ONES * 0xF0)) == ONES * 0x30 &&
+	       ((x + ONES * 0x06) & (ONES * 0xF0)) == ONES * 0x30;
+}
+
+
+/*
+ * Sum of the bytes, each of which is at most 9.
+ *
+ */
+static unsigned int sum_bytes(const uint64_t x)
+{
+	return (unsigned int)((x * ONES) >> 56);
+}
+
+
+/*
+ * Data is exactly len digits. memchr() stops at the first match so never
+ * reads beyond the terminating null.
+ *
+ */
+static int has_len(const char* const data, const size_t len)
+{
+	return memchr(data, '\0', len + 1) == data + len;
+}
+
+
+/*
+ * Data is exactly len (at least 8) digits with a correct check digit.
+ *
+ * The digits are processed in words of eight, with the final word loaded
+ * such that it ends with the check digit and then shifted to discard any
+ * overlap with the previous word. Digits are weighted 3 when their position
+ * has the same parity as len, i.e. alternately ...3:1:3:1 ending with the
+ * check digit weighted 1, so the weighted sum must be a multiple of 10.
+ *
+ */
+static int csum_ok(const char* const data, const size_t len)
+{
+
+	const uint64_t mask3 = len % 2 == 0 ? UINT64_C(0x00FF00FF00FF00FF) : UINT64_C(0xFF00FF00FF00FF00);
+	unsigned int sum3 = 0, sum1 = 0;
+	size_t i;
+
+	assert(len >= 8);
+
+	if (!has_len(data, len))
+		return 0;
+
+	for (i = 0; i < len; i += 8) {
+
+		uint64_t x;
+		unsigned int shift = 0;
+
+		if (i + 8 <= len)
+			x = load64(&data[i]);
+		else {
+			x = load64(&data[len - 8]);
+			shift = (unsigned int)(8 * (i + 8 - len));
+		}
+
+		if (!all_digits(x))
+			return 0;
+
+		x = (x - ONES * '0') >> shift;
+		sum3 += sum_bytes(x & mask3);
+		sum1 += sum_bytes(x & ~mask3);
+
+	}
+
+	return (3 * sum3 + sum1) % 10 == 0;
+
+}
+
+
+/*
+ * Data is exactly six digits of the form YYMMDD or YYMM00 with a month from
+ * 01 to 12 and a day that is valid in any year. The 29th of February is left
+ * to the generic linter since it depends on the century.
+ *
+ */
+static int yymmd0_ok(const char* const data)
+{
+
+	static const unsigned char maxdd[] =
+		{ 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+	uint64_t x;
+	unsigned int mm, dd;
+
+	if (!has_len(data, 6))
+		return 0;
+
+	/*
+	 * Pad the six characters to a full word with "0" characters.
+	 *
+	 */
+	x = (uint64_t)(unsigned char)data[0]       | (uint64_t)(unsigned char)data[1] <<  8 |
+	    (uint64_t)(unsigned char)data[2] << 16 | (uint64_t)(unsigned char)data[3] << 24 |
+	    (uint64_t)(unsigned char)data[4] << 32 | (uint64_t)(unsigned char)data[5] << 40 |
+	    (ONES * '0' & UINT64_C(0xFFFF000000000000));
+
+	if (!all_digits(x))
+		return 0;
+
+	x -= ONES * '0';
+	mm = (unsigned int)((x >> 16) & 0xFF) * 10 + (unsigned int)((x >> 24) & 0xFF);
+	dd = (unsigned int)((x >> 32) & 0xFF) * 10 + (unsigned int)((x >> 40) & 0xFF);
+
+	return mm >= 1 && mm <= 12 && dd <= maxdd[mm - 1];
+
+}
+
+
+/**
+ * Equivalent to gs1_lint_csum(), specialised for N13 components.
+ *
+ * @see gs1_lint_csum()
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_csum_13(const char* const data, size_t* const err_pos, size_t* const err_len)
+{
+	assert(data);
+	return csum_ok(data, 13) ? GS1_LINTER_OK : gs1_lint_csum(data, err_pos, err_len);
+}
+
+
+/**
+ * Equivalent to gs1_lint_csum(), specialised for N14 components.
+ *
+ * @see gs1_lint_csum()
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_csum_14(const char* const data, size_t* const err_pos, size_t* const err_len)
+{
+	assert(data);
+	return csum_ok(data, 14) ? GS1_LINTER_OK : gs1_lint_csum(data, err_pos, err_len);
+}
+
+
+/**
+ * Equivalent to gs1_lint_csum(), specialised for N18 components.
+ *
+ * @see gs1_lint_csum()
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_csum_18(const char* const data, size_t* const err_pos, size_t* const err_len)
+{
+	assert(data);
+	return csum_ok(data, 18) ? GS1_LINTER_OK : gs1_lint_csum(data, err_pos, err_len);
+}
+
+
+/**
+ * Equivalent to gs1_lint_yymmd0(), specialised for N6 components.
+ *
+ * @see gs1_lint_yymmd0()
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_yymmd0_6(const char* const data, size_t* const err_pos, size_t* const err_len)
+{
+	assert(data);
+	return yymmd0_ok(data) ? GS1_LINTER_OK : gs1_lint_yymmd0(data, err_pos, err_len);
+}
+
+
+/**
+ * Equivalent to gs1_lint_yymmdd(), specialised for N6 components.
+ *
+ * @see gs1_lint_yymmdd()
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_yymmdd_6(const char* const data, size_t* const err_pos, size_t* const err_len)
+{
+	assert(data);
+	return yymmd0_ok(data) && (data[4] != '0' || data[5] != '0') ?
+		GS1_LINTER_OK : gs1_lint_yymmdd(data, err_pos, err_len);
+}
+
+
+/*
+ * Length-specialised kernels, as X(name, length) for the kernel
+ * gs1_lint_<name>_<length>.
+ *
+ */
+#define FIXEDLEN_KERNELS(X)	\
+	X(csum, 13)		\
+	X(csum, 14)		\
+	X(csum, 18)		\
+	X(yymmd0, 6)		\
+	X(yymmdd, 6)
+
+
+/*
+ * The names are offsets into a string blob and the kernels are selected by a
+ * switch so that the table needs no relocation.
+ *
+ */
+static const struct fixedlen_names_s {
+#define X(n, l) char n##_##l[sizeof(#n)];
+	FIXEDLEN_KERNELS(X)
+#undef X
+} fixedlen_names = {
+#define X(n, l) #n,
+	FIXEDLEN_KERNELS(X)
+#undef X
+};
+
+static const struct fixedlen_entry {
+	uint8_t name;
+	uint8_t len;
+} fixedlen_map[] = {
+#define X(n, l) { offsetof(struct fixedlen_names_s, n##_##l), l },
+	FIXEDLEN_KERNELS(X)
+#undef X
+};
+
+enum {
+#define X(n, l) FIXEDLEN_##n##_##l,
+	FIXEDLEN_KERNELS(X)
+#undef X
+	NUM_FIXEDLEN
+};
+
+
+static gs1_linter_t fixedlen_kernel(const size_t i)
+{
+
+	switch (i) {
+#define X(n, l) case FIXEDLEN_##n##_##l: return gs1_lint_##n##_##l;
+	FIXEDLEN_KERNELS(X)
+#undef X
+	}
+
+	return NULL;
+
+}
+
+
+/*
+ * As gs1_linter_from_name(), but returns a length-specialised kernel when one
+ * is available for a component that the Syntax Dictionary specifies to have
+ * the given fixed length, e.g. 14 for "N14,csum". len is 0 for
+ * variable-length components.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_linter_t gs1_linter_from_name_and_length(const char* const name, const size_t len)
+{
+
+	size_t i;
+
+	assert(name);
+
+	for (i = 0; len && i < NUM_FIXEDLEN; i++)
+		if (fixedlen_map[i].len == len && strcmp((const char *)&fixedlen_names + fixedlen_map[i].name, name) == 0)
+			return fixedlen_kernel(i);
+
+	return gs1_linter_from_name(name);
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+
+static int same_as_generic(const gs1_linter_t kernel, const gs1_linter_t generic, const char* const data)
+{
+
+	gs1_lint_err_t kerr, gerr;
+	size_t kpos = 0, klen = 0, gpos = 0, glen = 0;
+
+	kerr = kernel(data, &kpos, &klen);
+	gerr = generic(data, &gpos, &glen);
+
+	if (kerr != gerr || (gerr != GS1_LINTER_OK && (kpos != gpos || klen != glen))) {
+		TEST_MSG("Mismatch for \"%s\": kernel (%d, %d, %d); generic (%d, %d, %d)", data,
+			 (int)kerr, (int)kpos, (int)klen, (int)gerr, (int)gpos, (int)glen);
+		return 0;
+	}
+
+	return 1;
+
+}
+
+
+void test_fixedlen_csum(void)
+{
+
+	static const gs1_linter_t kernels[] = { gs1_lint_csum_13, gs1_lint_csum_14, gs1_lint_csum_18 };
+	static const char bad[] = "/:*A \x7f\x80\xb0\xff";
+	char buf[24];
+	size_t k, len, i, j;
+	uint32_t x = 2463534242u;
+	int ok = 1;
+
+	TEST_CHECK(gs1_lint_csum_14("09521234543213", NULL, NULL) == GS1_LINTER_OK);
+	TEST_CHECK(gs1_lint_csum_14("09521234543214", NULL, NULL) == GS1_LINTER_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(gs1_lint_csum_18("106141411234567897", NULL, NULL) == GS1_LINTER_OK);
+
+	for (k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+
+		/*
+		 * Random digits of lengths around the specialised length, with
+		 * every candidate check digit and with each position in turn
+		 * replaced by a non-digit or truncated.
+		 *
+		 */
+		for (len = 0; len <= 20; len++) {
+			for (j = 0; j < 200; j++) {
+				for (i = 0; i < len; i++) {
+					x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+					buf[i] = (char)('0' + x % 10);
+				}
+				buf[len] = '\0';
+				ok &= same_as_generic(kernels[k], gs1_lint_csum, buf);
+				if (len == 0)
+					continue;
+				for (i = 0; i < 10; i++) {
+					buf[len - 1] = (char)('0' + i);
+					ok &= same_as_generic(kernels[k], gs1_lint_csum, buf);
+				}
+				for (i = 0; i < len; i++) {
+					const char c = buf[i];
+					buf[i] = bad[(x + i) % (sizeof(bad) - 1)];
+					ok &= same_as_generic(kernels[k], gs1_lint_csum, buf);
+					buf[i] = '\0';
+					ok &= same_as_generic(kernels[k], gs1_lint_csum, buf);
+					buf[i] = c;
+				}
+			}
+		}
+
+	}
+
+	TEST_CHECK(ok);
+
+}
+
+
+void test_fixedlen_yymmd0(void)
+{
+
+	char buf[12];
+	int i, ok = 1;
+
+	/*
+	 * Every six-digit value, and each with a non-digit or truncated.
+	 *
+	 */
+	for (i = 0; i < 1000000; i++) {
+		snprintf(buf, sizeof(buf), "%06d", i);
+		ok &= same_as_generic(gs1_lint_yymmd0_6, gs1_lint_yymmd0, buf);
+		ok &= same_as_generic(gs1_lint_yymmdd_6, gs1_lint_yymmdd, buf);
+		if (i % 997 == 0) {
+			const char c = buf[i % 6];
+			buf[i % 6] = i % 2 ? ':' : '/';
+			ok &= same_as_generic(gs1_lint_yymmd0_6, gs1_lint_yymmd0, buf);
+			ok &= same_as_generic(gs1_lint_yymmdd_6, gs1_lint_yymmdd, buf);
+			buf[i % 6] = c;
+			buf[i % 7] = '\0';
+			ok &= same_as_generic(gs1_lint_yymmd0_6, gs1_lint_yymmd0, buf);
+			ok &= same_as_generic(gs1_lint_yymmdd_6, gs1_lint_yymmdd, buf);
+		}
+	}
+
+	ok &= same_as_generic(gs1_lint_yymmd0_6, gs1_lint_yymmd0, "2002291");
+	ok &= same_as_generic(gs1_lint_yymmdd_6, gs1_lint_yymmdd, "2002291");
+
+	TEST_CHECK(ok);
+
+}
+
+
+void test_fixedlen_gs1_linter_from_name_and_length(void)
+{
+
+	TEST_CHECK(gs1_linter_from_name_and_length("csum", 14) == gs1_lint_csum_14);
+	TEST_CHECK(gs1_linter_from_name_and_length("csum", 13) == gs1_lint_csum_13);
+	TEST_CHECK(gs1_linter_from_name_and_length("csum", 18) == gs1_lint_csum_18);
+	TEST_CHECK(gs1_linter_from_name_and_length("yymmd0", 6) == gs1_lint_yymmd0_6);
+	TEST_CHECK(gs1_linter_from_name_and_length("yymmdd", 6) == gs1_lint_yymmdd_6);
+
+	TEST_CHECK(gs1_linter_from_name_and_length("csum", 0) == gs1_lint_csum);
+	TEST_CHECK(gs1_linter_from_name_and_length("csum", 8) == gs1_lint_csum);
+	TEST_CHECK(gs1_linter_from_name_and_length("cset82", 14) == gs1_lint_cset82);
+	TEST_CHECK(gs1_linter_from_name_and_length("dummy", 14) == NULL);
+
+}
+
+#endif  /* UNIT_TESTS */
@@ -0,0 +1,473 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Header-only C++20 coroutine interface for linting with lookups against a
+ * remote GS1 Company Prefix (GCP) source.
+ *
+ *   gs1::task<void> check(gs1::event_loop &loop, std::string_view gtin)
+ *   {
+ *       gs1::lint_result r = co_await gs1::lint_async(loop, gs1::csum, gtin);
+ *       if (r)
+ *           r = co_await gs1::lint_async(loop, gs1::key, gtin.substr(1));
+ *       ...
+ *   }
+ *
+ *   gs1::event_loop loop(source);
+ *   for (...)
+ *       loop.spawn(check(loop, gtin));
+ *   loop.run();
+ *
+ * Linters that only need the CPU complete inline without suspending. The key
+ * linter performs its syntax checks inline and then suspends the coroutine
+ * until the GCP has been looked up. The event loop collects the outstanding
+ * lookups of all of its coroutines into batches for the gcp_source, so many
+ * messages can be in flight on a single thread, with one round trip per
+ * batch rather than per lookup.
+ *
+ * Each event_loop is driven by a single thread; run one loop per thread to
+ * use several threads, sharing a gcp_source that is safe for concurrent use.
+ *
+ * Destroying an event_loop destroys any spawned tasks that have not completed,
+ * without resuming them. Lookups that are still in flight are abandoned: their
+ * results are discarded when the gcp_source completes them.
+ *
+ * The library should be built without GS1_LINTER_CUSTOM_GCP_LOOKUP since the
+ * gcp_source takes its place; otherwise gs1_lint_key() would also perform a
+ * blocking lookup.
+ *
+ */
+
+#ifndef GS1_SYNTAXDICTIONARY_ASYNC_HPP
+#define GS1_SYNTAXDICTIONARY_ASYNC_HPP
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gs1syntaxdictionary.hpp"
+
+
+namespace gs1 {
+
+/*
+ * Outcome of looking up whether a key starts with an allocated GCP.
+ *
+ */
+enum class gcp_status {
+	valid,
+	invalid,
+	offline,
+};
+
+
+/*
+ * A source of GCP allocations, such as a client for a remote lookup service.
+ *
+ * lookup() is called on the event loop thread with a batch of keys and must
+ * not block on I/O: it starts the lookup and arranges for done to be called
+ * exactly once, from any thread, with a status for each key in order. A
+ * result of the wrong size is treated as the source being offline.
+ *
+ */
+class gcp_source {
+public:
+	using completion = std::function<void(std::vector<gcp_status>)>;
+
+	virtual ~gcp_source() = default;
+	virtual void lookup(std::vector<std::string> keys, completion done) = 0;
+};
+
+
+template<typename T>
+class task;
+
+class event_loop;
+
+
+namespace detail {
+
+struct task_promise_base {
+	std::coroutine_handle<> continuation;
+	std::exception_ptr error;
+
+	struct final_awaiter {
+		bool await_ready() const noexcept { return false; }
+
+		template<typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept
+		{
+			if (h.promise().continuation)
+				return h.promise().continuation;
+			return std::noop_coroutine();
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	std::suspend_always initial_suspend() const noexcept { return {}; }
+	final_awaiter final_suspend() const noexcept { return {}; }
+	void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template<typename T>
+struct task_promise : task_promise_base {
+	std::optional<T> value;
+
+	task<T> get_return_object() noexcept;
+	void return_value(T v) { value.emplace(std::move(v)); }
+
+	T result()
+	{
+		if (error)
+			std::rethrow_exception(error);
+		return std::move(*value);
+	}
+};
+
+template<>
+struct task_promise<void> : task_promise_base {
+	task<void> get_return_object() noexcept;
+	void return_void() const noexcept {}
+
+	void result() const
+	{
+		if (error)
+			std::rethrow_exception(error);
+	}
+};
+
+}  // namespace detail
+
+
+/*
+ * A lazily-started coroutine that produces a T when awaited.
+ *
+ */
+template<typename T = void>
+class task {
+public:
+	using promise_type = detail::task_promise<T>;
+
+	task(task &&other) noexcept : h_(std::exchange(other.h_, {})) {}
+	task(const task &) = delete;
+	task &operator=(const task &) = delete;
+	task &operator=(task &&) = delete;
+
+	~task()
+	{
+		if (h_)
+			h_.destroy();
+	}
+
+	bool await_ready() const noexcept { return false; }
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+	{
+		h_.promise().continuation = awaiting;
+		return h_;
+	}
+
+	T await_resume() { return h_.promise().result(); }
+
+private:
+	friend promise_type;
+
+	explicit task(std::coroutine_handle<promise_type> h) noexcept : h_(h) {}
+
+	std::coroutine_handle<promise_type> h_;
+};
+
+namespace detail {
+
+template<typename T>
+inline task<T> task_promise<T>::get_return_object() noexcept
+{
+	return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept
+{
+	return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+}
+
+}  // namespace detail
+
+
+class lint_operation;
+
+
+/*
+ * Resumes coroutines whose lookups have completed and issues batches of
+ * outstanding lookups to the gcp_source.
+ *
+ */
+class event_loop {
+public:
+	explicit event_loop(gcp_source &source, std::size_t max_batch = 256, std::size_t max_in_flight = 4)
+		: source_(source), max_batch_(max_batch ? max_batch : 1), max_in_flight_(max_in_flight ? max_in_flight : 1) {}
+
+	event_loop(const event_loop &) = delete;
+	event_loop &operator=(const event_loop &) = delete;
+
+	/*
+	 * Destroying a root destroys the frames of the tasks that it awaits,
+	 * including those suspended on a lookup, so only the roots are destroyed.
+	 *
+	 */
+	~event_loop()
+	{
+		while (!roots_.empty())
+			roots_.front().destroy();
+	}
+
+	/*
+	 * Start a task, which runs inline until it first suspends.
+	 *
+	 */
+	void spawn(task<void> t)
+	{
+		drive(std::move(t));
+	}
+
+	/*
+	 * Run until all spawned tasks have completed. The first exception to
+	 * escape a spawned task is rethrown.
+	 *
+	 */
+	void run();
+
+	std::size_t live() const noexcept { return roots_.size(); }
+	std::size_t batches() const noexcept { return batches_; }
+	std::size_t lookups() const noexcept { return lookups_; }
+
+private:
+	friend class lint_operation;
+
+	struct completed_batch {
+		std::vector<lint_operation *> ops;
+		std::vector<gcp_status> statuses;
+	};
+
+	/*
+	 * Batches completed by the gcp_source, shared with its completions so
+	 * that they remain valid if the loop is destroyed first.
+	 *
+	 */
+	struct completion_queue {
+		std::mutex mutex;
+		std::condition_variable cv;
+		std::vector<completed_batch> completed;
+	};
+
+	/*
+	 * Eagerly started, self-destroying coroutine that drives a spawned task,
+	 * registered with the loop while it is live.
+	 *
+	 */
+	struct root {
+		struct promise_type {
+			template<typename... Args>
+			promise_type(event_loop &loop, Args &...) : loop_(loop)
+			{
+				loop_.roots_.push_front(std::coroutine_handle<promise_type>::from_promise(*this));
+				it_ = loop_.roots_.begin();
+			}
+
+			~promise_type() { loop_.roots_.erase(it_); }
+
+			root get_return_object() const noexcept { return {}; }
+			std::suspend_never initial_suspend() const noexcept { return {}; }
+			std::suspend_never final_suspend() const noexcept { return {}; }
+			void return_void() const noexcept {}
+			void unhandled_exception() const noexcept { std::terminate(); }
+
+		private:
+			event_loop &loop_;
+			std::list<std::coroutine_handle<>>::iterator it_;
+		};
+	};
+
+	root drive(task<void> t)
+	{
+		try {
+			co_await t;
+		} catch (...) {
+			if (!error_)
+				error_ = std::current_exception();
+		}
+	}
+
+	void enqueue(lint_operation *op) { pending_.push_back(op); }
+	void issue_batch();
+	void complete(completed_batch &b);
+
+	gcp_source &source_;
+	const std::size_t max_batch_;
+	const std::size_t max_in_flight_;
+
+	std::size_t in_flight_ = 0;
+	std::size_t batches_ = 0;
+	std::size_t lookups_ = 0;
+	std::exception_ptr error_;
+
+	std::list<std::coroutine_handle<>> roots_;
+	std::deque<lint_operation *> pending_;
+	std::deque<std::coroutine_handle<>> ready_;
+
+	const std::shared_ptr<completion_queue> queue_ = std::make_shared<completion_queue>();
+};
+
+
+/*
+ * Awaitable result of lint_async().
+ *
+ */
+class lint_operation {
+public:
+	lint_operation(event_loop &loop, linter_id id, std::string_view data) noexcept
+		: loop_(loop), id_(id), data_(data) {}
+
+	bool await_ready()
+	{
+		result_ = lint(id_, data_);
+		return id_ != linter_id::key || !result_;
+	}
+
+	void await_suspend(std::coroutine_handle<> h)
+	{
+		handle_ = h;
+		loop_.enqueue(this);
+	}
+
+	lint_result await_resume() const noexcept { return result_; }
+
+private:
+	friend class event_loop;
+
+	void set_status(gcp_status status) noexcept
+	{
+		if (status == gcp_status::invalid)
+			result_ = { GS1_LINTER_INVALID_GCP_PREFIX, 0, 0 };
+		else if (status == gcp_status::offline)
+			result_ = { GS1_LINTER_GCP_DATASOURCE_OFFLINE, 0, 0 };
+	}
+
+	event_loop &loop_;
+	const linter_id id_;
+	const std::string_view data_;
+	lint_result result_;
+	std::coroutine_handle<> handle_;
+};
+
+
+/*
+ * Lint data with the given linter, suspending for a GCP lookup if required.
+ * The data must remain valid until the operation completes.
+ *
+ */
+inline lint_operation lint_async(event_loop &loop, linter_id id, std::string_view data) noexcept
+{
+	return lint_operation(loop, id, data);
+}
+
+
+inline void event_loop::issue_batch()
+{
+	std::vector<lint_operation *> ops;
+	std::vector<std::string> keys;
+
+	while (!pending_.empty() && ops.size() < max_batch_) {
+		ops.push_back(pending_.front());
+		keys.emplace_back(pending_.front()->data_);
+		pending_.pop_front();
+	}
+
+	in_flight_++;
+	batches_++;
+	lookups_ += ops.size();
+
+	source_.lookup(std::move(keys), [queue = queue_, ops = std::move(ops)](std::vector<gcp_status> statuses) mutable {
+		{
+			const std::lock_guard<std::mutex> lock(queue->mutex);
+			queue->completed.push_back({ std::move(ops), std::move(statuses) });
+		}
+		queue->cv.notify_one();
+	});
+}
+
+inline void event_loop::complete(completed_batch &b)
+{
+	const bool ok = b.statuses.size() == b.ops.size();
+
+	for (std::size_t i = 0; i < b.ops.size(); i++) {
+		b.ops[i]->set_status(ok ? b.statuses[i] : gcp_status::offline);
+		ready_.push_back(b.ops[i]->handle_);
+	}
+	in_flight_--;
+}
+
+inline void event_loop::run()
+{
+	std::vector<completed_batch> done;
+
+	for (;;) {
+
+		while (!ready_.empty()) {
+			const std::coroutine_handle<> h = ready_.front();
+			ready_.pop_front();
+			h.resume();
+		}
+
+		while (!pending_.empty() && in_flight_ < max_in_flight_)
+			issue_batch();
+
+		if (in_flight_ == 0)
+			break;
+
+		{
+			std::unique_lock<std::mutex> lock(queue_->mutex);
+			queue_->cv.wait(lock, [this] { return !queue_->completed.empty(); });
+			done.swap(queue_->completed);
+		}
+
+		for (completed_batch &b : done)
+			complete(b);
+		done.clear();
+
+	}
+
+	if (error_)
+		std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+}  // namespace gs1
+
+
+#endif  /* GS1_SYNTAXDICTIONARY_ASYNC_HPP */
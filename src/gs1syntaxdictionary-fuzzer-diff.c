@@ -0,0 +1,284 @@
+/**
+ * GS1 Syntax Dictionary
+ *
+ * @author Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Differential fuzzers that run each optimised code path side by side with
+ * the reference implementation from which it was derived and abort on any
+ * divergence in the return code, or in err_pos and err_len when an error is
+ * reported. The comparison is selected with -DDIFF=<name>:
+ *
+ *   diff_fixedlen   Length-specialised linter kernels versus the generic
+ *                   linters.
+ *   diff_charclass  gs1_charclass_span(), including the SIMD backend, versus
+ *                   a byte-at-a-time search of the character list.
+ *   diff_spec       gs1_dict_validate() versus gs1_dict_spec_interpret() for
+ *                   the entry selected by the first two bytes of the input.
+ *                   The dictionary is read from $GS1_DICT, otherwise from
+ *                   ../gs1-syntax-dictionary.txt, otherwise a small built-in
+ *                   dictionary is used.
+ *
+ * The comparisons are external so that each build uses one without warnings
+ * about the others. When adding a new fast path, add its pairing here.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+#include "dictionary.h"
+
+#ifndef DIFF
+#error
+#endif
+
+#define MAX_DATA 4096
+
+
+static void check(const char* const what,
+		  const gs1_lint_err_t err, const size_t pos, const size_t len,
+		  const gs1_lint_err_t ref, const size_t rpos, const size_t rlen)
+{
+
+	if (err == ref && (ref == GS1_LINTER_OK || (pos == rpos && len == rlen)))
+		return;
+
+	fprintf(stderr, "%s diverges: optimised (%d, %d, %d); reference (%d, %d, %d)\n", what,
+		(int)err, (int)pos, (int)len, (int)ref, (int)rpos, (int)rlen);
+	abort();
+
+}
+
+
+void diff_fixedlen(const char* const data, const size_t len)
+{
+
+	static const struct {
+		const char *name;
+		gs1_linter_t kernel;
+		gs1_linter_t generic;
+	} pairs[] = {
+		{ "csum_13",	gs1_lint_csum_13,	gs1_lint_csum },
+		{ "csum_14",	gs1_lint_csum_14,	gs1_lint_csum },
+		{ "csum_18",	gs1_lint_csum_18,	gs1_lint_csum },
+		{ "yymmd0_6",	gs1_lint_yymmd0_6,	gs1_lint_yymmd0 },
+		{ "yymmdd_6",	gs1_lint_yymmdd_6,	gs1_lint_yymmdd },
+	};
+
+	gs1_lint_err_t err, ref;
+	size_t i, pos, elen, rpos, rlen;
+
+	(void)len;
+
+	/*
+	 * The kernels are only selected for data of their own length, but they
+	 * must agree on any input.
+	 *
+	 */
+	for (i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+		pos = elen = rpos = rlen = 0;
+		err = pairs[i].kernel(data, &pos, &elen);
+		ref = pairs[i].generic(data, &rpos, &rlen);
+		check(pairs[i].name, err, pos, elen, ref, rpos, rlen);
+	}
+
+}
+
+
+static size_t span_reference(const unsigned char* const member, const char* const data, const size_t len)
+{
+
+	size_t i;
+
+	for (i = 0; i < len && member[(unsigned char)data[i]]; i++);
+
+	return i;
+
+}
+
+
+void diff_charclass(const char* const data, const size_t len)
+{
+
+	static const struct {
+		const char *name;
+		const char *chars;
+	} builtins[] = {
+		{ "cset82", "!\"%&'()*+,-./0123456789:;<=>?ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz" },
+		{ "cset39", "#-/0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" },
+		{ "cset64", "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_" },
+		{ "cset32", "23456789ABCDEFGHJKLMNPQRSTUVWXYZ" },
+		{ "csetnumeric", "0123456789" },
+		{ "iban", "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" },
+	};
+
+	unsigned char member[256];
+	char chars[33];
+	gs1_charclass_t cc;
+	gs1_lint_err_t err;
+	const char *p;
+	size_t i, n, off, span, ref, pos, elen, rpos;
+
+	/*
+	 * Each built-in class over the whole input, including any NULs.
+	 *
+	 */
+	for (i = 0; i < sizeof(builtins) / sizeof(builtins[0]); i++) {
+		memset(member, 0, sizeof(member));
+		for (p = builtins[i].chars; *p; p++)
+			member[(unsigned char)*p] = 1;
+		span = gs1_charclass_span(gs1_charclass_from_name(builtins[i].name), data, len);
+		ref = span_reference(member, data, len);
+		check(builtins[i].name, span == len ? GS1_LINTER_OK : GS1_LINTER_NOT_IN_CHARACTER_CLASS, span, 1,
+		      ref == len ? GS1_LINTER_OK : GS1_LINTER_NOT_IN_CHARACTER_CLASS, ref, 1);
+	}
+
+	/*
+	 * A custom class taken from the head of the input, optionally with a
+	 * range, applied to the remainder at each alignment.
+	 *
+	 */
+	if (len < 3)
+		return;
+
+	n = (unsigned char)data[0] % sizeof(chars);
+	if (n > len - 3)
+		n = len - 3;
+	memcpy(chars, data + 3, n);
+	chars[n] = '\0';
+
+	gs1_charclass_init(&cc, chars);
+	memset(member, 0, sizeof(member));
+	for (p = chars; *p; p++)
+		member[(unsigned char)*p] = 1;
+
+	if ((unsigned char)data[1] <= (unsigned char)data[2]) {
+		gs1_charclass_add_range(&cc, (unsigned char)data[1], (unsigned char)data[2]);
+		for (i = (unsigned char)data[1]; i <= (unsigned char)data[2]; i++)
+			member[i] = 1;
+	}
+
+	for (off = 3 + n; off < len && off < 3 + n + 16; off++) {
+		span = gs1_charclass_span(&cc, data + off, len - off);
+		ref = span_reference(member, data + off, len - off);
+		check("custom span", span == len - off ? GS1_LINTER_OK : GS1_LINTER_NOT_IN_CHARACTER_CLASS, span, 1,
+		      ref == len - off ? GS1_LINTER_OK : GS1_LINTER_NOT_IN_CHARACTER_CLASS, ref, 1);
+	}
+
+	/*
+	 * gs1_lint_charclass() stops at the first NUL.
+	 *
+	 */
+	pos = elen = 0;
+	err = gs1_lint_charclass(&cc, data + 3 + n, &pos, &elen);
+	rpos = span_reference(member, data + 3 + n, strlen(data + 3 + n));
+	check("gs1_lint_charclass", err, pos, elen,
+	      data[3 + n + rpos] == '\0' ? GS1_LINTER_OK : GS1_LINTER_NOT_IN_CHARACTER_CLASS, rpos, 1);
+
+}
+
+
+static const char fallback_dict[] =
+	"01         *?  N14,csum,key                  ex=02,255,37 dlpkey=22,10,21|235                    # GTIN\n"
+	"10          ?  X..20                         req=01,02,8006,8026                                 # BATCH/LOT\n"
+	"253         ?  N13,csum,key [X..17]          dlpkey                                              # GDTI\n"
+	"422         ?  N3,iso3166                    req=01,02                                           # ORIGIN\n"
+	"4300        ?  X..35,pcenc                   req=00                                              # SHIP TO COMP\n"
+	"4330        ?  N6 [X1],hyphen                req=00 ex=4331                                      # MAX TEMP F.\n"
+	"7007        ?  N6,yymmdd [N6],yymmdd         req=01,02                                           # HARVEST DATE\n"
+	"8008        ?  N8,yymmddhh [N..4],mmoptss    req=01,02                                           # PROD TIME\n"
+	"8010        ?  Y..30,key                     dlpkey=8011                                         # CPID\n"
+	"8030           Z..90                                                                             # DIGSIG\n";
+
+
+static gs1_dict_t *spec_dict(void)
+{
+
+	static gs1_dict_t *dict = NULL;
+	const char *path;
+	char *text = NULL;
+	long flen = 0;
+	FILE *f;
+
+	if (dict)
+		return dict;
+
+	if ((path = getenv("GS1_DICT")) == NULL)
+		path = "../gs1-syntax-dictionary.txt";
+
+	if ((f = fopen(path, "rb")) != NULL) {
+		if (fseek(f, 0, SEEK_END) == 0 && (flen = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0 &&
+		    (text = malloc((size_t)flen)) != NULL && fread(text, 1, (size_t)flen, f) == (size_t)flen &&
+		    gs1_dict_load(text, (size_t)flen, &dict, NULL) != GS1_DICT_OK)
+			dict = NULL;
+		free(text);
+		fclose(f);
+	}
+
+	if (!dict && gs1_dict_load(fallback_dict, sizeof(fallback_dict) - 1, &dict, NULL) != GS1_DICT_OK)
+		abort();
+
+	return dict;
+
+}
+
+
+void diff_spec(const char* const data, const size_t len)
+{
+
+	const gs1_dict_t* const dict = spec_dict();
+	gs1_lint_err_t err, ref;
+	size_t pos = 0, elen = 0, rpos = 0, rlen = 0;
+	int entry;
+
+	if (len < 2)
+		return;
+
+	entry = (int)(((size_t)(unsigned char)data[0] << 8 | (unsigned char)data[1]) % gs1_dict_count(dict));
+
+	err = gs1_dict_validate(dict, entry, data + 2, len - 2, &pos, &elen);
+	ref = gs1_dict_spec_interpret(gs1_dict_spec(dict, entry), data + 2, len - 2, &rpos, &rlen);
+	check(gs1_dict_spec(dict, entry), err, pos, elen, ref, rpos, rlen);
+
+}
+
+
+int LLVMFuzzerTestOneInput(const uint8_t* const buf, size_t len) {
+
+	char data[MAX_DATA+1];
+
+	if (len > MAX_DATA)
+		return 0;
+
+	memcpy(data, buf, len);
+	data[len] = '\0';
+
+	/*
+	 * The linters see the data up to the first NUL; the length-delimited
+	 * interfaces see all of it.
+	 *
+	 */
+	DIFF(data, len);
+
+	return 0;
+
+}
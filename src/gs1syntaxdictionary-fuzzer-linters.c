@@ -19,12 +19,27 @@
  */
 
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
+#ifdef PERF
+#include <time.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
 #include "gs1syntaxdictionary.h"
 
+#ifdef PERF_REPLAY
+static gs1_linter_t replay_linter;
+#endif
+
 #ifndef LINTER
 #error
 #endif
@@ -34,6 +49,105 @@
 #define MAX_DATA 4096
 
 
+#ifdef PERF
+
+/*
+ * Performance fuzzing, built with -DPERF, searches for inputs that make the
+ * linter slow. The cost of each run is measured in instructions retired where
+ * the perf_event interface is available, which is repeatable between runs,
+ * and otherwise in CPU time. The cost is recorded as a libFuzzer extra
+ * counter at an index that rises logarithmically, with eight bands per
+ * doubling, so that any input that reaches a new band is retained in the
+ * corpus. The corpus thus accumulates the slowest inputs found, and those
+ * exceeding -report_slow_units are also saved as artifacts.
+ *
+ */
+#if defined(__linux__) && !defined(PERF_REPLAY)
+__attribute__((used, section("__libfuzzer_extra_counters")))
+#endif
+static uint8_t cost_bands[512];
+
+#ifdef __linux__
+static int perf_fd = -2;
+#endif
+static uint64_t cost_t0;
+
+
+static uint64_t cpu_ns(void)
+{
+
+	struct timespec ts;
+
+#ifdef CLOCK_THREAD_CPUTIME_ID
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+#else
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+
+}
+
+
+static void cost_start(void)
+{
+
+#ifdef __linux__
+	if (perf_fd == -2) {
+		struct perf_event_attr pe;
+		memset(&pe, 0, sizeof(pe));
+		pe.type = PERF_TYPE_HARDWARE;
+		pe.size = sizeof(pe);
+		pe.config = PERF_COUNT_HW_INSTRUCTIONS;
+		pe.disabled = 1;
+		pe.exclude_kernel = 1;
+		pe.exclude_hv = 1;
+		perf_fd = (int)syscall(SYS_perf_event_open, &pe, 0, -1, -1, 0);
+	}
+	if (perf_fd >= 0) {
+		ioctl(perf_fd, PERF_EVENT_IOC_RESET, 0);
+		ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+		return;
+	}
+#endif
+
+	cost_t0 = cpu_ns();
+
+}
+
+
+static uint64_t cost_stop(void)
+{
+
+#ifdef __linux__
+	uint64_t n;
+
+	if (perf_fd >= 0) {
+		ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+		return read(perf_fd, &n, sizeof(n)) == (ssize_t)sizeof(n) ? n : 0;
+	}
+#endif
+
+	return cpu_ns() - cost_t0;
+
+}
+
+
+static void cost_record(const uint64_t cost)
+{
+
+	unsigned int e = 0;
+
+	while (e < 63 && cost >> (e + 1))
+		e++;
+
+	cost_bands[e * 8 + (e >= 3 ? (cost >> (e - 3)) & 7 : 0)] = 1;
+
+}
+
+#endif  /* PERF */
+
+
 int LLVMFuzzerTestOneInput(const uint8_t* const buf, size_t len) {
 
 	char data[MAX_DATA+1];
@@ -47,7 +161,13 @@ int LLVMFuzzerTestOneInput(const uint8_t* const buf, size_t len) {
 	data[len] = '\0';
 	len = strlen(data);	// Might be shorter still due to nulls in buf
 
+#ifdef PERF
+	cost_start();
 	err = RUN_LINTER(LINTER, data, err_pos, err_len);
+	cost_record(cost_stop());
+#else
+	err = RUN_LINTER(LINTER, data, err_pos, err_len);
+#endif
 
 	if (err != GS1_LINTER_OK) {
 		assert(*err_pos < len || *err_pos == 0);
@@ -61,3 +181,66 @@ int LLVMFuzzerTestOneInput(const uint8_t* const buf, size_t len) {
 	return 0;
 
 }
+
+
+#ifdef PERF_REPLAY
+
+/*
+ * Replays saved inputs, such as a performance fuzzing corpus, as benchmark
+ * cases:
+ *
+ *     gs1syntaxdictionary-perf-replay <linter> <file>...
+ *
+ * For each file, prints the cost of a single run as measured during fuzzing,
+ * i.e. instructions or else nanoseconds of CPU time, and the mean wall time in
+ * nanoseconds per run over many runs.
+ *
+ */
+#define REPLAY_RUNS 10000
+
+int main(int argc, char *argv[]) {
+
+	char data[MAX_DATA+1];
+	struct timespec t0, t1;
+	uint64_t cost;
+	size_t len;
+	FILE *f;
+	int i, r;
+
+	if (argc < 2 || (replay_linter = gs1_linter_from_name(argv[1])) == NULL) {
+		fprintf(stderr, "Usage: %s <linter> <file>...\n", argv[0]);
+		return 1;
+	}
+
+	for (i = 2; i < argc; i++) {
+
+		if ((f = fopen(argv[i], "rb")) == NULL) {
+			perror(argv[i]);
+			return 1;
+		}
+		len = fread(data, 1, MAX_DATA, f);
+		fclose(f);
+		data[len] = '\0';
+
+		LLVMFuzzerTestOneInput((const uint8_t*)data, len);
+
+		cost_start();
+		RUN_LINTER(LINTER, data, NULL, NULL);
+		cost = cost_stop();
+
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		for (r = 0; r < REPLAY_RUNS; r++)
+			RUN_LINTER(LINTER, data, NULL, NULL);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+
+		printf("%llu\t%.1f\t%s\n", (unsigned long long)cost,
+		       ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / REPLAY_RUNS,
+		       argv[i]);
+
+	}
+
+	return 0;
+
+}
+
+#endif  /* PERF_REPLAY */
@@ -0,0 +1,179 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Reference data used by the linters, as initialiser lists.
+ *
+ * The C linters and the constexpr implementations in gs1syntaxdictionary.hpp
+ * are both built from these definitions so that each table is maintained in
+ * exactly one place.
+ *
+ */
+
+#ifndef GS1_SYNTAXDICTIONARY_TABLES_H
+#define GS1_SYNTAXDICTIONARY_TABLES_H
+
+
+/*
+ * Sequences of the characters in each character set, ordered by weight where
+ * the set is used to compute a check character pair.
+ *
+ */
+#define GS1_SYNTAX_DICTIONARY_CSET82						\
+	"!\"%&'()*+,-./0123456789:;<=>?ABCDEFGHIJKLMNOPQRSTUVWXYZ_"		\
+	"abcdefghijklmnopqrstuvwxyz"
+
+#define GS1_SYNTAX_DICTIONARY_CSET39 "#-/0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+
+#define GS1_SYNTAX_DICTIONARY_CSET64						\
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZ"						\
+	"abcdefghijklmnopqrstuvwxyz"						\
+	"0123456789-_"
+
+#define GS1_SYNTAX_DICTIONARY_CSET32 "23456789ABCDEFGHJKLMNPQRSTUVWXYZ"
+
+#define GS1_SYNTAX_DICTIONARY_CSETNUMERIC "0123456789"
+
+
+/*
+ * Prime number weights for the alphanumeric check character pair.
+ *
+ */
+#define GS1_SYNTAX_DICTIONARY_CSUMALPHA_PRIMES					\
+	  2,   3,   5,   7,  11,  13,  17,  19,  23,  29,  31,  37,		\
+	 41,  43,  47,  53,  59,  61,  67,  71,  73,  79,  83,  89,		\
+	 97, 101, 103, 107, 109, 113, 127, 131, 137, 139, 149, 151,		\
+	157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223,		\
+	227, 229, 233, 239, 241, 251, 257, 263, 269, 271, 277, 281,		\
+	283, 293, 307, 311, 313, 317, 331, 337, 347, 349, 353, 359,		\
+	367, 373, 379, 383, 389, 397, 401, 409, 419, 421, 431, 433,		\
+	439, 443, 449, 457, 461, 463, 467, 479, 487, 491, 499, 503,		\
+	509
+
+
+/*
+ *  Bitmaps of the ISO code lists, 64 codes to each word with the most
+ *  significant bit of the first word representing the lowest code.
+ *
+ *  MAINTENANCE NOTE:
+ *
+ *  Updates to the ISO 3166 country code lists are provided here:
+ *
+ *  https://isotc.iso.org/livelink/livelink?func=ll&objId=16944257&objAction=browse&viewType=1
+ *
+ *  Updates to the ISO 4217 three-digit currency code list are provided
+ *  here:
+ *
+ *  https://www.six-group.com/en/products-services/financial-information/data-standards.html
+ *
+ *  The hexadecimal fallback, for compilers lacking binary literal support,
+ *  must be regenerated from the binary data after an update with:
+ *
+ *     for (size_t i = 0; i < sizeof(tbl) / sizeof(tbl[0]); i++) { printf("%lx ", tbl[i]); };
+ *
+ */
+#if (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 202311L) || (defined(__cplusplus) && __cplusplus >= 201402L)
+#define GS1_SYNTAX_DICTIONARY_BINARY_LITERALS
+#endif
+
+/*
+ *  Set of ISO 3166 num-3 country codes
+ *
+ */
+#ifdef GS1_SYNTAX_DICTIONARY_BINARY_LITERALS
+#define GS1_SYNTAX_DICTIONARY_ISO3166_BITMAP	\
+	0b0000100010101000100010001000100110001000100010001011100010001000,  /* 000-063: 004 008 010 012 016 020 024 028 031-032 036 040 044 048 050-052 056 060 */	\
+	0b1000101010101000000010100010100010001000100010001000100010001000,  /* 064-127: 064 068 070 072 074 076 084 086 090 092 096 100 104 108 112 116 120 124 */	\
+	0b0000100010001000100010001000101000100010001000110010100010001001,  /* 128-191: 132 136 140 144 148 152 156 158 162 166 170 174 175 178 180 184 188 191 */	\
+	0b1000100000011000100010100010001000100001111000110010001010100010,  /* 192-255: 192 196 203-204 208 212 214 218 222 226 231-234 238-239 242 246 248 250 254 */	\
+	0b0010101000101010000110000000000010001000100010001000100010001000,  /* 256-319: 258 260 262 266 268 270 275 276 288 292 296 300 304 308 312 316 */	\
+	0b1000100010001010100010001000100010001000100010001000100010001000,  /* 320-383: 320 324 328 332 334 336 340 344 348 352 356 360 364 368 372 376 380 */	\
+	0b1000100010000010100010001010001001100010001010100010001010100010,  /* 384-447: 384 388 392 398 400 404 408 410 414 417-418 422 426 428 430 434 438 440 442 446 */	\
+	0b0010001000100010001000100010001010001000000010001011100010001000,  /* 448-511: 450 454 458 462 466 470 474 478 480 484 492 496 498-500 504 508 */	\
+	0b1000100010001000100101110000100000001000001000100010001000100010,  /* 512-575: 512 516 520 524 528 531 533-535 540 548 554 558 562 566 570 574 */	\
+	0b0010110111100001000000101000100010001000100010001010001000100010,  /* 576-639: 578 580 581 583 584 585 586 591 598 600 604 608 612 616 620 624 626 630 634 638 */	\
+	0b0011001000001010000110110010001000100010001000101010001000000011,  /* 640-703: 642 643 646 652 654 659 660 662 663 666 670 674 678 682 686 688 690 694 702 703 */	\
+	0b1110001000001000000010001100100000001000100010001000100010101000,  /* 704-767: 704 705 706 710 716 724 728 729 732 740 744 748 752 756 760 762 764 */	\
+	0b1000100010001000100010001001101010001001000000000010000000100001,  /* 768-831: 768 772 776 780 784 788 792 795 796 798 800 804 807 818 826 831 */	\
+	0b1110000010000000001000100010101000000000000010000010000100000010,  /* 832-895: 832 833 834 840 850 854 858 860 862 876 882 887 894 */	\
+	0b0000000000000000000000000000000000000000000000000000000000000000,  /* 896-959: */	\
+	0b0000000000000000000000000000000000000000000000000000000000000000   /* 960-999: */
+#else
+#define GS1_SYNTAX_DICTIONARY_ISO3166_BITMAP	\
+	0x08a888898888b888, 0x8aa80a2888888888, 0x0888888a22232889, 0x88188a2221e322a2,	\
+	0x2a2a180088888888, 0x888a888888888888, 0x888288a2622a22a2, 0x222222228808b888,	\
+	0x8888970808222222, 0x2de102888888a222, 0x320a1b222222a203, 0xe20808c8088888a8,	\
+	0x8888889a89002021, 0xe080222a00082102, 0x0000000000000000, 0x0000000000000000
+#endif
+
+/*
+ *  Set of ISO 3166 alpha-2 country codes
+ *
+ */
+#ifdef GS1_SYNTAX_DICTIONARY_BINARY_LITERALS
+#define GS1_SYNTAX_DICTIONARY_ISO3166ALPHA2_BITMAP	\
+	0b0001111010011010111110110111011111110111101111011011101101111011,  /* AA-CL: AD-AG AI AL-AM AO AQ-AU AW-AX AZ-BB BD-BJ BL-BO BQ-BT BV-BW BY-CA CC-CD CF-CH CI CK-CL */	\
+	0b1110010011111100001000011010100000000001001010110000000001110000,  /* CM-EX: CM-CO CR CU-CZ DE DJ DK DM DO DZ EC EE EG-EH ER-ET */	\
+	0b0000000000111010100100000000110111111001110111111010100000000000,  /* EY-HJ: FI-FJ FK FM FO FR GA-GB GD-GI GL-GN GP-GU GW GY */	\
+	0b1011000101100000000110000001111011110000000000100000001011000000,  /* HK-JV: HK HM-HN HR HT-HU ID-IE IL-IO IQ-IT JE JM JO-JP */	\
+	0b0000000010111000110101000010111110000010100000011111001010111111,  /* JW-MH: KE KG-KI KM-KN KP KR KW KY-KZ LA-LC LI LK LR-LV LY MA MC-MH */	\
+	0b0011111111111111111010111010010011010010000100000000000010000000,  /* MI-OT: MK-NA NC NE-NG NI NL NO-NP NR NU NZ OM */	\
+	0b0000001000111100111100011100101010000000000000000000000000000010,  /* OU-RF: PA PE-PH PK-PN PR-PT PW PY QA RE */	\
+	0b0000000010001010100011111011111111100111010111001101110111111001,  /* RG-TR: RO RS RU RW SA-SE SG-SO SR-ST SV SX-SZ TC-TD TF-TH TJ-TO TR */	\
+	0b0101100110000010000010000010000011101010101000010000001000000000,  /* TS-WD: TT TV-TW TZ UA UG UM US UY UZ VA VC VE VG VI VN VU */	\
+	0b0100000000000010000000000000000000000000000000000000100000000000,  /* WE-YP: WF WS YE */	\
+	0b0001000000100000000000100000000010000000000000000000000000000000   /* YQ-ZZ: YT ZA ZM ZW */
+#else
+#define GS1_SYNTAX_DICTIONARY_ISO3166ALPHA2_BITMAP	\
+	0x1e9afb77f7bdbb7b, 0xe4fc21a8012b0070, 0x003a900df9dfa800, 0xb160181ef00202c0,	\
+	0x00b8d42f8281f2bf, 0x3fffeba4d2100080, 0x023cf1ca80000002, 0x008a8fbfe75cddf9,	\
+	0x59820820eaa10200, 0x4002000000000800, 0x1020020080000000
+#endif
+
+/*
+ *  Set of ISO 4217 three-digit currency codes
+ *
+ */
+#ifdef GS1_SYNTAX_DICTIONARY_BINARY_LITERALS
+#define GS1_SYNTAX_DICTIONARY_ISO4217_BITMAP	\
+	0b0000000010001000000000000000000010001000000010001011100000001000,  /* 000-063: 008 012 032 036 044 048 050-052 060 */	\
+	0b1000100010000000000010000010000010000000100010000000100000001000,  /* 064-127: 064 068 072 084 090 096 104 108 116 124 */	\
+	0b0000100010000000100000001000100000000000001000100000000000001001,  /* 128-191: 132 136 144 152 156 170 174 188 191-192 */	\
+	0b1000000000010000100000100000001000000010100000100010000000000000,  /* 192-255: 192 203 208 214 222 230 232 238 242 */	\
+	0b0000001000000010000000000000000000001000000000000000000000000000,  /* 256-319: 262 270 292 */	\
+	0b1000100010001000000010001000100010001000100010001000000010000000,  /* 320-383: 320 324 328 332 340 344 348 352 356 360 364 368 376 */	\
+	0b0000100010000010100010001010001001100010001000100010000000000010,  /* 384-447: 388 392 398 400 404 408 410 414 417-418 422 426 430 434 446 */	\
+	0b0000001000100010000000000000000010001000000000001010000010000000,  /* 448-511: 454 458 462 480 484 496 498 504 */	\
+	0b1000100000001000000011000000000000001000001000100000001000000000,  /* 512-575: 512 516 524 532-533 548 554 558 566 */	\
+	0b0010000000100010000000101000100010000000000000000000000000100000,  /* 576-639: 578 586 590 598 600 604 608 634 */	\
+	0b0001001000000010000000000000000000000000001000000010001000000010,  /* 640-703: 643 646 654 682 690 694 702 */	\
+	0b1010001000000000000000001000000000000000000010001000100010001000,  /* 704-767: 704 706 710 728 748 752 756 760 764 */	\
+	0b0000000010001000100010000000000010000001000000000010000000100000,  /* 768-831: 776 780 784 788 800 807 818 826 */	\
+	0b0010000010000000000000000010100000000000000000000010001000000000,  /* 832-895: 834 840 858 860 882 886 */	\
+	0b0000010000000000000000000000110111111110101011011011111111011111,  /* 896-959: 901 924-925 927-934 936 938 940-941 943-944 946-953 955-959 */	\
+	0b1111110111111101111111001110001000100101000000000000000000000000   /* 960-999: 960-965 967-973 975-981 984-986 990 994 997 999 */
+#else
+#define GS1_SYNTAX_DICTIONARY_ISO4217_BITMAP	\
+	0x008800008808b808, 0x8880082080880808, 0x0880808800220009, 0x8010820202822000,	\
+	0x0202000008000000, 0x8888088888888080, 0x088288a262222002, 0x022200008800a080,	\
+	0x88080c0008220200, 0x2022028880000020, 0x1202000000202202, 0xa200008000088888,	\
+	0x0088880081002020, 0x2080002800002200, 0x0400000dfeadbfdf, 0xfdfdfce225000000
+#endif
+
+
+#endif  /* GS1_SYNTAXDICTIONARY_TABLES_H */
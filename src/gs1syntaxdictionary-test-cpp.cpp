@@ -0,0 +1,802 @@
+/**
+ * GS1 Syntax Dictionary
+ *
+ * @author Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Unit tests for the C++ interface.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/*
+ *  Don't report warnings in third-party code that is only used for testing.
+ *
+ */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wclobbered"
+#endif
+#include "acutest.h"
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#include "gs1syntaxdictionary.hpp"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>) && !defined(_WIN32)
+#define TEST_ASYNC
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "gs1syntaxdictionary-async.hpp"
+#endif
+
+
+using namespace std::literals;
+
+
+static void test_cpp_linter_names(void)
+{
+
+	std::size_t i;
+
+	for (i = 1; i < gs1::num_linters; i++)
+		TEST_CHECK(gs1::linter_names[i-1] < gs1::linter_names[i]);
+
+	for (i = 0; i < gs1::num_linters; i++) {
+		const std::string name(gs1::linter_names[i]);
+		TEST_CHECK(gs1::function(static_cast<gs1::linter_id>(i)) == gs1_linter_from_name(name.c_str()));
+		TEST_MSG("Mismatch for %s", name.c_str());
+	}
+
+	static_assert(gs1::linter_from_name("csum") == gs1::linter_id::csum);
+	static_assert(gs1::linter_from_name("zero") == gs1::linter_id::zero);
+	static_assert(!gs1::linter_from_name("dummy"));
+	static_assert(gs1::name(gs1::linter_id::key) == "key");
+
+}
+
+
+static void test_cpp_lint(void)
+{
+
+	gs1::lint_result r;
+	char buf[12];
+
+	TEST_CHECK(gs1::valid<gs1::linter_id::csum>("02345673"));
+	TEST_CHECK(!gs1::valid<gs1::linter_id::csum>("12345673"));
+
+	r = gs1::lint<gs1::linter_id::csum>("12345673");
+	TEST_CHECK(r.err == GS1_LINTER_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(r.pos == 7 && r.len == 1);
+
+	/*
+	 * A view that is not null-terminated.
+	 *
+	 */
+	std::memcpy(buf, "0234567390AB", 12);
+	r = gs1::linter<gs1::linter_id::csum>::lint(std::string_view(buf, 8));
+	TEST_CHECK(r.ok());
+
+	r = gs1::lint(gs1::linter_id::cset82, "AB C");
+	TEST_CHECK(r.err == GS1_LINTER_INVALID_CSET82_CHARACTER);
+	TEST_CHECK(r.pos == 2 && r.len == 1);
+
+	/*
+	 * Overlong data takes the heap path.
+	 *
+	 */
+	r = gs1::lint<gs1::linter_id::cset82>(std::string(1000, 'A') + " ");
+	TEST_CHECK(r.err == GS1_LINTER_INVALID_CSET82_CHARACTER);
+	TEST_CHECK(r.pos == 1000);
+
+#ifdef GS1_SYNTAX_DICTIONARY_HAVE_EXPECTED
+	TEST_CHECK(gs1::check<gs1::linter_id::csum>("02345673").has_value());
+	TEST_CHECK(gs1::check<gs1::linter_id::csum>("12345673").error().err == GS1_LINTER_INCORRECT_CHECK_DIGIT);
+#endif
+
+}
+
+
+static void test_cpp_batch(void)
+{
+
+	const std::vector<std::string_view> values = { "02345673"sv, "12345673"sv, ""sv, "416000336108"sv };
+	std::vector<gs1::lint_result> results;
+	std::int32_t codes[4];
+	gs1_lint_result_t packed[4];
+
+	gs1::lint_each<gs1::linter_id::csum>(values, std::back_inserter(results));
+	TEST_ASSERT(results.size() == 4);
+	TEST_CHECK(results[0].ok());
+	TEST_CHECK(results[1].err == GS1_LINTER_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(results[2].err == GS1_LINTER_TOO_SHORT_FOR_CHECK_DIGIT);
+	TEST_CHECK(results[3].ok());
+
+	const gs1::batch b(values);
+	TEST_CHECK(b.size() == 4);
+	TEST_CHECK(b[3] == "416000336108");
+	TEST_CHECK(gs1::lint_batch<gs1::linter_id::csum>(b, codes) == 2);
+	TEST_CHECK(codes[0] == GS1_LINTER_OK);
+	TEST_CHECK(codes[1] == GS1_LINTER_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(codes[2] == GS1_LINTER_TOO_SHORT_FOR_CHECK_DIGIT);
+	TEST_CHECK(codes[3] == GS1_LINTER_OK);
+
+	TEST_CHECK(gs1::lint_batch(gs1::linter_id::csum, b.data(), b.offsets(), b.size(), codes) == 2);
+
+	TEST_CHECK(gs1::lint_batch<gs1::linter_id::csum>(b, packed) == 2);
+	TEST_CHECK(gs1::unpack(packed[0]).ok());
+	TEST_CHECK(gs1::unpack(packed[1]).err == GS1_LINTER_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(gs1::unpack(packed[1]).pos == 7 && gs1::unpack(packed[1]).len == 1);
+	TEST_CHECK(gs1::lint_batch(gs1::linter_id::csum, b.data(), b.offsets(), b.size(), packed) == 2);
+
+#ifdef GS1_SYNTAX_DICTIONARY_HAVE_SPAN
+	TEST_CHECK(gs1::lint_batch<gs1::linter_id::csum>(b, std::span<std::int32_t>(codes)) == 2);
+	try {
+		(void)gs1::lint_batch<gs1::linter_id::csum>(b, std::span<std::int32_t>(codes, 3));
+		TEST_CHECK(false);
+	} catch (const std::length_error &) {
+	}
+	TEST_CHECK(gs1::lint_batch<gs1::linter_id::csum>(b, std::span<gs1_lint_result_t>(packed)) == 2);
+#endif
+
+	/*
+	 * A value with an embedded null is rejected, as by gs1_lint_batch().
+	 *
+	 */
+	gs1::batch nul;
+	nul.add("095\0XYZ"sv);
+	nul.add("826"sv);
+	TEST_CHECK(gs1::lint_batch<gs1::linter_id::iso3166>(nul, codes) == 1);
+	TEST_CHECK(codes[0] == GS1_LINTER_ILLEGAL_NUL_CHARACTER);
+	TEST_CHECK(codes[1] == GS1_LINTER_OK);
+	TEST_CHECK(gs1::lint_batch(gs1::linter_id::iso3166, nul.data(), nul.offsets(), nul.size(), packed) == 1);
+	TEST_CHECK(gs1::unpack(packed[0]).err == GS1_LINTER_ILLEGAL_NUL_CHARACTER && gs1::unpack(packed[0]).pos == 3);
+
+}
+
+
+#ifdef GS1_SYNTAX_DICTIONARY_HAVE_CONSTEXPR_LINT
+
+static_assert(gs1::valid<gs1::csum>("09521234543213"));
+static_assert(!gs1::valid<gs1::csum>("09521234543214"));
+static_assert(gs1::lint<gs1::csum>("09521234543214").pos == 13);
+static_assert(gs1::valid<gs1::csumalpha>("1987654Ad4X4bL5ttr2310c2K"));
+static_assert(gs1::valid<gs1::yymmdd>("200229"));
+static_assert(!gs1::valid<gs1::yymmdd>("210229"));
+static_assert(gs1::valid<gs1::yymmddhh>("20022923"));
+static_assert(gs1::lint<gs1::yymmddhh>("20022924").err == GS1_LINTER_ILLEGAL_HOUR);
+static_assert(gs1::valid<gs1::hhmm>("2359"));
+static_assert(gs1::lint<gs1::mmoptss>("5960").pos == 2);
+static_assert(gs1::valid<gs1::iso3166>("826"));
+static_assert(gs1::valid<gs1::iso3166alpha2>("GB"));
+static_assert(gs1::valid<gs1::iso4217>("978"));
+static_assert(gs1::lint<gs1::cset82>("AB C").err == GS1_LINTER_INVALID_CSET82_CHARACTER);
+
+#ifdef __cpp_consteval
+static constexpr gs1::checked<gs1::csum> checked_gtin = "09521234543213";
+static_assert(checked_gtin.view().size() == 14);
+#endif
+
+#endif
+
+
+/*
+ * Compare a constexpr linter with the C reference implementation.
+ *
+ */
+template<typename Fn>
+static bool same_as_c(const gs1_linter_t fn, Fn ce, const std::string &data)
+{
+	std::size_t pos = 0, len = 0;
+	const gs1_lint_err_t err = fn(data.c_str(), &pos, &len);
+	const gs1::lint_result r = ce(data);
+
+	if (err != r.err || (err != GS1_LINTER_OK && (pos != r.pos || len != r.len))) {
+		TEST_MSG("Mismatch for \"%s\": C (%d, %d, %d); constexpr (%d, %d, %d)", data.c_str(),
+			 (int)err, (int)pos, (int)len, (int)r.err, (int)r.pos, (int)r.len);
+		return false;
+	}
+	return true;
+}
+
+static std::uint32_t rnd(void)
+{
+	static std::uint32_t x = 2463534242u;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+
+/*
+ * Random string, mostly drawn from the given set with occasional arbitrary
+ * (non-null) characters.
+ *
+ */
+static std::string rnd_string(std::string_view set, std::size_t len)
+{
+	std::string s;
+	for (std::size_t i = 0; i < len; i++) {
+		if (rnd() % 16 == 0)
+			s += static_cast<char>(1 + rnd() % 255);
+		else
+			s += set[rnd() % set.size()];
+	}
+	return s;
+}
+
+static void test_cpp_constexpr_equivalence(void)
+{
+
+	static const std::string_view cset82 =
+		"!\"%&'()*+,-./0123456789:;<=>?ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz";
+	static const std::string_view cset32 = "23456789ABCDEFGHJKLMNPQRSTUVWXYZ";
+	static const std::string_view cset64 =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_=";
+
+	char buf[16];
+	std::size_t i, j, len;
+	bool ok = true;
+
+	/*
+	 * Exhaustively over short numeric data.
+	 *
+	 */
+	for (len = 0; len <= 4; len++) {
+		std::size_t n = 1;
+		for (j = 0; j < len; j++)
+			n *= 11;	/* Digits plus one non-digit */
+		for (i = 0; i < n; i++) {
+			std::size_t v = i;
+			std::string s;
+			for (j = 0; j < len; j++, v /= 11)
+				s += v % 11 == 10 ? 'A' : static_cast<char>('0' + v % 11);
+			ok &= same_as_c(gs1_lint_csum, gs1::ce::csum, s);
+			ok &= same_as_c(gs1_lint_csetnumeric, gs1::ce::csetnumeric, s);
+			ok &= same_as_c(gs1_lint_iso3166, gs1::ce::iso3166, s);
+			ok &= same_as_c(gs1_lint_iso3166999, gs1::ce::iso3166999, s);
+			ok &= same_as_c(gs1_lint_iso4217, gs1::ce::iso4217, s);
+			ok &= same_as_c(gs1_lint_hhmm, gs1::ce::hhmm, s);
+			ok &= same_as_c(gs1_lint_mmoptss, gs1::ce::mmoptss, s);
+		}
+	}
+
+	/*
+	 * Every six-digit date, with an hour that is sometimes out of range, and
+	 * every month and day of selected centuries and leap years.
+	 *
+	 */
+	for (i = 0; i < 1000000; i++) {
+		std::snprintf(buf, sizeof(buf), "%06d", (int)i);
+		ok &= same_as_c(gs1_lint_yymmd0, gs1::ce::yymmd0, buf);
+		ok &= same_as_c(gs1_lint_yymmdd, gs1::ce::yymmdd, buf);
+		std::snprintf(buf, sizeof(buf), "%06d%02d", (int)i, (int)(i % 32));
+		ok &= same_as_c(gs1_lint_yymmddhh, gs1::ce::yymmddhh, buf);
+	}
+	for (const int yyyy : { 1900, 1999, 2000, 2023, 2024, 2100, 2400 }) {
+		for (i = 0; i < 10000; i++) {
+			std::snprintf(buf, sizeof(buf), "%04d%04d", yyyy, (int)i);
+			ok &= same_as_c(gs1_lint_yyyymmd0, gs1::ce::yyyymmd0, buf);
+			ok &= same_as_c(gs1_lint_yyyymmdd, gs1::ce::yyyymmdd, buf);
+		}
+	}
+
+	/*
+	 * Every two-character value for alpha-2 codes.
+	 *
+	 */
+	for (i = 0; i < 256 * 256; i++) {
+		std::string s;
+		if (i / 256)
+			s += static_cast<char>(i / 256);
+		if (i % 256)
+			s += static_cast<char>(i % 256);
+		ok &= same_as_c(gs1_lint_iso3166alpha2, gs1::ce::iso3166alpha2, s);
+	}
+
+	/*
+	 * Random data of all lengths, including overlong.
+	 *
+	 */
+	for (i = 0; i < 50000; i++) {
+		std::string s;
+		len = rnd() % 100;
+
+		s = rnd_string("0123456789", len);
+		ok &= same_as_c(gs1_lint_csum, gs1::ce::csum, s);
+		ok &= same_as_c(gs1_lint_yymmd0, gs1::ce::yymmd0, s.substr(0, rnd() % 9));
+		ok &= same_as_c(gs1_lint_yyyymmdd, gs1::ce::yyyymmdd, s.substr(0, rnd() % 11));
+		ok &= same_as_c(gs1_lint_yymmddhh, gs1::ce::yymmddhh, s.substr(0, rnd() % 11));
+
+		s = rnd_string(cset82, len);
+		ok &= same_as_c(gs1_lint_cset82, gs1::ce::cset82, s);
+		ok &= same_as_c(gs1_lint_cset39, gs1::ce::cset39, s);
+		ok &= same_as_c(gs1_lint_csumalpha, gs1::ce::csumalpha, s);
+		ok &= same_as_c(gs1_lint_csumalpha, gs1::ce::csumalpha, s + rnd_string(cset32, 2));
+
+		s = rnd_string(cset64, len);
+		ok &= same_as_c(gs1_lint_cset64, gs1::ce::cset64, s);
+		ok &= same_as_c(gs1_lint_cset64, gs1::ce::cset64, s + std::string(rnd() % 4, '='));
+
+		if (!ok)
+			break;
+	}
+
+	/*
+	 * Correct check pairs, found by trial of all pairs.
+	 *
+	 */
+	for (i = 0; i < 200; i++) {
+		const std::string s = rnd_string(cset82, rnd() % 20);
+		std::size_t valid = 0;
+		for (const char a : cset32) {
+			for (const char b : cset32) {
+				const std::string t = s + a + b;
+				ok &= same_as_c(gs1_lint_csumalpha, gs1::ce::csumalpha, t);
+				if (gs1::ce::csumalpha(t))
+					valid++;
+			}
+		}
+		TEST_CHECK(valid == (gs1_lint_cset82(s.c_str(), NULL, NULL) == GS1_LINTER_OK ? 1 : 0));
+	}
+
+	TEST_CHECK(ok);
+
+}
+
+
+#ifdef TEST_ASYNC
+
+/*
+ * Stub GCP lookup server, connected over a socket pair, that answers each
+ * request line of space-separated keys with a line holding a status
+ * character per key: "V"alid, "I"nvalid or "O"ffline.
+ *
+ */
+static bool read_line(int fd, std::string &line)
+{
+	char c;
+	line.clear();
+	for (;;) {
+		if (read(fd, &c, 1) != 1)
+			return false;
+		if (c == '\n')
+			return true;
+		line += c;
+	}
+}
+
+static bool write_all(int fd, const std::string &s)
+{
+	std::size_t off = 0;
+	while (off < s.size()) {
+		const ssize_t n = write(fd, s.data() + off, s.size() - off);
+		if (n <= 0)
+			return false;
+		off += static_cast<std::size_t>(n);
+	}
+	return true;
+}
+
+static void stub_server(int fd)
+{
+	std::string line, reply;
+	while (read_line(fd, line)) {
+		std::size_t s = 0;
+		reply.clear();
+		while (s < line.size()) {
+			std::size_t e = line.find(' ', s);
+			if (e == std::string::npos)
+				e = line.size();
+			const std::string_view key = std::string_view(line).substr(s, e - s);
+			if (key.substr(0, 3) == "999")
+				reply += 'O';
+			else if (key.substr(0, 7) == "9521234" || key.substr(0, 7) == "9524321")
+				reply += 'V';
+			else
+				reply += 'I';
+			s = e + 1;
+		}
+		reply += '\n';
+		if (!write_all(fd, reply))
+			break;
+	}
+	close(fd);
+}
+
+/*
+ * Client for the stub server: requests are written as they are issued and
+ * responses are read, in order, by a separate thread that completes them.
+ *
+ */
+class stub_client : public gs1::gcp_source {
+public:
+	stub_client()
+	{
+		int fds[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+			throw std::runtime_error("socketpair");
+		fd_ = fds[0];
+		server_ = std::thread(stub_server, fds[1]);
+		reader_ = std::thread([this] { read_responses(); });
+	}
+
+	~stub_client() override
+	{
+		shutdown(fd_, SHUT_WR);
+		server_.join();
+		reader_.join();
+		close(fd_);
+	}
+
+	void lookup(std::vector<std::string> keys, completion done) override
+	{
+		std::string req;
+		for (const std::string &k : keys)
+			req += (req.empty() ? "" : " ") + k;
+		req += '\n';
+		const std::lock_guard<std::mutex> lock(mutex_);
+		waiting_.push_back(std::move(done));
+		write_all(fd_, req);
+	}
+
+private:
+	void read_responses()
+	{
+		std::string line;
+		while (read_line(fd_, line)) {
+			std::vector<gs1::gcp_status> statuses;
+			completion done;
+			for (const char c : line)
+				statuses.push_back(c == 'V' ? gs1::gcp_status::valid :
+						   c == 'I' ? gs1::gcp_status::invalid : gs1::gcp_status::offline);
+			{
+				const std::lock_guard<std::mutex> lock(mutex_);
+				done = std::move(waiting_.front());
+				waiting_.pop_front();
+			}
+			done(std::move(statuses));
+		}
+	}
+
+	int fd_;
+	std::thread server_, reader_;
+	std::mutex mutex_;
+	std::deque<completion> waiting_;
+};
+
+static gs1::task<void> check_gtin(gs1::event_loop &loop, std::string_view gtin, gs1::lint_result &out)
+{
+	out = co_await gs1::lint_async(loop, gs1::csum, gtin);
+	if (out)
+		out = co_await gs1::lint_async(loop, gs1::key, gtin.substr(1));
+}
+
+static gs1::task<int> count_valid(gs1::event_loop &loop, std::string_view a, std::string_view b)
+{
+	int n = 0;
+	if (co_await gs1::lint_async(loop, gs1::cset82, a))
+		n++;
+	if (co_await gs1::lint_async(loop, gs1::cset82, b))
+		n++;
+	co_return n;
+}
+
+static gs1::task<void> cpu_only(gs1::event_loop &loop, int &out)
+{
+	out = co_await count_valid(loop, "ABC", "A C");
+}
+
+static gs1::task<void> throws(gs1::event_loop &loop)
+{
+	(void)co_await gs1::lint_async(loop, gs1::key, "95212340000");
+	throw std::runtime_error("failed");
+}
+
+/*
+ * Source that holds on to the completions of its lookups, and fails once it
+ * has been given a given number.
+ *
+ */
+class held_source : public gs1::gcp_source {
+public:
+	explicit held_source(std::size_t limit) : limit_(limit) {}
+
+	void lookup(std::vector<std::string> keys, completion done) override
+	{
+		if (held.size() == limit_)
+			throw std::runtime_error("unavailable");
+		held.emplace_back(keys.size(), std::move(done));
+	}
+
+	std::vector<std::pair<std::size_t, completion>> held;
+
+private:
+	const std::size_t limit_;
+};
+
+/*
+ * Counts the frames of a task that are live, including while it is suspended.
+ *
+ */
+struct frame_counter {
+	explicit frame_counter(int &n) : n_(n) { n_++; }
+	~frame_counter() { n_--; }
+	int &n_;
+};
+
+static gs1::task<gs1::lint_result> counted_key(gs1::event_loop &loop, std::string_view gtin, int &frames)
+{
+	const frame_counter c(frames);
+	co_return co_await gs1::lint_async(loop, gs1::key, gtin);
+}
+
+static gs1::task<void> counted_check(gs1::event_loop &loop, std::string_view gtin, int &frames)
+{
+	const frame_counter c(frames);
+	(void)co_await counted_key(loop, gtin, frames);
+}
+
+#endif
+
+static void test_cpp_async(void)
+{
+
+#ifdef TEST_ASYNC
+
+	static const char* const prefixes[] = { "9521234", "9524321", "9529999", "9990000" };
+	const std::size_t n = 2000;
+	std::vector<std::string> gtins;
+	std::vector<gs1::lint_result> results(n);
+	std::size_t i, lookups = 0;
+	int count = -1;
+
+	stub_client client;
+
+	/*
+	 * GTINs with allocated, unallocated and "offline" GCPs, every fifth
+	 * with an incorrect check digit.
+	 *
+	 */
+	for (i = 0; i < n; i++) {
+		char buf[15];
+		std::snprintf(buf, sizeof(buf), "0%s%05d0", prefixes[i % 4], (int)(i % 100000));
+		while (gs1_lint_csum(buf, NULL, NULL) != GS1_LINTER_OK)
+			buf[13]++;
+		if (i % 5 == 0)
+			buf[13] = buf[13] == '9' ? '0' : static_cast<char>(buf[13] + 1);
+		else
+			lookups++;
+		gtins.emplace_back(buf);
+	}
+
+	{
+		gs1::event_loop loop(client, 256, 2);
+
+		/*
+		 * Linters that only need the CPU complete inline.
+		 *
+		 */
+		loop.spawn(cpu_only(loop, count));
+		TEST_CHECK(count == 1);
+		TEST_CHECK(loop.live() == 0);
+
+		for (i = 0; i < n; i++)
+			loop.spawn(check_gtin(loop, gtins[i], results[i]));
+		TEST_CHECK(loop.live() == lookups);
+
+		loop.run();
+		TEST_CHECK(loop.live() == 0);
+		TEST_CHECK(loop.lookups() == lookups);
+		TEST_CHECK(loop.batches() == (lookups + 255) / 256);
+	}
+
+	for (i = 0; i < n; i++) {
+		gs1_lint_err_t expect =
+			i % 5 == 0 ? GS1_LINTER_INCORRECT_CHECK_DIGIT :
+			i % 4 == 2 ? GS1_LINTER_INVALID_GCP_PREFIX :
+			i % 4 == 3 ? GS1_LINTER_GCP_DATASOURCE_OFFLINE :
+			GS1_LINTER_OK;
+		TEST_CHECK(results[i].err == expect);
+		TEST_MSG("For %s", gtins[i].c_str());
+	}
+
+	/*
+	 * Exceptions escaping a task are rethrown by run().
+	 *
+	 */
+	{
+		gs1::event_loop loop(client);
+		bool caught = false;
+		loop.spawn(throws(loop));
+		try {
+			loop.run();
+		} catch (const std::runtime_error &) {
+			caught = true;
+		}
+		TEST_CHECK(caught);
+	}
+
+	/*
+	 * Destroying a loop with tasks outstanding destroys their frames, both
+	 * for lookups that were never issued and for those in flight, whose late
+	 * completions are then discarded.
+	 *
+	 */
+	{
+		held_source source(1);
+		int frames = 0;
+		bool caught = false;
+
+		{
+			gs1::event_loop loop(source, 1);
+			for (i = 0; i < 3; i++)
+				loop.spawn(counted_check(loop, "95212340000", frames));
+			TEST_CHECK(loop.live() == 3);
+			TEST_CHECK(frames == 6);
+			try {
+				loop.run();
+			} catch (const std::runtime_error &) {
+				caught = true;
+			}
+			TEST_CHECK(caught);
+			TEST_CHECK(loop.live() == 3);
+		}
+		TEST_CHECK(frames == 0);
+
+		TEST_ASSERT(source.held.size() == 1);
+		source.held[0].second(std::vector<gs1::gcp_status>(source.held[0].first, gs1::gcp_status::valid));
+	}
+
+#endif
+
+}
+
+
+
+/*
+ * Threads sharing an SSCC allocator receive disjoint serial references that
+ * together cover the range, each with a valid check digit.
+ *
+ */
+static void test_cpp_alloc_threads(void)
+{
+
+	constexpr unsigned threads = 4;
+	constexpr uint64_t count = 100000;
+	gs1_alloc_t *alloc;
+	std::vector<std::vector<std::string>> got(threads);
+	std::vector<std::thread> pool;
+	std::vector<std::string> all;
+
+	TEST_ASSERT(gs1_alloc_sscc_create("0952123", 0, count - 1, &alloc) == GS1_ALLOC_OK);
+
+	for (unsigned t = 0; t < threads; t++) {
+		pool.emplace_back([alloc, &out = got[t], t] {
+			gs1_alloc_cursor_t cur;
+			char buf[GS1_ALLOC_BUF_LEN];
+			gs1_alloc_cursor_init(&cur, 61 + t);
+			while (gs1_alloc_next(alloc, &cur, buf, sizeof(buf)) != 0)
+				out.emplace_back(buf);
+		});
+	}
+	for (auto &th : pool)
+		th.join();
+	gs1_alloc_free(alloc);
+
+	for (const auto &v : got)
+		all.insert(all.end(), v.begin(), v.end());
+	TEST_CHECK(all.size() == count);
+	std::sort(all.begin(), all.end());
+	TEST_CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+	TEST_CHECK(std::all_of(all.begin(), all.end(), [](const std::string &s) {
+		return gs1_lint_csum(s.c_str() + 4, nullptr, nullptr) == GS1_LINTER_OK;
+	}));
+	TEST_CHECK(all.front() == "(00)095212300000000000");
+
+}
+
+
+/*
+ * Readers that validate against a dictionary holder while it is repeatedly
+ * replaced always see a complete dictionary, and every replaced dictionary
+ * is eventually reclaimed.
+ *
+ */
+static void test_cpp_dict_live_threads(void)
+{
+
+	constexpr unsigned threads = 4;
+	static const char v1[] =
+		"01  *?  N14,csum,key  # GTIN\n"
+		"10   ?  X..20         # BATCH/LOT\n";
+	static const char v2[] =
+		"01  *?  N14,csum,key  # GTIN\n"
+		"10   ?  X..20         # BATCH/LOT\n"
+		"7250 ?  N8,yyyymmdd   # DOB\n";
+	gs1_dict_t *dict;
+	gs1_dict_live_t *live;
+	std::atomic<bool> stop{false};
+	std::vector<unsigned long> failures(threads), reads(threads);
+	std::vector<std::thread> pool;
+
+	TEST_ASSERT(gs1_dict_load(v1, sizeof(v1) - 1, &dict, nullptr) == GS1_DICT_OK);
+	TEST_ASSERT((live = gs1_dict_live_create(dict, threads)) != nullptr);
+
+	for (unsigned t = 0; t < threads; t++) {
+		pool.emplace_back([live, &stop, &fail = failures[t], &n = reads[t]] {
+			gs1_dict_reader_t *reader = gs1_dict_reader_register(live);
+			if (!reader) {
+				fail++;
+				return;
+			}
+			while (!stop.load()) {
+				const gs1_dict_t *d = gs1_dict_read_begin(reader);
+				const size_t count = gs1_dict_count(d);
+				if (gs1_dict_find(d, "01", 2) != 0 || gs1_dict_find(d, "10", 2) != 1 ||
+				    (count == 3) != (gs1_dict_find(d, "7250", 4) == 2))
+					fail++;
+				gs1_dict_read_end(reader);
+				n++;
+			}
+			gs1_dict_reader_unregister(reader);
+		});
+	}
+
+	for (int i = 0; i < 2000; i++) {
+		const char *text = i % 2 ? v1 : v2;
+		TEST_CHECK(gs1_dict_live_load(live, text, strlen(text), nullptr) == GS1_DICT_OK);
+	}
+	stop = true;
+	for (auto &th : pool)
+		th.join();
+
+	for (unsigned t = 0; t < threads; t++)
+		TEST_CHECK(failures[t] == 0);
+	TEST_CHECK(gs1_dict_live_reclaim(live) == 0);
+	gs1_dict_live_free(live);
+
+}
+
+
+TEST_LIST = {
+
+	{ "cpp_linter_names", test_cpp_linter_names },
+	{ "cpp_lint", test_cpp_lint },
+	{ "cpp_batch", test_cpp_batch },
+	{ "cpp_constexpr_equivalence", test_cpp_constexpr_equivalence },
+	{ "cpp_async", test_cpp_async },
+	{ "cpp_alloc_threads", test_cpp_alloc_threads },
+	{ "cpp_dict_live_threads", test_cpp_dict_live_threads },
+
+	{ NULL, NULL }
+
+};
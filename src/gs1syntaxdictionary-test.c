@@ -76,6 +76,51 @@ void test_lint_hasnondigit(void);
 
 void test_name_function_map_is_sorted(void);
 void test_gs1_linter_from_name(void);
+void test_gs1_lint_err_msg(void);
+
+void test_batch_gs1_lint_batch(void);
+void test_batch_gs1_lint_batch_results(void);
+void test_fixedlen_csum(void);
+void test_fixedlen_yymmd0(void);
+void test_fixedlen_gs1_linter_from_name_and_length(void);
+void test_epc_encode96(void);
+void test_epc_decode96(void);
+void test_epc_batch(void);
+void test_epc_to_uri(void);
+void test_epc_from_uri(void);
+void test_epc_uri_batch(void);
+void test_dictionary_load(void);
+void test_dictionary_errors(void);
+void test_dictionary_load_derived(void);
+void test_dictionary_load_file(void);
+void test_hri_format(void);
+void test_hri_format_batch(void);
+void test_duplicates_gs1_ai_dedup(void);
+void test_associations_dictionary_rules(void);
+void test_associations_profiles(void);
+void test_associations_dictionary_file(void);
+void test_uniqueness_filter(void);
+void test_uniqueness_exact_store(void);
+#ifdef SLOW_TESTS
+void test_uniqueness_insert_speed(void);
+#endif
+void test_allocator_sscc(void);
+void test_allocator_gtin_serial(void);
+void test_gtin_normalise(void);
+void test_gtin_normalise_batch(void);
+void test_charclass_builtin(void);
+void test_charclass_span(void);
+void test_charclass_gs1_lint_charclass(void);
+void test_dictlive_swap(void);
+void test_spec_validate(void);
+void test_spec_validate_batch(void);
+void test_spec_compile_errors(void);
+void test_spec_validate_small_domains(void);
+void test_spec_validate_file(void);
+void test_carrier_gs1_128_plan(void);
+void test_carrier_gs1_128_optimal(void);
+void test_carrier_estimate(void);
+void test_carrier_qr_optimal(void);
 
 
 TEST_LIST = {
@@ -119,6 +164,51 @@ TEST_LIST = {
 
 	{ "name_function_map_is_sorted", test_name_function_map_is_sorted },
 	{ "gs1_linter_from_name", test_gs1_linter_from_name },
+	{ "gs1_lint_err_msg", test_gs1_lint_err_msg },
+
+	{ "batch_gs1_lint_batch", test_batch_gs1_lint_batch },
+	{ "batch_gs1_lint_batch_results", test_batch_gs1_lint_batch_results },
+	{ "fixedlen_csum", test_fixedlen_csum },
+	{ "fixedlen_yymmd0", test_fixedlen_yymmd0 },
+	{ "fixedlen_gs1_linter_from_name_and_length", test_fixedlen_gs1_linter_from_name_and_length },
+	{ "epc_encode96", test_epc_encode96 },
+	{ "epc_decode96", test_epc_decode96 },
+	{ "epc_batch", test_epc_batch },
+	{ "epc_to_uri", test_epc_to_uri },
+	{ "epc_from_uri", test_epc_from_uri },
+	{ "epc_uri_batch", test_epc_uri_batch },
+	{ "dictionary_load", test_dictionary_load },
+	{ "dictionary_errors", test_dictionary_errors },
+	{ "dictionary_load_derived", test_dictionary_load_derived },
+	{ "dictionary_load_file", test_dictionary_load_file },
+	{ "hri_format", test_hri_format },
+	{ "hri_format_batch", test_hri_format_batch },
+	{ "duplicates_gs1_ai_dedup", test_duplicates_gs1_ai_dedup },
+	{ "associations_dictionary_rules", test_associations_dictionary_rules },
+	{ "associations_profiles", test_associations_profiles },
+	{ "associations_dictionary_file", test_associations_dictionary_file },
+	{ "uniqueness_filter", test_uniqueness_filter },
+	{ "uniqueness_exact_store", test_uniqueness_exact_store },
+#ifdef SLOW_TESTS
+	{ "uniqueness_insert_speed", test_uniqueness_insert_speed },
+#endif
+	{ "allocator_sscc", test_allocator_sscc },
+	{ "allocator_gtin_serial", test_allocator_gtin_serial },
+	{ "gtin_normalise", test_gtin_normalise },
+	{ "gtin_normalise_batch", test_gtin_normalise_batch },
+	{ "charclass_builtin", test_charclass_builtin },
+	{ "charclass_span", test_charclass_span },
+	{ "charclass_gs1_lint_charclass", test_charclass_gs1_lint_charclass },
+	{ "dictlive_swap", test_dictlive_swap },
+	{ "spec_validate", test_spec_validate },
+	{ "spec_validate_batch", test_spec_validate_batch },
+	{ "spec_compile_errors", test_spec_compile_errors },
+	{ "spec_validate_small_domains", test_spec_validate_small_domains },
+	{ "spec_validate_file", test_spec_validate_file },
+	{ "carrier_gs1_128_plan", test_carrier_gs1_128_plan },
+	{ "carrier_gs1_128_optimal", test_carrier_gs1_128_optimal },
+	{ "carrier_estimate", test_carrier_estimate },
+	{ "carrier_qr_optimal", test_carrier_qr_optimal },
 
 	{ NULL, NULL }
 
@@ -16,56 +16,58 @@
  *
  */
 
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "gs1syntaxdictionary.h"
 
 
-struct name_function_s {
-	char *name;
-	gs1_linter_t fn;
+/*
+ * The linter names are held as a single string blob, indexed by offset,
+ * rather than as an array of pointers. Together with the switch that maps an
+ * index to its function this leaves nothing to be relocated when the library
+ * is loaded, so the table remains in shared, read-only pages.
+ *
+ */
+static const struct linter_names_s {
+#define X(n) char n[sizeof(#n)];
+	GS1_SYNTAX_DICTIONARY_LINTERS(X)
+#undef X
+} linter_names = {
+#define X(n) #n,
+	GS1_SYNTAX_DICTIONARY_LINTERS(X)
+#undef X
 };
 
-const struct name_function_s name_function_map[] = {
-	{ .name = "couponcode",		.fn = gs1_lint_couponcode },
-	{ .name = "couponposoffer",	.fn = gs1_lint_couponposoffer },
-	{ .name = "cset39",		.fn = gs1_lint_cset39 },
-	{ .name = "cset64",		.fn = gs1_lint_cset64 },
-	{ .name = "cset82",		.fn = gs1_lint_cset82 },
-	{ .name = "csetnumeric",	.fn = gs1_lint_csetnumeric },
-	{ .name = "csum",		.fn = gs1_lint_csum },
-	{ .name = "csumalpha",		.fn = gs1_lint_csumalpha },
-	{ .name = "hasnondigit",	.fn = gs1_lint_hasnondigit },
-	{ .name = "hhmm",		.fn = gs1_lint_hhmm },
-	{ .name = "hyphen",		.fn = gs1_lint_hyphen },
-	{ .name = "iban",		.fn = gs1_lint_iban },
-	{ .name = "importeridx",	.fn = gs1_lint_importeridx },
-	{ .name = "iso3166",		.fn = gs1_lint_iso3166 },
-	{ .name = "iso3166999",		.fn = gs1_lint_iso3166999 },
-	{ .name = "iso3166alpha2",	.fn = gs1_lint_iso3166alpha2 },
-	{ .name = "iso3166list",	.fn = gs1_lint_iso3166list },
-	{ .name = "iso4217",		.fn = gs1_lint_iso4217 },
-	{ .name = "iso5218",		.fn = gs1_lint_iso5218 },
-	{ .name = "key",		.fn = gs1_lint_key },
-	{ .name = "latitude",		.fn = gs1_lint_latitude },
-	{ .name = "longitude",		.fn = gs1_lint_longitude },
-	{ .name = "mediatype",		.fn = gs1_lint_mediatype },
-	{ .name = "mmoptss",		.fn = gs1_lint_mmoptss },
-	{ .name = "nonzero",		.fn = gs1_lint_nonzero },
-	{ .name = "nozeroprefix",	.fn = gs1_lint_nozeroprefix },
-	{ .name = "pcenc",		.fn = gs1_lint_pcenc },
-	{ .name = "pieceoftotal",	.fn = gs1_lint_pieceoftotal },
-	{ .name = "posinseqslash",	.fn = gs1_lint_posinseqslash },
-	{ .name = "winding",		.fn = gs1_lint_winding },
-	{ .name = "yesno",		.fn = gs1_lint_yesno },
-	{ .name = "yymmd0",		.fn = gs1_lint_yymmd0 },
-	{ .name = "yymmdd",		.fn = gs1_lint_yymmdd },
-	{ .name = "yymmddhh",		.fn = gs1_lint_yymmddhh },
-	{ .name = "yyyymmd0",		.fn = gs1_lint_yyyymmd0 },
-	{ .name = "yyyymmdd",		.fn = gs1_lint_yyyymmdd },
-	{ .name = "zero",		.fn = gs1_lint_zero },
+static const uint16_t linter_name_offsets[] = {
+#define X(n) offsetof(struct linter_names_s, n),
+	GS1_SYNTAX_DICTIONARY_LINTERS(X)
+#undef X
 };
 
+enum {
+#define X(n) LINTER_##n,
+	GS1_SYNTAX_DICTIONARY_LINTERS(X)
+#undef X
+	NUM_LINTERS
+};
+
+#define LINTER_NAME(i) ((const char *)&linter_names + linter_name_offsets[i])
+
+
+static gs1_linter_t linter_function(const size_t i)
+{
+
+	switch (i) {
+#define X(n) case LINTER_##n: return gs1_lint_##n;
+	GS1_SYNTAX_DICTIONARY_LINTERS(X)
+#undef X
+	}
+
+	return NULL;
+
+}
 
 
 /*
@@ -74,15 +76,15 @@ const struct name_function_s name_function_map[] = {
  */
 gs1_linter_t gs1_linter_from_name(const char* const name) {
 
-	size_t s = 0, e = sizeof(name_function_map) / sizeof(name_function_map[0]);
+	size_t s = 0, e = NUM_LINTERS;
 
 	while (s < e) {
 
 		size_t m = s + (e - s) / 2;
-		int cmp = strcmp(name_function_map[m].name, name);
+		int cmp = strcmp(LINTER_NAME(m), name);
 
 		if (cmp == 0)
-			return name_function_map[m].fn;
+			return linter_function(m);
 		if (cmp < 0)
 			s = m + 1;
 		else
@@ -97,130 +99,183 @@ gs1_linter_t gs1_linter_from_name(const char* const name) {
 
 /*
  * Example mapping of gs1_lint_err_t entries to friendly strings in the English
- * language.
+ * language, as X(error, string).
  *
  * Order matches that of gs1_lint_err_t.
  *
  */
 #ifdef GS1_LINTER_ERR_STR_EN
 
+#define LINT_ERR_MSGS(X)	\
+	X(OK, "No issues were detected by the linter.") \
+	X(NON_DIGIT_CHARACTER, "A non-digit character was found where a digit is expected.") \
+	X(INVALID_CSET82_CHARACTER, "A non-CSET 82 character was found where a CSET 82 character is expected.") \
+	X(INVALID_CSET39_CHARACTER, "A non-CSET 39 character was found where a CSET 39 character is expected.") \
+	X(INVALID_CSET32_CHARACTER, "A non-CSET 32 character was found where a CSET 32 character is expected.") \
+	X(INCORRECT_CHECK_DIGIT, "The numeric check digit is incorrect.") \
+	X(TOO_SHORT_FOR_CHECK_DIGIT, "The component is too short to perform a numeric check digit calculation.") \
+	X(INCORRECT_CHECK_PAIR, "The alphanumeric check-character pair are incorrect.") \
+	X(TOO_SHORT_FOR_CHECK_PAIR, "The component is too short to perform an alphanumeric check character pair calculation.") \
+	X(TOO_LONG_FOR_CHECK_PAIR_IMPLEMENTATION, "The component is too long to perform an alphanumeric check character pair calculation.") \
+	X(GCP_DATASOURCE_OFFLINE, "The data source for GCP lookups is offline.") \
+	X(TOO_SHORT_FOR_KEY, "The component is shorter than the minimum length GS1 Company Prefix.") \
+	X(INVALID_GCP_PREFIX, "The GS1 Company Prefix is invalid.") \
+	X(IMPORTER_IDX_MUST_BE_ONE_CHARACTER, "The Importer Index must be a single character.") \
+	X(INVALID_IMPORT_IDX_CHARACTER, "The Importer Index is an invalid character.") \
+	X(ILLEGAL_ZERO_VALUE, "A non-zero value is required.") \
+	X(NOT_ZERO, "A zero is required.") \
+	X(ILLEGAL_ZERO_PREFIX, "A zero prefix is not permitted.") \
+	X(NOT_ZERO_OR_ONE, "A \"0\" or \"1\" is required.") \
+	X(INVALID_WINDING_DIRECTION, "The winding direction must be either \"0\", \"1\" or \"9\".") \
+	X(NOT_ISO3166, "A valid ISO 3166 three-digit country code is required.") \
+	X(NOT_ISO3166_OR_999, "A valid ISO 3166 three-digit country code or \"999\" is required.") \
+	X(NOT_ISO3166_ALPHA2, "A valid ISO 3166 two-character country code is required.") \
+	X(NOT_ISO4217, "A valid ISO 4217 three-digit currency code is required.") \
+	X(IBAN_TOO_SHORT, "The IBAN is too short.") \
+	X(INVALID_IBAN_CHARACTER, "The IBAN contains an invalid character.") \
+	X(ILLEGAL_IBAN_COUNTRY_CODE, "The IBAN must start with a valid ISO 3166 two-character country code.") \
+	X(INCORRECT_IBAN_CHECKSUM, "The IBAN is invalid since the check characters are incorrect.") \
+	X(DATE_TOO_SHORT, "The date is too short.") \
+	X(DATE_TOO_LONG, "The date is too long.") \
+	X(DATE_WITH_HOUR_TOO_SHORT, "The date with hour is too short for YYMMDDHH format.") \
+	X(DATE_WITH_HOUR_TOO_LONG, "The date with hour is too long for YYMMDDHH format.") \
+	X(HOUR_WITH_MINUTE_TOO_SHORT, "The hour with minute is too short for HHMM format.") \
+	X(HOUR_WITH_MINUTE_TOO_LONG, "The hour with minute is too long for HHMM format.") \
+	X(MMSS_INVALID_LENGTH, "The minutes with optional seconds has an incorrect length for either MMSS or MM format.") \
+	X(ILLEGAL_MONTH, "The date contains an illegal month of the year.") \
+	X(ILLEGAL_DAY, "The date contains an illegal day of the month.") \
+	X(ILLEGAL_HOUR, "The time contains an illegal hour.") \
+	X(ILLEGAL_MINUTE, "The time contains an illegal minute.") \
+	X(ILLEGAL_SECOND, "The time contains an illegal seconds.") \
+	X(INVALID_LENGTH_FOR_PIECE_OF_TOTAL, "The piece with total must have an even length, having equal-length components.") \
+	X(ZERO_PIECE_NUMBER, "The piece number must not have a value of zero.") \
+	X(ZERO_TOTAL_PIECES, "The piece total must not have a value of zero.") \
+	X(PIECE_NUMBER_EXCEEDS_TOTAL, "The piece number must not exceed the piece total.") \
+	X(INVALID_PERCENT_SEQUENCE, "The input contains an invalid percent hex-encoding \"%hh\" sequence.") \
+	X(COUPON_MISSING_FORMAT_CODE, "The coupon's Format Code is missing.") \
+	X(COUPON_INVALID_FORMAT_CODE, "The coupon's Format Code must be \"0\" or \"1\".") \
+	X(COUPON_MISSING_FUNDER_VLI, "The coupon's Funder VLI is missing.") \
+	X(COUPON_INVALID_FUNDER_LENGTH, "The coupon's Funder VLI must be \"0\" to \"6\".") \
+	X(COUPON_TRUNCATED_FUNDER, "The coupon's Funder is shorter than what is indicated by its VLI.") \
+	X(COUPON_TRUNCATED_OFFER_CODE, "The coupon's Offer Code is shorter than the required six digits.") \
+	X(COUPON_MISSING_SERIAL_NUMBER_VLI, "The coupon's Serial Number VLI is missing.") \
+	X(COUPON_TRUNCATED_SERIAL_NUMBER, "The coupon's Serial Number is shorter than what is indicated by its VLI.") \
+	X(COUPON_MISSING_GCP_VLI, "The coupon's primary GS1 Company Prefix VLI is missing.") \
+	X(COUPON_INVALID_GCP_LENGTH, "The coupon's primary GS1 Company Prefix VLI must be \"0\" to \"6\".") \
+	X(COUPON_TRUNCATED_GCP, "The coupon's primary GS1 Company Prefix is shorter than what is indicated by its VLI.") \
+	X(COUPON_MISSING_SAVE_VALUE_VLI, "The coupon's Save Value VLI is missing.") \
+	X(COUPON_INVALID_SAVE_VALUE_LENGTH, "The coupon's Save Value VLI must be \"1\" to \"5\".") \
+	X(COUPON_TRUNCATED_SAVE_VALUE, "The coupon's Save Value is shorter than what is indicated by its VLI.") \
+	X(COUPON_MISSING_1ST_PURCHASE_REQUIREMENT_VLI, "The coupon's primary purchase Requirement VLI is missing.") \
+	X(COUPON_INVALID_1ST_PURCHASE_REQUIREMENT_LENGTH, "The coupon's primary purchase Requirement VLI must be \"1\" to \"5\".") \
+	X(COUPON_TRUNCATED_1ST_PURCHASE_REQUIREMENT, "The coupon's primary purchase Requirement is shorter than what is indicated by its VLI.") \
+	X(COUPON_MISSING_1ST_PURCHASE_REQUIREMENT_CODE, "The coupon's primary purchase Requirement Code is missing.") \
+	X(COUPON_INVALID_1ST_PURCHASE_REQUIREMENT_CODE, "The coupon's primary purchase Requirement Code must be \"0\" to \"4\" or \"9\".") \
+	X(COUPON_TRUNCATED_1ST_PURCHASE_FAMILY_CODE, "The coupon's primary purchase Family Code is shorter than the required three digits.") \
+	X(COUPON_MISSING_ADDITIONAL_PURCHASE_RULES_CODE, "The coupon's Additional Purchase Rules Code is missing.") \
+	X(COUPON_INVALID_ADDITIONAL_PURCHASE_RULES_CODE, "The coupon's Additional Purchase Rules Code must be \"0\" to \"3\".") \
+	X(COUPON_MISSING_2ND_PURCHASE_REQUIREMENT_VLI, "The coupon's second purchase Requirement VLI is missing.") \
+	X(COUPON_INVALID_2ND_PURCHASE_REQUIREMENT_LENGTH, "The coupon's second purchase Requirement VLI must be \"1\" to \"5\".") \
+	X(COUPON_TRUNCATED_2ND_PURCHASE_REQUIREMENT, "The coupon's second purchase Requirement is shorter than what is indicated by its VLI.") \
+	X(COUPON_MISSING_2ND_PURCHASE_REQUIREMENT_CODE, "The coupon's second purchase Requirement Code is missing.") \
+	X(COUPON_INVALID_2ND_PURCHASE_REQUIREMENT_CODE, "The coupon's second purchase Requirement Code must be \"0\" to \"4\" or \"9\".") \
+	X(COUPON_TRUNCATED_2ND_PURCHASE_FAMILY_CODE, "The coupon's second purchase Family Code is shorter than the required three digits.") \
+	X(COUPON_MISSING_2ND_PURCHASE_GCP_VLI, "The coupon's second purchase GS1 Company Prefix VLI is missing.") \
+	X(COUPON_INVALID_2ND_PURCHASE_GCP_LENGTH, "The coupon's second purchase GS1 Company Prefix VLI must be \"0\" to \"6\" or \"9\".") \
+	X(COUPON_TRUNCATED_2ND_PURCHASE_GCP, "The coupon's second purchase GS1 Company Prefix is shorter than what is indicated by its VLI.") \
+	X(COUPON_MISSING_3RD_PURCHASE_REQUIREMENT_VLI, "The coupon's third purchase Requirement VLI is missing.") \
+	X(COUPON_INVALID_3RD_PURCHASE_REQUIREMENT_LENGTH, "The coupon's third purchase Requirement VLI must be \"1\" to \"5\".") \
+	X(COUPON_TRUNCATED_3RD_PURCHASE_REQUIREMENT, "The coupon's third purchase Requirement is shorter than what is indicated by its VLI.") \
+	X(COUPON_MISSING_3RD_PURCHASE_REQUIREMENT_CODE, "The coupon's third purchase Requirement Code is missing.") \
+	X(COUPON_INVALID_3RD_PURCHASE_REQUIREMENT_CODE, "The coupon's third purchase Requirement Code must be \"0\" to \"4\" or \"9\".") \
+	X(COUPON_TRUNCATED_3RD_PURCHASE_FAMILY_CODE, "The coupon's third purchase Family Code is shorter than the required three digits.") \
+	X(COUPON_MISSING_3RD_PURCHASE_GCP_VLI, "The coupon's third purchase GS1 Company Prefix VLI is missing.") \
+	X(COUPON_INVALID_3RD_PURCHASE_GCP_LENGTH, "The coupon's third purchase GS1 Company Prefix VLI must be \"0\" to \"6\" or \"9\".") \
+	X(COUPON_TRUNCATED_3RD_PURCHASE_GCP, "The coupon's third purchase GS1 Company Prefix is shorter than what is indicated by its VLI.") \
+	X(COUPON_TOO_SHORT_FOR_EXPIRATION_DATE, "The coupon's expiration date is too short for YYMMDD format.") \
+	X(COUPON_INVALID_EXIPIRATION_DATE, "The coupon's expiration date is invalid.") \
+	X(COUPON_TOO_SHORT_FOR_START_DATE, "The coupon's start date is too short to YYMMDD format.") \
+	X(COUPON_INVALID_START_DATE, "The coupon's start date is invalid.") \
+	X(COUPON_EXPIRATION_BEFORE_START, "The coupon's expiration date preceed the start date.") \
+	X(COUPON_MISSING_RETAILER_GCP_OR_GLN_VLI, "The coupon's Retailer GCP/GLN VLI is missing.") \
+	X(COUPON_INVALID_RETAILER_GCP_OR_GLN_LENGTH, "The coupon's Retailer GCP/GLN VLI must be \"1\" to \"7\".") \
+	X(COUPON_TRUNCATED_RETAILER_GCP_OR_GLN, "The coupon's Retailer GCP/GLN is shorter than what is indicated by its VLI.") \
+	X(COUPON_MISSING_SAVE_VALUE_CODE, "The coupon's Save Value Code is missing.") \
+	X(COUPON_INVALID_SAVE_VALUE_CODE, "The coupon's Save Value Code must be \"0\", \"1\", \"2\", \"5\" or \"6\".") \
+	X(COUPON_MISSING_SAVE_VALUE_APPLIES_TO_ITEM, "The coupon's Save Value Applies to Item is missing.") \
+	X(COUPON_INVALID_SAVE_VALUE_APPLIES_TO_ITEM, "The coupon's Save Value Applies to Item must be \"0\" to \"2\".") \
+	X(COUPON_MISSING_STORE_COUPON_FLAG, "The coupon's Store Coupon Flag is missing.") \
+	X(COUPON_MISSING_DONT_MULTIPLY_FLAG, "The coupon's Don't Multiply Flag is missing.") \
+	X(COUPON_INVALID_DONT_MULTIPLY_FLAG, "The coupon's Don't Multiply Flag must be \"0\" or \"1\".") \
+	X(COUPON_EXCESS_DATA, "The coupon contains excess data after the recognised optional fields.") \
+	X(UNUSED_1, "") \
+	X(INVALID_LATITUDE, "The latitude is outside of the range \"0000000000\" to \"1800000000\".") \
+	X(INVALID_LONGITUDE, "The longitude is outside of the range \"0000000000\" to \"3600000000\".") \
+	X(INVALID_MEDIA_TYPE, "A valid AIDC media type is required.") \
+	X(LATITUDE_INVALID_LENGTH, "The latitude must be 10 digits.") \
+	X(LONGITUDE_INVALID_LENGTH, "The longitude must be 10 digits.") \
+	X(INVALID_CSET64_CHARACTER, "A non-CSET 64 character was found where a CSET 64 character is expected.") \
+	X(INVALID_CSET64_PADDING, "Incorrect number of CSET 64 pad characters.") \
+	X(NOT_HYPHEN, "Only hyphens are permitted.") \
+	X(INVALID_BIOLOGICAL_SEX_CODE, "A valid ISO/IEC 5218 biological sex code required.") \
+	X(POSITION_IN_SEQUENCE_MALFORMED, "The data must have the format \"<pos>/<end>\".") \
+	X(POSITION_EXCEEDS_END, "The position number must not exceed the end number.") \
+	X(REQUIRES_NON_DIGIT_CHARACTER, "A non-digit character is required.") \
+	X(NOT_IN_CHARACTER_CLASS, "A character outside of the permitted character class was found.") \
+	X(COMPONENT_TOO_SHORT, "A component of the AI data is shorter than its specification permits.") \
+	X(DATA_TOO_LONG, "The AI data is longer than its specification permits.") \
+	X(ILLEGAL_NUL_CHARACTER, "The data contains a NUL character.")
+
+
+/*
+ * The messages are held as a single string blob, indexed by offset, in the
+ * same way as the linter names so that gs1_lint_err_msg() needs no
+ * relocation.
+ *
+ */
+static const struct lint_err_msgs_s {
+#define X(e, s) char e[sizeof(s)];
+	LINT_ERR_MSGS(X)
+#undef X
+} lint_err_msgs = {
+#define X(e, s) s,
+	LINT_ERR_MSGS(X)
+#undef X
+};
+
+static const uint16_t lint_err_msg_offsets[__GS1_LINTER_NUM_ERRS] = {
+#define X(e, s) offsetof(struct lint_err_msgs_s, e),
+	LINT_ERR_MSGS(X)
+#undef X
+};
+
+
+/*
+ * Deprecated table of pointers to the same strings, retained for ABI
+ * compatibility.
+ *
+ */
 GS1_SYNTAX_DICTIONARY_API const char *gs1_lint_err_str[__GS1_LINTER_NUM_ERRS] = {
-	"No issues were detected by the linter.",
-	"A non-digit character was found where a digit is expected.",
-	"A non-CSET 82 character was found where a CSET 82 character is expected.",
-	"A non-CSET 39 character was found where a CSET 39 character is expected.",
-	"A non-CSET 32 character was found where a CSET 32 character is expected.",
-	"The numeric check digit is incorrect.",
-	"The component is too short to perform a numeric check digit calculation.",
-	"The alphanumeric check-character pair are incorrect.",
-	"The component is too short to perform an alphanumeric check character pair calculation.",
-	"The component is too long to perform an alphanumeric check character pair calculation.",
-	"The data source for GCP lookups is offline.",
-	"The component is shorter than the minimum length GS1 Company Prefix.",
-	"The GS1 Company Prefix is invalid.",
-	"The Importer Index must be a single character.",
-	"The Importer Index is an invalid character.",
-	"A non-zero value is required.",
-	"A zero is required.",
-	"A zero prefix is not permitted.",
-	"A \"0\" or \"1\" is required.",
-	"The winding direction must be either \"0\", \"1\" or \"9\".",
-	"A valid ISO 3166 three-digit country code is required.",
-	"A valid ISO 3166 three-digit country code or \"999\" is required.",
-	"A valid ISO 3166 two-character country code is required.",
-	"A valid ISO 4217 three-digit currency code is required.",
-	"The IBAN is too short.",
-	"The IBAN contains an invalid character.",
-	"The IBAN must start with a valid ISO 3166 two-character country code.",
-	"The IBAN is invalid since the check characters are incorrect.",
-	"The date is too short.",
-	"The date is too long.",
-	"The date with hour is too short for YYMMDDHH format.",
-	"The date with hour is too long for YYMMDDHH format.",
-	"The hour with minute is too short for HHMM format.",
-	"The hour with minute is too long for HHMM format.",
-	"The minutes with optional seconds has an incorrect length for either MMSS or MM format.",
-	"The date contains an illegal month of the year.",
-	"The date contains an illegal day of the month.",
-	"The time contains an illegal hour.",
-	"The time contains an illegal minute.",
-	"The time contains an illegal seconds.",
-	"The piece with total must have an even length, having equal-length components.",
-	"The piece number must not have a value of zero.",
-	"The piece total must not have a value of zero.",
-	"The piece number must not exceed the piece total.",
-	"The input contains an invalid percent hex-encoding \"%hh\" sequence.",
-	"The coupon's Format Code is missing.",
-	"The coupon's Format Code must be \"0\" or \"1\".",
-	"The coupon's Funder VLI is missing.",
-	"The coupon's Funder VLI must be \"0\" to \"6\".",
-	"The coupon's Funder is shorter than what is indicated by its VLI.",
-	"The coupon's Offer Code is shorter than the required six digits.",
-	"The coupon's Serial Number VLI is missing.",
-	"The coupon's Serial Number is shorter than what is indicated by its VLI.",
-	"The coupon's primary GS1 Company Prefix VLI is missing.",
-	"The coupon's primary GS1 Company Prefix VLI must be \"0\" to \"6\".",
-	"The coupon's primary GS1 Company Prefix is shorter than what is indicated by its VLI.",
-	"The coupon's Save Value VLI is missing.",
-	"The coupon's Save Value VLI must be \"1\" to \"5\".",
-	"The coupon's Save Value is shorter than what is indicated by its VLI.",
-	"The coupon's primary purchase Requirement VLI is missing.",
-	"The coupon's primary purchase Requirement VLI must be \"1\" to \"5\".",
-	"The coupon's primary purchase Requirement is shorter than what is indicated by its VLI.",
-	"The coupon's primary purchase Requirement Code is missing.",
-	"The coupon's primary purchase Requirement Code must be \"0\" to \"4\" or \"9\".",
-	"The coupon's primary purchase Family Code is shorter than the required three digits.",
-	"The coupon's Additional Purchase Rules Code is missing.",
-	"The coupon's Additional Purchase Rules Code must be \"0\" to \"3\".",
-	"The coupon's second purchase Requirement VLI is missing.",
-	"The coupon's second purchase Requirement VLI must be \"1\" to \"5\".",
-	"The coupon's second purchase Requirement is shorter than what is indicated by its VLI.",
-	"The coupon's second purchase Requirement Code is missing.",
-	"The coupon's second purchase Requirement Code must be \"0\" to \"4\" or \"9\".",
-	"The coupon's second purchase Family Code is shorter than the required three digits.",
-	"The coupon's second purchase GS1 Company Prefix VLI is missing.",
-	"The coupon's second purchase GS1 Company Prefix VLI must be \"0\" to \"6\" or \"9\".",
-	"The coupon's second purchase GS1 Company Prefix is shorter than what is indicated by its VLI.",
-	"The coupon's third purchase Requirement VLI is missing.",
-	"The coupon's third purchase Requirement VLI must be \"1\" to \"5\".",
-	"The coupon's third purchase Requirement is shorter than what is indicated by its VLI.",
-	"The coupon's third purchase Requirement Code is missing.",
-	"The coupon's third purchase Requirement Code must be \"0\" to \"4\" or \"9\".",
-	"The coupon's third purchase Family Code is shorter than the required three digits.",
-	"The coupon's third purchase GS1 Company Prefix VLI is missing.",
-	"The coupon's third purchase GS1 Company Prefix VLI must be \"0\" to \"6\" or \"9\".",
-	"The coupon's third purchase GS1 Company Prefix is shorter than what is indicated by its VLI.",
-	"The coupon's expiration date is too short for YYMMDD format.",
-	"The coupon's expiration date is invalid.",
-	"The coupon's start date is too short to YYMMDD format.",
-	"The coupon's start date is invalid.",
-	"The coupon's expiration date preceed the start date.",
-	"The coupon's Retailer GCP/GLN VLI is missing.",
-	"The coupon's Retailer GCP/GLN VLI must be \"1\" to \"7\".",
-	"The coupon's Retailer GCP/GLN is shorter than what is indicated by its VLI.",
-	"The coupon's Save Value Code is missing.",
-	"The coupon's Save Value Code must be \"0\", \"1\", \"2\", \"5\" or \"6\".",
-	"The coupon's Save Value Applies to Item is missing.",
-	"The coupon's Save Value Applies to Item must be \"0\" to \"2\".",
-	"The coupon's Store Coupon Flag is missing.",
-	"The coupon's Don't Multiply Flag is missing.",
-	"The coupon's Don't Multiply Flag must be \"0\" or \"1\".",
-	"The coupon contains excess data after the recognised optional fields.",
-	"",	// Unused
-	"The latitude is outside of the range \"0000000000\" to \"1800000000\".",
-	"The longitude is outside of the range \"0000000000\" to \"3600000000\".",
-	"A valid AIDC media type is required.",
-	"The latitude must be 10 digits.",
-	"The longitude must be 10 digits.",
-	"A non-CSET 64 character was found where a CSET 64 character is expected.",
-	"Incorrect number of CSET 64 pad characters.",
-	"Only hyphens are permitted.",
-	"A valid ISO/IEC 5218 biological sex code required.",
-	"The data must have the format \"<pos>/<end>\".",
-	"The position number must not exceed the end number.",
-	"A non-digit character is required.",
+#define X(e, s) s,
+	LINT_ERR_MSGS(X)
+#undef X
 };
 
+
+/*
+ * Return the English description of a linter return code.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API const char* gs1_lint_err_msg(const gs1_lint_err_t err)
+{
+
+	if ((unsigned int)err >= __GS1_LINTER_NUM_ERRS)
+		return NULL;
+
+	return (const char *)&lint_err_msgs + lint_err_msg_offsets[err];
+
+}
+
 #endif  /* GS1_LINTER_ERR_STR_EN */
 
 
@@ -235,8 +290,9 @@ void test_name_function_map_is_sorted(void)
 
 	size_t i;
 
-	for (i = 1; i < sizeof(name_function_map) / sizeof(name_function_map[0]); i++) {
-		TEST_CHECK(strcmp(name_function_map[i].name, name_function_map[i-1].name) > 0);
+	for (i = 1; i < NUM_LINTERS; i++) {
+		TEST_CHECK(strcmp(LINTER_NAME(i), LINTER_NAME(i-1)) > 0);
+		TEST_CHECK(gs1_linter_from_name(LINTER_NAME(i)) == linter_function(i));
 	}
 
 }
@@ -247,4 +303,27 @@ void test_gs1_linter_from_name(void)
 	TEST_CHECK(gs1_linter_from_name("dummy") == NULL);
 }
 
+void test_gs1_lint_err_msg(void)
+{
+
+	static const gs1_lint_err_t errs[] = {
+#define X(e, s) GS1_LINTER_##e,
+		LINT_ERR_MSGS(X)
+#undef X
+	};
+	size_t i;
+
+	TEST_CHECK(sizeof(errs) / sizeof(errs[0]) == __GS1_LINTER_NUM_ERRS);
+
+	for (i = 0; i < __GS1_LINTER_NUM_ERRS; i++) {
+		TEST_CHECK(errs[i] == (gs1_lint_err_t)i);
+		TEST_CHECK(strcmp(gs1_lint_err_msg((gs1_lint_err_t)i), gs1_lint_err_str[i]) == 0);
+		TEST_CHECK(*gs1_lint_err_msg((gs1_lint_err_t)i) != '\0' || i == GS1_LINTER_UNUSED_1);
+	}
+
+	TEST_CHECK(strcmp(gs1_lint_err_msg(GS1_LINTER_OK), "No issues were detected by the linter.") == 0);
+	TEST_CHECK(gs1_lint_err_msg(__GS1_LINTER_NUM_ERRS) == NULL);
+
+}
+
 #endif  /* UNIT_TESTS */
@@ -38,6 +38,7 @@
 
 /// \cond
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -188,11 +189,23 @@ typedef enum
 	GS1_LINTER_POSITION_IN_SEQUENCE_MALFORMED,			///< The data must have the format "<pos>/<end>".
 	GS1_LINTER_POSITION_EXCEEDS_END,				///< The position number must not exceed the end number.
 	GS1_LINTER_REQUIRES_NON_DIGIT_CHARACTER,			///< A non-digit character is required
+	GS1_LINTER_NOT_IN_CHARACTER_CLASS,				///< A character outside of the permitted character class was found.
+	GS1_LINTER_COMPONENT_TOO_SHORT,					///< A component of the AI data is shorter than its specification permits.
+	GS1_LINTER_DATA_TOO_LONG,					///< The AI data is longer than its specification permits.
+	GS1_LINTER_ILLEGAL_NUL_CHARACTER,				///< The data contains a NUL character.
 	__GS1_LINTER_NUM_ERRS						//  Keep this as the last element which captures the size of this enumeration.
 } gs1_lint_err_t;
 
 
 #ifdef GS1_LINTER_ERR_STR_EN
+/**
+ * @brief Friendly English descriptions of the linter return codes, indexed by
+ * gs1_lint_err_t.
+ *
+ * @deprecated Retained for ABI compatibility purposes only. Use
+ * gs1_lint_err_msg() instead, which needs no load-time relocations.
+ *
+ */
 #ifdef __EMSCRIPTEN__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wignored-attributes"
@@ -211,6 +224,403 @@ GS1_SYNTAX_DICTIONARY_API extern const char *gs1_lint_err_str[];
 typedef gs1_lint_err_t (*gs1_linter_t)(const char *data, size_t *err_pos, size_t *err_len);
 
 
+/**
+ * @brief The result of validating one value of a batch, packed into 32 bits.
+ *
+ * Bits 0-7 hold the gs1_lint_err_t return code, bits 8-15 the error position,
+ * bits 16-23 the error length and bits 24-31 the GS1_LINT_RESULT_* flags. The
+ * position and length are zero when the code is #GS1_LINTER_OK.
+ *
+ * AI data is at most 90 characters, so a position or length only exceeds 255
+ * for overlong values, in which case it is clamped to 255 and
+ * #GS1_LINT_RESULT_CLAMPED is set.
+ *
+ * Unpack with the GS1_LINT_RESULT_CODE(), GS1_LINT_RESULT_POS(),
+ * GS1_LINT_RESULT_LEN() and GS1_LINT_RESULT_FLAGS() macros, or with
+ * gs1_lint_result_unpack().
+ *
+ */
+typedef uint32_t gs1_lint_result_t;
+
+#define GS1_LINT_RESULT_CLAMPED 0x01	///< The error position or length exceeded 255 and was clamped.
+
+#define GS1_LINT_RESULT_CODE(r)  ((gs1_lint_err_t)((r) & 0xff))	///< The return code of a packed result.
+#define GS1_LINT_RESULT_POS(r)   ((size_t)((r) >> 8 & 0xff))		///< The error position of a packed result.
+#define GS1_LINT_RESULT_LEN(r)   ((size_t)((r) >> 16 & 0xff))		///< The error length of a packed result.
+#define GS1_LINT_RESULT_FLAGS(r) ((unsigned int)((r) >> 24 & 0xff))	///< The flags of a packed result.
+
+
+/**
+ * @brief A view of an AI and its value within some larger buffer, such as an
+ * element string that has already been validated.
+ *
+ * Neither the AI nor the value is null-terminated.
+ *
+ */
+typedef struct {
+	const char *ai;		///< The AI digits, e.g. "01".
+	size_t ai_len;		///< The length of the AI.
+	const char *value;	///< The AI value.
+	size_t value_len;	///< The length of the AI value.
+} gs1_ai_view_t;
+
+
+/**
+ * @brief Type specification for functions that determine the length of the
+ * GS1 Company Prefix (GCP) at the start of a key.
+ *
+ * This is the counterpart of the GCP lookup hook of gs1_lint_key(), for
+ * conversions that need to know where the GCP ends rather than only that it
+ * is valid.
+ *
+ * `key` points to the `key_len` digits of a key beginning with the GCP, e.g.
+ * a GTIN-14 without its indicator digit, and is not null-terminated.
+ *
+ * Returns the length of the GCP, or 0 if the GCP is unknown.
+ *
+ */
+typedef size_t (*gs1_gcp_length_resolver_t)(void *ctx, const char *key, size_t key_len);
+
+
+/**
+ * @brief EPC schemes supported by the EPC conversion functions.
+ *
+ */
+typedef enum
+{
+	GS1_EPC_SGTIN_96 = 0,	///< SGTIN-96, from (01) and (21).
+	GS1_EPC_SSCC_96,	///< SSCC-96, from (00).
+	GS1_EPC_SGLN_96,	///< SGLN-96, from (414) and optional (254).
+} gs1_epc_scheme_t;
+
+
+/**
+ * @brief Return codes for the EPC conversion functions.
+ *
+ */
+typedef enum
+{
+	GS1_EPC_OK = 0,			///< The conversion succeeded.
+	GS1_EPC_MISSING_AI,		///< An AI required by the EPC scheme is missing.
+	GS1_EPC_INVALID_KEY,		///< The GS1 key is malformed or has an incorrect check digit.
+	GS1_EPC_INVALID_SERIAL,		///< The serial component cannot be encoded by the EPC scheme.
+	GS1_EPC_UNKNOWN_GCP,		///< The GCP length resolver did not recognise the GCP.
+	GS1_EPC_INVALID_GCP_LENGTH,	///< The GCP length is not supported by the EPC scheme.
+	GS1_EPC_INVALID_FILTER,		///< The filter value must be 0 to 7.
+	GS1_EPC_INVALID_HEADER,		///< The binary EPC header is not for a supported scheme.
+	GS1_EPC_INVALID_PARTITION,	///< The binary EPC partition value is invalid.
+	GS1_EPC_INVALID_ENCODING,	///< A binary EPC field has a value that is out of range.
+	GS1_EPC_BUFFER_TOO_SMALL,	///< The output buffer is too small.
+	GS1_EPC_INVALID_URI,		///< The EPC URI is malformed.
+} gs1_epc_err_t;
+
+
+/**
+ * @brief Forms of EPC URI.
+ *
+ */
+typedef enum
+{
+	GS1_EPC_URI_ID = 0,	///< Pure identity URI, e.g. "urn:epc:id:sgtin:...".
+	GS1_EPC_URI_TAG,	///< Tag URI for the 96-bit scheme, e.g. "urn:epc:tag:sgtin-96:...".
+} gs1_epc_uri_form_t;
+
+
+/**
+ * @brief Size of a buffer that is sufficient to hold the AI data decoded from
+ * any 96-bit EPC.
+ *
+ */
+#define GS1_EPC96_DECODE_BUF_LEN 48
+
+
+/**
+ * @brief Size of a buffer that is sufficient to hold any EPC URI, including
+ * its terminating null.
+ *
+ */
+#define GS1_EPC_URI_BUF_LEN 96
+
+
+/**
+ * @brief Size of a buffer that is sufficient to hold the AI data parsed from
+ * any EPC URI.
+ *
+ */
+#define GS1_EPC_URI_DECODE_BUF_LEN 48
+
+
+/**
+ * @brief A Syntax Dictionary loaded at run time with gs1_dict_load().
+ *
+ */
+typedef struct gs1_dict gs1_dict_t;
+
+
+/**
+ * @brief A holder for a dictionary that can be replaced while other threads
+ * are reading it, created with gs1_dict_live_create().
+ *
+ */
+typedef struct gs1_dict_live gs1_dict_live_t;
+
+
+/**
+ * @brief A thread that reads a #gs1_dict_live_t, registered with
+ * gs1_dict_reader_register().
+ *
+ */
+typedef struct gs1_dict_reader gs1_dict_reader_t;
+
+
+/**
+ * @brief Return codes for gs1_dict_load().
+ *
+ */
+typedef enum
+{
+	GS1_DICT_OK = 0,		///< The dictionary was loaded.
+	GS1_DICT_NO_MEMORY,		///< Memory could not be allocated.
+	GS1_DICT_INVALID_AI,		///< An entry has a malformed AI or AI range.
+	GS1_DICT_DUPLICATE_AI,		///< An AI is defined more than once.
+	GS1_DICT_INVALID_FLAGS,		///< An entry has malformed flags.
+	GS1_DICT_INVALID_SPEC,		///< An entry has a missing or malformed specification.
+	GS1_DICT_INVALID_ENTRY,		///< An entry is otherwise malformed.
+} gs1_dict_err_t;
+
+
+/**
+ * @brief Dictionary flag "*": the AI has a predefined length and does not
+ * require an FNC1 separator.
+ *
+ */
+#define GS1_DICT_FLAG_FIXED_LENGTH 0x01
+
+/**
+ * @brief Dictionary flag "?": the AI is a permitted GS1 Digital Link URI data
+ * attribute.
+ *
+ */
+#define GS1_DICT_FLAG_DL_ATTR 0x02
+
+
+/**
+ * @brief HRI flag: precede each AI with its title from the dictionary.
+ *
+ */
+#define GS1_HRI_TITLES 0x01
+
+/**
+ * @brief HRI flag: separate elements with newlines rather than spaces.
+ *
+ */
+#define GS1_HRI_LINES 0x02
+
+
+/**
+ * @brief GS1-128 planning flag: choose the order of the AIs that gives the
+ * shortest symbol.
+ *
+ */
+#define GS1_128_REORDER 0x01
+
+/**
+ * @brief Carrier estimation flag: also consider rectangular GS1 DataMatrix
+ * symbols.
+ *
+ */
+#define GS1_CARRIER_DM_RECT 0x02
+
+
+/**
+ * @brief QR Code error correction levels for gs1_carrier_estimate().
+ *
+ */
+typedef enum
+{
+	GS1_QR_EC_L = 0,		///< Recovers approximately 7% of the symbol.
+	GS1_QR_EC_M,			///< Recovers approximately 15% of the symbol.
+	GS1_QR_EC_Q,			///< Recovers approximately 25% of the symbol.
+	GS1_QR_EC_H,			///< Recovers approximately 30% of the symbol.
+} gs1_qr_ec_t;
+
+
+/**
+ * @brief The encoded length of a message in each carrier, and the smallest
+ * symbol that holds it, from gs1_carrier_estimate().
+ *
+ */
+typedef struct {
+	size_t gs1_128_chars;		///< GS1-128 symbol characters, including start, check and stop, or 0 if the data cannot be encoded.
+	size_t gs1_128_modules;		///< GS1-128 width in modules excluding quiet zones, or 0 if there are more than 48 data characters.
+	size_t dm_codewords;		///< GS1 DataMatrix data codewords in ASCII encodation.
+	unsigned int dm_rows;		///< Rows of the smallest DataMatrix symbol, or 0 if none fits.
+	unsigned int dm_cols;		///< Columns of the smallest DataMatrix symbol, or 0 if none fits.
+	size_t qr_bits;			///< GS1 QR Code data bits for the version qr_version, or for version 40 if none fits.
+	unsigned int qr_version;	///< Version of the smallest QR Code symbol, from 1 to 40, or 0 if none fits.
+} gs1_carrier_estimate_t;
+
+
+/**
+ * @brief Return codes for gs1_ai_dedup().
+ *
+ */
+typedef enum
+{
+	GS1_DUP_OK = 0,			///< No AI occurs with conflicting values.
+	GS1_DUP_CONFLICT,		///< An AI occurs more than once with different values.
+	GS1_DUP_UNKNOWN_AI,		///< An AI is malformed or not in the dictionary.
+	GS1_DUP_TOO_MANY_AIS,		///< The message has more than 65535 AIs.
+} gs1_dup_err_t;
+
+
+/**
+ * @brief An application profile compiled against a dictionary with
+ * gs1_profile_compile().
+ *
+ */
+typedef struct gs1_profile gs1_profile_t;
+
+
+/**
+ * @brief Return codes for gs1_ai_check_associations().
+ *
+ */
+typedef enum
+{
+	GS1_ASSOC_OK = 0,		///< All association rules are satisfied.
+	GS1_ASSOC_UNKNOWN_AI,		///< An AI is malformed or not in the dictionary.
+	GS1_ASSOC_REQUIRED_MISSING,	///< An AI is present without the AIs that its "req" attribute requires.
+	GS1_ASSOC_INVALID_PAIR,		///< An AI is present with an AI that its "ex" attribute excludes.
+	GS1_ASSOC_PROFILE_MISSING,	///< The AIs that the profile requires are not present.
+	GS1_ASSOC_PROFILE_EXCLUDED,	///< An AI that the profile excludes is present.
+} gs1_assoc_err_t;
+
+
+/**
+ * @brief A tracker of (01) GTIN + (21) serial number instance keys, created
+ * with gs1_uniq_create().
+ *
+ */
+typedef struct gs1_uniq gs1_uniq_t;
+
+
+/**
+ * @brief Results of gs1_uniq_insert().
+ *
+ */
+typedef enum
+{
+	GS1_UNIQ_NEW = 0,		///< The instance key has not been seen before, and is now recorded.
+	GS1_UNIQ_REPEAT,		///< The instance key has been seen before, as confirmed by the exact store.
+	GS1_UNIQ_PROBABLE_REPEAT,	///< The filter indicates that the instance key has been seen before, but there is no exact store to confirm it.
+	GS1_UNIQ_NO_KEY,		///< The message does not contain a well-formed (01) and (21).
+	GS1_UNIQ_FULL,			///< The tracker is at capacity, so the instance key could not be recorded.
+} gs1_uniq_result_t;
+
+
+/**
+ * @brief An allocator of SSCCs or GTIN + serial numbers, created with
+ * gs1_alloc_sscc_create() or gs1_alloc_gtin_serial_create().
+ *
+ */
+typedef struct gs1_alloc gs1_alloc_t;
+
+
+/**
+ * @brief Return codes for gs1_alloc_sscc_create() and
+ * gs1_alloc_gtin_serial_create().
+ *
+ */
+typedef enum
+{
+	GS1_ALLOC_OK = 0,		///< The allocator was created.
+	GS1_ALLOC_NO_MEMORY,		///< Memory could not be allocated.
+	GS1_ALLOC_INVALID_PREFIX,	///< The SSCC prefix or GTIN is malformed.
+	GS1_ALLOC_INVALID_RANGE,	///< The range is empty or exceeds the available digits.
+} gs1_alloc_err_t;
+
+
+/**
+ * @brief A block of serial references held by one thread for allocation
+ * from a shared allocator. Initialise with gs1_alloc_cursor_init(); the
+ * members are private.
+ *
+ */
+typedef struct
+{
+	uint64_t next;
+	uint64_t end;
+	uint32_t block_size;
+	uint32_t sum;
+	uint32_t width;
+	char digits[20];
+} gs1_alloc_cursor_t;
+
+
+/**
+ * @brief Size of buffer that is sufficient for any element string written by
+ * gs1_alloc_next(), including the terminating null.
+ *
+ */
+#define GS1_ALLOC_BUF_LEN 48
+
+
+/**
+ * @brief Return codes for gs1_gtin_normalise().
+ *
+ */
+typedef enum
+{
+	GS1_GTIN_OK = 0,			///< The GTIN is valid.
+	GS1_GTIN_INVALID_LENGTH,		///< The GTIN is not 8, 12, 13 or 14 digits.
+	GS1_GTIN_NON_DIGIT,			///< The GTIN contains a non-digit character.
+	GS1_GTIN_INCORRECT_CHECK_DIGIT,		///< The check digit is incorrect.
+	GS1_GTIN_INVALID_UPCE,			///< A UPC-E code does not have number system 0 or 1.
+} gs1_gtin_err_t;
+
+
+/**
+ * @brief GTIN normalisation flag: interpret 8-digit input as a zero-suppressed
+ * UPC-E code rather than as a GTIN-8.
+ *
+ */
+#define GS1_GTIN_UPCE 0x01
+
+
+/**
+ * @brief A character class: a set of byte values, held as a 256-bit mask,
+ * against which data can be validated with gs1_charclass_span() or
+ * gs1_lint_charclass().
+ *
+ * Initialise with gs1_charclass_init(), or copy a built-in class obtained
+ * with gs1_charclass_from_name(). The layout of the mask is private.
+ *
+ */
+typedef struct
+{
+	uint8_t mask[32];
+} gs1_charclass_t;
+
+
+/**
+ * @brief The reference linters, sorted by name, as X(name) for the linter
+ * gs1_lint_<name>().
+ *
+ * This is the single list from which both the name lookup of
+ * gs1_linter_from_name() and the C++ interface are generated.
+ *
+ */
+#define GS1_SYNTAX_DICTIONARY_LINTERS(X)					\
+	X(couponcode) X(couponposoffer) X(cset39) X(cset64) X(cset82)		\
+	X(csetnumeric) X(csum) X(csumalpha) X(hasnondigit) X(hhmm) X(hyphen)	\
+	X(iban) X(importeridx) X(iso3166) X(iso3166999) X(iso3166alpha2)	\
+	X(iso3166list) X(iso4217) X(iso5218) X(key) X(latitude) X(longitude)	\
+	X(mediatype) X(mmoptss) X(nonzero) X(nozeroprefix) X(pcenc)		\
+	X(pieceoftotal) X(posinseqslash) X(winding) X(yesno) X(yymmd0)		\
+	X(yymmdd) X(yymmddhh) X(yyyymmd0) X(yyyymmdd) X(zero)
+
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -253,8 +663,100 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_yyyymmd0(const char *data, siz
 GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_yyyymmdd(const char *data, size_t *err_pos, size_t *err_len);
 GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_zero(const char *data, size_t *err_pos, size_t *err_len);
 
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_csum_13(const char *data, size_t *err_pos, size_t *err_len);
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_csum_14(const char *data, size_t *err_pos, size_t *err_len);
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_csum_18(const char *data, size_t *err_pos, size_t *err_len);
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_yymmd0_6(const char *data, size_t *err_pos, size_t *err_len);
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_yymmdd_6(const char *data, size_t *err_pos, size_t *err_len);
+
 GS1_SYNTAX_DICTIONARY_API gs1_linter_t gs1_linter_from_name(const char *name);
 
+#ifdef GS1_LINTER_ERR_STR_EN
+/**
+ * @brief Returns a friendly English description of a linter return code.
+ *
+ * @param [in] err A linter return code.
+ *
+ * @return the description, or NULL if err is not a gs1_lint_err_t value.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API const char* gs1_lint_err_msg(gs1_lint_err_t err);
+#endif
+GS1_SYNTAX_DICTIONARY_API gs1_linter_t gs1_linter_from_name_and_length(const char *name, size_t len);
+
+GS1_SYNTAX_DICTIONARY_API void gs1_charclass_init(gs1_charclass_t *cc, const char *chars);
+GS1_SYNTAX_DICTIONARY_API void gs1_charclass_add_range(gs1_charclass_t *cc, unsigned char first, unsigned char last);
+GS1_SYNTAX_DICTIONARY_API const gs1_charclass_t *gs1_charclass_from_name(const char *name);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_charclass_span(const gs1_charclass_t *cc, const char *data, size_t len);
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_charclass(const gs1_charclass_t *cc, const char *data, size_t *err_pos, size_t *err_len);
+
+GS1_SYNTAX_DICTIONARY_API size_t gs1_lint_batch(gs1_linter_t linter, const char *data, const uint32_t *offsets, size_t count, int32_t *codes);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_lint_batch_results(gs1_linter_t linter, const char *data, const uint32_t *offsets, size_t count, gs1_lint_result_t *results);
+GS1_SYNTAX_DICTIONARY_API gs1_lint_result_t gs1_lint_result_pack(gs1_lint_err_t err, size_t err_pos, size_t err_len);
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_result_unpack(gs1_lint_result_t result, size_t *err_pos, size_t *err_len);
+
+GS1_SYNTAX_DICTIONARY_API gs1_epc_err_t gs1_epc_encode96(gs1_epc_scheme_t scheme, const gs1_ai_view_t *ais, size_t count, unsigned int filter, gs1_gcp_length_resolver_t resolver, void *ctx, uint8_t *epc);
+GS1_SYNTAX_DICTIONARY_API gs1_epc_err_t gs1_epc_decode96(const uint8_t *epc, gs1_epc_scheme_t *scheme, unsigned int *filter, char *buf, size_t buf_len, gs1_ai_view_t *ais, size_t *count);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_epc_encode96_batch(gs1_epc_scheme_t scheme, const gs1_ai_view_t *ais, const uint32_t *offsets, size_t count, unsigned int filter, gs1_gcp_length_resolver_t resolver, void *ctx, uint8_t *epcs, int32_t *codes);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_epc_decode96_batch(const uint8_t *epcs, size_t count, char *buf, gs1_ai_view_t *ais, size_t *ai_counts, int32_t *codes);
+GS1_SYNTAX_DICTIONARY_API gs1_epc_err_t gs1_epc_to_uri(gs1_epc_scheme_t scheme, gs1_epc_uri_form_t form, unsigned int filter, const gs1_ai_view_t *ais, size_t count, gs1_gcp_length_resolver_t resolver, void *ctx, char *uri, size_t uri_len, size_t *len);
+GS1_SYNTAX_DICTIONARY_API gs1_epc_err_t gs1_epc_from_uri(const char *uri, size_t uri_len, gs1_epc_scheme_t *scheme, gs1_epc_uri_form_t *form, unsigned int *filter, char *buf, size_t buf_len, gs1_ai_view_t *ais, size_t *count);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_epc_to_uri_batch(gs1_epc_scheme_t scheme, gs1_epc_uri_form_t form, unsigned int filter, const gs1_ai_view_t *ais, const uint32_t *offsets, size_t count, gs1_gcp_length_resolver_t resolver, void *ctx, char *out, size_t out_len, uint32_t *out_offsets, int32_t *codes);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_epc_from_uri_batch(const char *uris, const uint32_t *offsets, size_t count, char *buf, gs1_ai_view_t *ais, size_t *ai_counts, int32_t *codes);
+
+GS1_SYNTAX_DICTIONARY_API gs1_dict_err_t gs1_dict_load(const char *text, size_t len, gs1_dict_t **dict, size_t *err_line);
+GS1_SYNTAX_DICTIONARY_API gs1_dict_err_t gs1_dict_load_derived(const gs1_dict_t *base, const char *text, size_t len, gs1_dict_t **dict, size_t *err_line);
+GS1_SYNTAX_DICTIONARY_API void gs1_dict_free(gs1_dict_t *dict);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_dict_count(const gs1_dict_t *dict);
+GS1_SYNTAX_DICTIONARY_API int gs1_dict_find(const gs1_dict_t *dict, const char *ai, size_t ai_len);
+GS1_SYNTAX_DICTIONARY_API const char *gs1_dict_ai(const gs1_dict_t *dict, int entry);
+GS1_SYNTAX_DICTIONARY_API unsigned int gs1_dict_flags(const gs1_dict_t *dict, int entry);
+GS1_SYNTAX_DICTIONARY_API const char *gs1_dict_title(const gs1_dict_t *dict, int entry);
+GS1_SYNTAX_DICTIONARY_API const char *gs1_dict_spec(const gs1_dict_t *dict, int entry);
+GS1_SYNTAX_DICTIONARY_API const char *gs1_dict_attrs(const gs1_dict_t *dict, int entry);
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_dict_validate(const gs1_dict_t *dict, int entry, const char *data, size_t len, size_t *err_pos, size_t *err_len);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_dict_validate_batch(const gs1_dict_t *dict, int entry, const char *data, const uint32_t *offsets, size_t count, gs1_lint_result_t *results);
+
+GS1_SYNTAX_DICTIONARY_API gs1_dict_live_t *gs1_dict_live_create(gs1_dict_t *dict, size_t max_readers);
+GS1_SYNTAX_DICTIONARY_API void gs1_dict_live_free(gs1_dict_live_t *live);
+GS1_SYNTAX_DICTIONARY_API gs1_dict_err_t gs1_dict_live_swap(gs1_dict_live_t *live, gs1_dict_t *dict);
+GS1_SYNTAX_DICTIONARY_API gs1_dict_err_t gs1_dict_live_load(gs1_dict_live_t *live, const char *text, size_t len, size_t *err_line);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_dict_live_reclaim(gs1_dict_live_t *live);
+GS1_SYNTAX_DICTIONARY_API gs1_dict_reader_t *gs1_dict_reader_register(gs1_dict_live_t *live);
+GS1_SYNTAX_DICTIONARY_API void gs1_dict_reader_unregister(gs1_dict_reader_t *reader);
+GS1_SYNTAX_DICTIONARY_API const gs1_dict_t *gs1_dict_read_begin(gs1_dict_reader_t *reader);
+GS1_SYNTAX_DICTIONARY_API void gs1_dict_read_end(gs1_dict_reader_t *reader);
+
+GS1_SYNTAX_DICTIONARY_API gs1_dup_err_t gs1_ai_dedup(const gs1_dict_t *dict, gs1_ai_view_t *ais, size_t *count, size_t *pos, size_t *dup_pos);
+
+GS1_SYNTAX_DICTIONARY_API gs1_dict_err_t gs1_profile_compile(const gs1_dict_t *dict, const char *rules, size_t len, gs1_profile_t **profile);
+GS1_SYNTAX_DICTIONARY_API void gs1_profile_free(gs1_profile_t *profile);
+GS1_SYNTAX_DICTIONARY_API gs1_assoc_err_t gs1_ai_check_associations(const gs1_dict_t *dict, const gs1_ai_view_t *ais, size_t count, const gs1_profile_t *profile, size_t *pos);
+
+GS1_SYNTAX_DICTIONARY_API gs1_uniq_t *gs1_uniq_create(size_t capacity, const char *spill_path);
+GS1_SYNTAX_DICTIONARY_API void gs1_uniq_free(gs1_uniq_t *uniq);
+GS1_SYNTAX_DICTIONARY_API gs1_uniq_result_t gs1_uniq_insert(gs1_uniq_t *uniq, const gs1_ai_view_t *ais, size_t count);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_uniq_insert_batch(gs1_uniq_t *uniq, const gs1_ai_view_t *ais, const uint32_t *offsets, size_t count, uint8_t *results);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_uniq_count(const gs1_uniq_t *uniq);
+
+GS1_SYNTAX_DICTIONARY_API gs1_alloc_err_t gs1_alloc_sscc_create(const char *prefix, uint64_t first, uint64_t last, gs1_alloc_t **alloc);
+GS1_SYNTAX_DICTIONARY_API gs1_alloc_err_t gs1_alloc_gtin_serial_create(const char *gtin, uint64_t first, uint64_t last, gs1_alloc_t **alloc);
+GS1_SYNTAX_DICTIONARY_API void gs1_alloc_free(gs1_alloc_t *alloc);
+GS1_SYNTAX_DICTIONARY_API void gs1_alloc_cursor_init(gs1_alloc_cursor_t *cur, uint32_t block_size);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_alloc_next(gs1_alloc_t *alloc, gs1_alloc_cursor_t *cur, char *buf, size_t buf_len);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_alloc_batch(gs1_alloc_t *alloc, gs1_alloc_cursor_t *cur, size_t count, char *out, size_t out_len, uint32_t *out_offsets);
+
+GS1_SYNTAX_DICTIONARY_API gs1_gtin_err_t gs1_gtin_normalise(const char *gtin, size_t len, unsigned int flags, char *out, uint64_t *key);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_gtin_normalise_batch(const char *gtins, const uint32_t *offsets, size_t count, unsigned int flags, char *out, uint64_t *keys, uint8_t *codes);
+GS1_SYNTAX_DICTIONARY_API void gs1_gtin_from_key(uint64_t key, char *out);
+
+GS1_SYNTAX_DICTIONARY_API size_t gs1_hri_len(const gs1_ai_view_t *ais, size_t count, const gs1_dict_t *dict, unsigned int flags);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_hri_format(const gs1_ai_view_t *ais, size_t count, const gs1_dict_t *dict, unsigned int flags, char *buf, size_t buf_len);
+GS1_SYNTAX_DICTIONARY_API size_t gs1_hri_format_batch(const gs1_ai_view_t *ais, const uint32_t *offsets, size_t count, const gs1_dict_t *dict, unsigned int flags, char *out, size_t out_len, uint32_t *out_offsets);
+
+GS1_SYNTAX_DICTIONARY_API size_t gs1_128_plan(const gs1_ai_view_t *ais, size_t count, const gs1_dict_t *dict, unsigned int flags, size_t *order, uint8_t *codes, size_t codes_len);
+GS1_SYNTAX_DICTIONARY_API void gs1_carrier_estimate(const gs1_ai_view_t *ais, size_t count, const gs1_dict_t *dict, unsigned int flags, gs1_qr_ec_t ec, gs1_carrier_estimate_t *est);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,884 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Header-only C++17 interface to the reference linters.
+ *
+ * Each linter is addressed by a gs1::linter_id so that gs1::linter<Id> calls
+ * the corresponding C function directly rather than through a gs1_linter_t
+ * pointer, allowing the compiler to inline the call site. Data is accepted as
+ * std::string_view and the outcome is returned as a gs1::lint_result rather
+ * than through out-parameters.
+ *
+ * std::span overloads and compile-time evaluation of the pure linters (see
+ * gs1::ce) are provided when compiling as C++20, and std::expected returning
+ * variants when the library provides it (C++23).
+ *
+ */
+
+#ifndef GS1_SYNTAXDICTIONARY_HPP
+#define GS1_SYNTAXDICTIONARY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_lib_span) && __cpp_lib_span >= 202002L
+#include <span>
+#define GS1_SYNTAX_DICTIONARY_HAVE_SPAN
+#endif
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+#include <expected>
+#define GS1_SYNTAX_DICTIONARY_HAVE_EXPECTED
+#endif
+
+#include "gs1syntaxdictionary.h"
+#include "gs1syntaxdictionary-tables.h"
+
+
+namespace gs1 {
+
+/*
+ * Identifies each reference linter, in the order of
+ * GS1_SYNTAX_DICTIONARY_LINTERS.
+ *
+ */
+enum class linter_id {
+#define GS1_X(n) n,
+	GS1_SYNTAX_DICTIONARY_LINTERS(GS1_X)
+#undef GS1_X
+};
+
+inline constexpr std::size_t num_linters = 0
+#define GS1_X(n) + 1
+	GS1_SYNTAX_DICTIONARY_LINTERS(GS1_X)
+#undef GS1_X
+	;
+
+inline constexpr std::array<std::string_view, num_linters> linter_names = {
+#define GS1_X(n) #n,
+	GS1_SYNTAX_DICTIONARY_LINTERS(GS1_X)
+#undef GS1_X
+};
+
+
+/*
+ * Outcome of linting: the return code and, for errors, the position and
+ * length of the bad data.
+ *
+ */
+struct lint_result {
+	gs1_lint_err_t err = GS1_LINTER_OK;
+	std::size_t pos = 0;
+	std::size_t len = 0;
+
+	constexpr bool ok() const noexcept { return err == GS1_LINTER_OK; }
+	constexpr explicit operator bool() const noexcept { return ok(); }
+};
+
+
+namespace detail {
+
+/*
+ * The C linters require null-terminated data and the C API has no form that
+ * takes an explicit length, so views are copied into a stack buffer (which
+ * comfortably exceeds the length of any AI component), falling back to a
+ * std::string only for overlong data.
+ *
+ * Data must not contain embedded nulls.
+ *
+ */
+inline constexpr std::size_t stack_buf_len = 256;
+
+template<gs1_lint_err_t (*Fn)(const char *, std::size_t *, std::size_t *)>
+inline lint_result call(std::string_view data)
+{
+	lint_result r;
+	if (data.size() < stack_buf_len) {
+		char buf[stack_buf_len];
+		std::memcpy(buf, data.data(), data.size());
+		buf[data.size()] = '\0';
+		r.err = Fn(buf, &r.pos, &r.len);
+	} else {
+		const std::string s(data);
+		r.err = Fn(s.c_str(), &r.pos, &r.len);
+	}
+	return r;
+}
+
+}  // namespace detail
+
+
+/*
+ * Static dispatch: linter<linter_id::csum>::lint(data) calls gs1_lint_csum.
+ *
+ */
+template<linter_id Id>
+struct linter;
+
+#define GS1_X(n)								\
+template<>									\
+struct linter<linter_id::n> {							\
+	static constexpr linter_id id = linter_id::n;				\
+	static constexpr std::string_view name = #n;				\
+	static constexpr gs1_linter_t fn = gs1_lint_##n;			\
+	static lint_result lint(std::string_view data)				\
+	{									\
+		return detail::call<gs1_lint_##n>(data);			\
+	}									\
+};
+GS1_SYNTAX_DICTIONARY_LINTERS(GS1_X)
+#undef GS1_X
+
+
+/*
+ * Shorthand so that linters can be named as gs1::csum, etc.
+ *
+ */
+#define GS1_X(n) inline constexpr linter_id n = linter_id::n;
+GS1_SYNTAX_DICTIONARY_LINTERS(GS1_X)
+#undef GS1_X
+
+
+/*
+ * constexpr implementations of the linters that are pure functions of their
+ * input, for checking literal data (such as test fixtures, configured company
+ * prefixes or hardcoded GTINs) at compile time.
+ *
+ * Each produces exactly the same result as the corresponding C linter, which
+ * remains the reference implementation. The character sets, weights and ISO
+ * code tables are built from the same definitions as the C sources, in
+ * gs1syntaxdictionary-tables.h.
+ *
+ * The YY to YYYY horizon used by yymmd0 and yymmdd is based on CURRENT_YEAR,
+ * which must match the value used when building the library.
+ *
+ */
+namespace ce {
+
+#ifdef CURRENT_YEAR
+inline constexpr int current_year = CURRENT_YEAR;
+#else
+inline constexpr int current_year = 21;
+#endif
+
+namespace detail {
+
+inline constexpr std::string_view cset82 = GS1_SYNTAX_DICTIONARY_CSET82;
+inline constexpr std::string_view cset39 = GS1_SYNTAX_DICTIONARY_CSET39;
+inline constexpr std::string_view cset64 = GS1_SYNTAX_DICTIONARY_CSET64;
+inline constexpr std::string_view cset32 = GS1_SYNTAX_DICTIONARY_CSET32;
+inline constexpr std::string_view digits = GS1_SYNTAX_DICTIONARY_CSETNUMERIC;
+
+inline constexpr std::array<unsigned int, 97> primes = {
+	GS1_SYNTAX_DICTIONARY_CSUMALPHA_PRIMES
+};
+
+inline constexpr std::array<std::uint64_t, 16> iso3166 = {
+	GS1_SYNTAX_DICTIONARY_ISO3166_BITMAP
+};
+
+inline constexpr std::array<std::uint64_t, 11> iso3166alpha2 = {
+	GS1_SYNTAX_DICTIONARY_ISO3166ALPHA2_BITMAP
+};
+
+inline constexpr std::array<std::uint64_t, 16> iso4217 = {
+	GS1_SYNTAX_DICTIONARY_ISO4217_BITMAP
+};
+
+/*
+ * Equivalent of strspn(data, set).
+ *
+ */
+constexpr std::size_t span(std::string_view data, std::string_view set) noexcept
+{
+	std::size_t pos = 0;
+	while (pos < data.size() && set.find(data[pos]) != std::string_view::npos)
+		pos++;
+	return pos;
+}
+
+template<std::size_t N>
+constexpr bool bit(const std::array<std::uint64_t, N> &tbl, std::size_t v) noexcept
+{
+	return (tbl[v / 64] & (UINT64_C(0x8000000000000000) >> (v % 64))) != 0;
+}
+
+constexpr int xx(std::string_view data, std::size_t d) noexcept
+{
+	return (data[d] - '0') * 10 + (data[d+1] - '0');
+}
+
+constexpr lint_result cset(std::string_view data, std::string_view set, gs1_lint_err_t err) noexcept
+{
+	const std::size_t pos = span(data, set);
+	if (pos != data.size())
+		return { err, pos, 1 };
+	return {};
+}
+
+constexpr lint_result iso3(std::string_view data, const std::array<std::uint64_t, 16> &tbl, gs1_lint_err_t err) noexcept
+{
+	if (data.size() == 3 && span(data, digits) == 3 &&
+	    bit(tbl, static_cast<std::size_t>((data[0] - '0') * 100 + xx(data, 1))))
+		return {};
+	return { err, 0, data.size() };
+}
+
+}  // namespace detail
+
+constexpr lint_result csum(std::string_view data) noexcept
+{
+	std::size_t i = 0, pos = 0;
+	unsigned int weight = 1, parity = 0;
+
+	if (data.empty())
+		return { GS1_LINTER_TOO_SHORT_FOR_CHECK_DIGIT, 0, 0 };
+
+	if ((pos = detail::span(data, detail::digits)) != data.size())
+		return { GS1_LINTER_NON_DIGIT_CHARACTER, pos, 1 };
+
+	weight = data.size() % 2 == 0 ? 3 : 1;
+	for (i = 0; i < data.size() - 1; i++) {
+		parity += weight * static_cast<unsigned int>(data[i] - '0');
+		weight = 4 - weight;
+	}
+	parity = (10 - parity % 10) % 10;
+
+	if (static_cast<unsigned int>(data[i] - '0') != parity)
+		return { GS1_LINTER_INCORRECT_CHECK_DIGIT, i, 1 };
+
+	return {};
+}
+
+constexpr lint_result csumalpha(std::string_view data) noexcept
+{
+	const std::size_t len = data.size();
+	std::size_t i = 0, pos = 0;
+	unsigned int sum = 0;
+
+	if (len < 2)
+		return { GS1_LINTER_TOO_SHORT_FOR_CHECK_PAIR, 0, len };
+
+	if (len > detail::primes.size())
+		return { GS1_LINTER_TOO_LONG_FOR_CHECK_PAIR_IMPLEMENTATION, 0, len };
+
+	if ((pos = detail::span(data, detail::cset82)) < len - 2)
+		return { GS1_LINTER_INVALID_CSET82_CHARACTER, pos, 1 };
+
+	if ((pos = detail::span(data.substr(len - 2), detail::cset32)) != 2)
+		return { GS1_LINTER_INVALID_CSET32_CHARACTER, len - 2 + pos, 1 };
+
+	for (i = 0; i < len - 2; i++)
+		sum += static_cast<unsigned int>(detail::cset82.find(data[i])) * detail::primes[len - 3 - i];
+	sum %= 1021;
+
+	if (data[i] != detail::cset32[sum >> 5] || data[i+1] != detail::cset32[sum & 31])
+		return { GS1_LINTER_INCORRECT_CHECK_PAIR, len - 2, 2 };
+
+	return {};
+}
+
+constexpr lint_result cset39(std::string_view data) noexcept
+{
+	return detail::cset(data, detail::cset39, GS1_LINTER_INVALID_CSET39_CHARACTER);
+}
+
+constexpr lint_result cset82(std::string_view data) noexcept
+{
+	return detail::cset(data, detail::cset82, GS1_LINTER_INVALID_CSET82_CHARACTER);
+}
+
+constexpr lint_result csetnumeric(std::string_view data) noexcept
+{
+	return detail::cset(data, detail::digits, GS1_LINTER_NON_DIGIT_CHARACTER);
+}
+
+constexpr lint_result cset64(std::string_view data) noexcept
+{
+	std::size_t pads = 0, len = data.size(), pos = 0;
+
+	while (len > 0 && data[len-1] == '=') {
+		pads++;
+		len--;
+	}
+
+	if (pads > 2 || (pads > 0 && (len + pads) % 3 != 0))
+		return { GS1_LINTER_INVALID_CSET64_PADDING, len, pads };
+
+	if ((pos = detail::span(data, detail::cset64)) < len)
+		return { GS1_LINTER_INVALID_CSET64_CHARACTER, pos, 1 };
+
+	return {};
+}
+
+constexpr lint_result yyyymmd0(std::string_view data) noexcept
+{
+	constexpr std::array<int, 12> daysinmonth = { 31, 0, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	std::size_t pos = 0;
+	int yyyy = 0, mm = 0, maxdd = 0;
+
+	if (data.size() != 8)
+		return { data.size() < 8 ? GS1_LINTER_DATE_TOO_SHORT : GS1_LINTER_DATE_TOO_LONG, 0, data.size() };
+
+	if ((pos = detail::span(data, detail::digits)) != data.size())
+		return { GS1_LINTER_NON_DIGIT_CHARACTER, pos, 1 };
+
+	mm = detail::xx(data, 4);
+	if (mm < 1 || mm > 12)
+		return { GS1_LINTER_ILLEGAL_MONTH, 4, 2 };
+
+	yyyy = detail::xx(data, 0) * 100 + detail::xx(data, 2);
+	if (mm == 2)
+		maxdd = ((yyyy % 4 == 0 && yyyy % 100 != 0) || yyyy % 400 == 0) ? 29 : 28;
+	else
+		maxdd = daysinmonth[static_cast<std::size_t>(mm - 1)];
+
+	if (detail::xx(data, 6) > maxdd)	/* Permit "00" */
+		return { GS1_LINTER_ILLEGAL_DAY, 6, 2 };
+
+	return {};
+}
+
+constexpr lint_result yyyymmdd(std::string_view data) noexcept
+{
+	const lint_result r = yyyymmd0(data);
+	if (!r)
+		return r;
+
+	if (data[6] == '0' && data[7] == '0')
+		return { GS1_LINTER_ILLEGAL_DAY, 6, 2 };
+
+	return {};
+}
+
+constexpr lint_result yymmd0(std::string_view data) noexcept
+{
+	std::array<char, 8> yyyymmdd = {};
+	lint_result r;
+	std::size_t i = 0, pos = 0;
+	int yy = 0;
+
+	if (data.size() != 6)
+		return { data.size() < 6 ? GS1_LINTER_DATE_TOO_SHORT : GS1_LINTER_DATE_TOO_LONG, 0, data.size() };
+
+	if ((pos = detail::span(data, detail::digits)) != data.size())
+		return { GS1_LINTER_NON_DIGIT_CHARACTER, pos, 1 };
+
+	yy = detail::xx(data, 0);
+	if (yy - current_year >= 51) {
+		yyyymmdd[0] = '1'; yyyymmdd[1] = '9';
+	} else if (yy - current_year > -50) {
+		yyyymmdd[0] = '2'; yyyymmdd[1] = '0';
+	} else {
+		yyyymmdd[0] = '2'; yyyymmdd[1] = '1';
+	}
+	for (i = 0; i < 6; i++)
+		yyyymmdd[i + 2] = data[i];
+
+	r = yyyymmd0(std::string_view(yyyymmdd.data(), yyyymmdd.size()));
+	if (!r)
+		r.pos -= 2;
+
+	return r;
+}
+
+constexpr lint_result yymmdd(std::string_view data) noexcept
+{
+	const lint_result r = yymmd0(data);
+	if (!r)
+		return r;
+
+	if (data[4] == '0' && data[5] == '0')
+		return { GS1_LINTER_ILLEGAL_DAY, 4, 2 };
+
+	return {};
+}
+
+constexpr lint_result yymmddhh(std::string_view data) noexcept
+{
+	lint_result r;
+	std::size_t pos = 0;
+
+	if (data.size() != 8)
+		return { data.size() < 8 ? GS1_LINTER_DATE_WITH_HOUR_TOO_SHORT : GS1_LINTER_DATE_WITH_HOUR_TOO_LONG, 0, data.size() };
+
+	if ((pos = detail::span(data, detail::digits)) != data.size())
+		return { GS1_LINTER_NON_DIGIT_CHARACTER, pos, 1 };
+
+	r = yymmdd(data.substr(0, 6));
+	if (!r)
+		return r;
+
+	if (detail::xx(data, 6) > 23)
+		return { GS1_LINTER_ILLEGAL_HOUR, 6, 2 };
+
+	return {};
+}
+
+constexpr lint_result hhmm(std::string_view data) noexcept
+{
+	std::size_t pos = 0;
+
+	if (data.size() != 4)
+		return { data.size() < 4 ? GS1_LINTER_HOUR_WITH_MINUTE_TOO_SHORT : GS1_LINTER_HOUR_WITH_MINUTE_TOO_LONG, 0, data.size() };
+
+	if ((pos = detail::span(data, detail::digits)) != data.size())
+		return { GS1_LINTER_NON_DIGIT_CHARACTER, pos, 1 };
+
+	if (detail::xx(data, 0) > 23)
+		return { GS1_LINTER_ILLEGAL_HOUR, 0, 2 };
+
+	if (detail::xx(data, 2) > 59)
+		return { GS1_LINTER_ILLEGAL_MINUTE, 2, 2 };
+
+	return {};
+}
+
+constexpr lint_result mmoptss(std::string_view data) noexcept
+{
+	std::size_t pos = 0;
+
+	if (data.size() != 2 && data.size() != 4)
+		return { GS1_LINTER_MMSS_INVALID_LENGTH, 0, data.size() };
+
+	if ((pos = detail::span(data, detail::digits)) != data.size())
+		return { GS1_LINTER_NON_DIGIT_CHARACTER, pos, 1 };
+
+	if (detail::xx(data, 0) > 59)
+		return { GS1_LINTER_ILLEGAL_MINUTE, 0, 2 };
+
+	if (data.size() == 4 && detail::xx(data, 2) > 59)
+		return { GS1_LINTER_ILLEGAL_SECOND, 2, 2 };
+
+	return {};
+}
+
+constexpr lint_result iso3166(std::string_view data) noexcept
+{
+	return detail::iso3(data, detail::iso3166, GS1_LINTER_NOT_ISO3166);
+}
+
+constexpr lint_result iso3166999(std::string_view data) noexcept
+{
+	lint_result r;
+
+	if (data == "999")
+		return {};
+
+	r = iso3166(data);
+	if (!r)
+		r.err = GS1_LINTER_NOT_ISO3166_OR_999;
+
+	return r;
+}
+
+constexpr lint_result iso3166alpha2(std::string_view data) noexcept
+{
+	if (data.size() == 2 &&
+	    data[0] >= 'A' && data[0] <= 'Z' && data[1] >= 'A' && data[1] <= 'Z' &&
+	    detail::bit(detail::iso3166alpha2, static_cast<std::size_t>((data[0] - 'A') * 26 + (data[1] - 'A'))))
+		return {};
+	return { GS1_LINTER_NOT_ISO3166_ALPHA2, 0, data.size() };
+}
+
+constexpr lint_result iso4217(std::string_view data) noexcept
+{
+	return detail::iso3(data, detail::iso4217, GS1_LINTER_NOT_ISO4217);
+}
+
+}  // namespace ce
+
+
+/*
+ * List of linters that have a constexpr implementation, as X(name).
+ *
+ */
+#define GS1_SYNTAX_DICTIONARY_CONSTEXPR_LINTERS(X)				\
+	X(cset39) X(cset64) X(cset82) X(csetnumeric) X(csum) X(csumalpha)	\
+	X(hhmm) X(iso3166) X(iso3166999) X(iso3166alpha2) X(iso4217)		\
+	X(mmoptss) X(yymmd0) X(yymmdd) X(yymmddhh) X(yyyymmd0) X(yyyymmdd)
+
+template<linter_id Id>
+inline constexpr bool has_constexpr = false;
+
+#define GS1_X(n) template<> inline constexpr bool has_constexpr<linter_id::n> = true;
+GS1_SYNTAX_DICTIONARY_CONSTEXPR_LINTERS(GS1_X)
+#undef GS1_X
+
+template<linter_id Id>
+constexpr lint_result constexpr_lint(std::string_view data) noexcept
+{
+	static_assert(has_constexpr<Id>, "Linter has no constexpr implementation");
+#define GS1_X(n) if constexpr (Id == linter_id::n) return ce::n(data); else
+	GS1_SYNTAX_DICTIONARY_CONSTEXPR_LINTERS(GS1_X)
+#undef GS1_X
+	return {};
+}
+
+
+/*
+ * Convenience forms of the static dispatch.
+ *
+ * When compiling as C++20 these are usable in constant expressions for
+ * linters that have a constexpr implementation, e.g.
+ *
+ *   static_assert(gs1::valid<gs1::csum>("09521234543213"));
+ *
+ * Otherwise, and always at run time, the C linter is called.
+ *
+ */
+#if defined(__cpp_lib_is_constant_evaluated) && __cpp_lib_is_constant_evaluated >= 201811L
+#define GS1_SYNTAX_DICTIONARY_HAVE_CONSTEXPR_LINT
+
+template<linter_id Id>
+constexpr lint_result lint(std::string_view data)
+{
+	if constexpr (has_constexpr<Id>) {
+		if (std::is_constant_evaluated())
+			return constexpr_lint<Id>(data);
+	}
+	return linter<Id>::lint(data);
+}
+
+template<linter_id Id>
+constexpr bool valid(std::string_view data)
+{
+	return lint<Id>(data).ok();
+}
+
+#if defined(__cpp_consteval)
+
+/*
+ * A string_view that is only constructible from data that the linter accepts,
+ * otherwise compilation fails, e.g.
+ *
+ *   constexpr gs1::checked<gs1::csum> gtin = "09521234543213";
+ *
+ */
+template<linter_id Id>
+class checked {
+public:
+	consteval checked(const char *data) : data_(data)
+	{
+		if (!constexpr_lint<Id>(data_))
+			throw "Data is rejected by the linter";
+	}
+
+	constexpr std::string_view view() const noexcept { return data_; }
+	constexpr operator std::string_view() const noexcept { return data_; }
+
+private:
+	std::string_view data_;
+};
+
+#endif
+
+#else
+
+template<linter_id Id>
+inline lint_result lint(std::string_view data)
+{
+	return linter<Id>::lint(data);
+}
+
+template<linter_id Id>
+inline bool valid(std::string_view data)
+{
+	return linter<Id>::lint(data).ok();
+}
+
+#endif
+
+
+/*
+ * Dynamic dispatch for when the linter is only known at run time, e.g. having
+ * been read from the Syntax Dictionary.
+ *
+ */
+inline lint_result lint(linter_id id, std::string_view data)
+{
+	switch (id) {
+#define GS1_X(n) case linter_id::n: return linter<linter_id::n>::lint(data);
+	GS1_SYNTAX_DICTIONARY_LINTERS(GS1_X)
+#undef GS1_X
+	}
+	return lint_result{};
+}
+
+constexpr std::string_view name(linter_id id) noexcept
+{
+	return linter_names[static_cast<std::size_t>(id)];
+}
+
+constexpr std::optional<linter_id> linter_from_name(std::string_view name) noexcept
+{
+	std::size_t s = 0, e = num_linters;
+	while (s < e) {
+		const std::size_t m = s + (e - s) / 2;
+		if (linter_names[m] == name)
+			return static_cast<linter_id>(m);
+		if (linter_names[m] < name)
+			s = m + 1;
+		else
+			e = m;
+	}
+	return std::nullopt;
+}
+
+inline gs1_linter_t function(linter_id id) noexcept
+{
+	switch (id) {
+#define GS1_X(n) case linter_id::n: return gs1_lint_##n;
+	GS1_SYNTAX_DICTIONARY_LINTERS(GS1_X)
+#undef GS1_X
+	}
+	return nullptr;
+}
+
+
+#ifdef GS1_SYNTAX_DICTIONARY_HAVE_EXPECTED
+
+/*
+ * std::expected form, e.g. for monadic chaining of checks.
+ *
+ */
+template<linter_id Id>
+inline std::expected<void, lint_result> check(std::string_view data)
+{
+	const lint_result r = linter<Id>::lint(data);
+	if (!r)
+		return std::unexpected(r);
+	return {};
+}
+
+#endif
+
+
+/*
+ * Range helper: lint each element of a range of string-like values, writing
+ * a lint_result per element to the output iterator.
+ *
+ */
+template<linter_id Id, typename Range, typename OutputIt>
+inline OutputIt lint_each(const Range &values, OutputIt out)
+{
+	for (const auto &v : values)
+		*out++ = linter<Id>::lint(std::string_view(v));
+	return out;
+}
+
+
+/*
+ * Builds the packed data and offsets representation accepted by
+ * gs1_lint_batch().
+ *
+ */
+class batch {
+public:
+	batch() : offsets_{0} {}
+
+	template<typename Range>
+	explicit batch(const Range &values) : batch()
+	{
+		for (const auto &v : values)
+			add(std::string_view(v));
+	}
+
+	void add(std::string_view value)
+	{
+		data_.append(value);
+		offsets_.push_back(static_cast<std::uint32_t>(data_.size()));
+	}
+
+	void clear()
+	{
+		data_.clear();
+		offsets_.assign(1, 0);
+	}
+
+	std::size_t size() const noexcept { return offsets_.size() - 1; }
+	std::string_view data() const noexcept { return data_; }
+	const std::uint32_t *offsets() const noexcept { return offsets_.data(); }
+
+	std::string_view operator[](std::size_t i) const noexcept
+	{
+		return std::string_view(data_).substr(offsets_[i], offsets_[i+1] - offsets_[i]);
+	}
+
+private:
+	std::string data_;
+	std::vector<std::uint32_t> offsets_;
+};
+
+
+/*
+ * Batch forms, equivalent to gs1_lint_batch() and gs1_lint_batch_results()
+ * but calling the linter directly for each value rather than through a
+ * gs1_linter_t. Value i occupies data[offsets[i]] to data[offsets[i+1] - 1],
+ * and codes or results must have room for count (or values.size()) entries.
+ *
+ * A value containing a null is reported as GS1_LINTER_ILLEGAL_NUL_CHARACTER.
+ * std::bad_alloc is thrown, rather than SIZE_MAX returned, if a buffer for an
+ * overlong value cannot be allocated.
+ *
+ */
+namespace detail {
+
+template<gs1_lint_err_t (*Fn)(const char *, std::size_t *, std::size_t *)>
+inline lint_result call_checked(std::string_view data)
+{
+	const std::size_t nul = data.find('\0');
+	if (nul != std::string_view::npos)
+		return { GS1_LINTER_ILLEGAL_NUL_CHARACTER, nul, 1 };
+	return call<Fn>(data);
+}
+
+template<gs1_lint_err_t (*Fn)(const char *, std::size_t *, std::size_t *)>
+inline std::size_t lint_batch(std::string_view data, const std::uint32_t *offsets, std::size_t count, std::int32_t *codes)
+{
+	std::size_t fails = 0;
+	for (std::size_t i = 0; i < count; i++) {
+		const lint_result r = call_checked<Fn>(std::string_view(data.data() + offsets[i], offsets[i+1] - offsets[i]));
+		codes[i] = static_cast<std::int32_t>(r.err);
+		if (!r)
+			fails++;
+	}
+	return fails;
+}
+
+template<gs1_lint_err_t (*Fn)(const char *, std::size_t *, std::size_t *)>
+inline std::size_t lint_batch(std::string_view data, const std::uint32_t *offsets, std::size_t count, gs1_lint_result_t *results)
+{
+	std::size_t fails = 0;
+	for (std::size_t i = 0; i < count; i++) {
+		const lint_result r = call_checked<Fn>(std::string_view(data.data() + offsets[i], offsets[i+1] - offsets[i]));
+		results[i] = gs1_lint_result_pack(r.err, r.pos, r.len);
+		if (!r)
+			fails++;
+	}
+	return fails;
+}
+
+}  // namespace detail
+
+template<linter_id Id>
+inline std::size_t lint_batch(std::string_view data, const std::uint32_t *offsets, std::size_t count, std::int32_t *codes)
+{
+	return detail::lint_batch<linter<Id>::fn>(data, offsets, count, codes);
+}
+
+template<linter_id Id>
+inline std::size_t lint_batch(const batch &values, std::int32_t *codes)
+{
+	return lint_batch<Id>(values.data(), values.offsets(), values.size(), codes);
+}
+
+inline std::size_t lint_batch(linter_id id, std::string_view data, const std::uint32_t *offsets, std::size_t count, std::int32_t *codes)
+{
+	switch (id) {
+#define GS1_X(n) case linter_id::n: return lint_batch<linter_id::n>(data, offsets, count, codes);
+	GS1_SYNTAX_DICTIONARY_LINTERS(GS1_X)
+#undef GS1_X
+	}
+	return 0;
+}
+
+
+/*
+ * Forms writing a packed result that includes the error position and length
+ * for each value. unpack() recovers the lint_result.
+ *
+ */
+constexpr lint_result unpack(gs1_lint_result_t r) noexcept
+{
+	return lint_result{GS1_LINT_RESULT_CODE(r), GS1_LINT_RESULT_POS(r), GS1_LINT_RESULT_LEN(r)};
+}
+
+template<linter_id Id>
+inline std::size_t lint_batch(std::string_view data, const std::uint32_t *offsets, std::size_t count, gs1_lint_result_t *results)
+{
+	return detail::lint_batch<linter<Id>::fn>(data, offsets, count, results);
+}
+
+template<linter_id Id>
+inline std::size_t lint_batch(const batch &values, gs1_lint_result_t *results)
+{
+	return lint_batch<Id>(values.data(), values.offsets(), values.size(), results);
+}
+
+inline std::size_t lint_batch(linter_id id, std::string_view data, const std::uint32_t *offsets, std::size_t count, gs1_lint_result_t *results)
+{
+	switch (id) {
+#define GS1_X(n) case linter_id::n: return lint_batch<linter_id::n>(data, offsets, count, results);
+	GS1_SYNTAX_DICTIONARY_LINTERS(GS1_X)
+#undef GS1_X
+	}
+	return 0;
+}
+
+#ifdef GS1_SYNTAX_DICTIONARY_HAVE_SPAN
+
+/*
+ * std::span forms, which throw std::length_error if the output is too small
+ * for the number of values.
+ *
+ */
+template<linter_id Id>
+inline std::size_t lint_batch(std::string_view data, std::span<const std::uint32_t> offsets, std::span<std::int32_t> codes)
+{
+	const std::size_t count = offsets.empty() ? 0 : offsets.size() - 1;
+	if (codes.size() < count)
+		throw std::length_error("Codes span is smaller than the number of values");
+	return lint_batch<Id>(data, offsets.data(), count, codes.data());
+}
+
+template<linter_id Id>
+inline std::size_t lint_batch(const batch &values, std::span<std::int32_t> codes)
+{
+	if (codes.size() < values.size())
+		throw std::length_error("Codes span is smaller than the number of values");
+	return lint_batch<Id>(values, codes.data());
+}
+
+template<linter_id Id>
+inline std::size_t lint_batch(const batch &values, std::span<gs1_lint_result_t> results)
+{
+	if (results.size() < values.size())
+		throw std::length_error("Results span is smaller than the number of values");
+	return lint_batch<Id>(values, results.data());
+}
+
+#endif
+
+}  // namespace gs1
+
+
+#endif  /* GS1_SYNTAXDICTIONARY_HPP */
@@ -0,0 +1,340 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Normalisation of GTIN-8, GTIN-12 (UPC-A), GTIN-13 (EAN-13) and
+ * zero-suppressed UPC-E codes to the 14-digit form used with AI (01), e.g. for
+ * comparing product master data with scanned AI data.
+ *
+ * The digits are copied right-aligned into the output in a single pass that
+ * also accumulates the weighted sum for the check digit, as per the csum
+ * linter, and the value as an integer key. Since a GTIN has at most 14 digits,
+ * the key fits within 47 bits, and keys compare equal exactly when the
+ * normalised GTINs do.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+
+
+#define GTIN14_LEN 14
+
+
+/*
+ * Expands the 8 digits of a UPC-E code, being the number system, six
+ * digits and the check digit, into the 12 digits of the equivalent UPC-A.
+ *
+ */
+static void expand_upce(const char* const e, char* const a)
+{
+
+	const char d6 = e[6];
+
+	a[0] = e[0];
+	memset(a + 1, '0', 10);
+	a[11] = e[7];
+
+	switch (d6) {
+	case '0':
+	case '1':
+	case '2':
+		a[1] = e[1];
+		a[2] = e[2];
+		a[3] = d6;
+		memcpy(a + 8, e + 3, 3);
+		break;
+	case '3':
+		memcpy(a + 1, e + 1, 3);
+		memcpy(a + 9, e + 4, 2);
+		break;
+	case '4':
+		memcpy(a + 1, e + 1, 4);
+		a[10] = e[5];
+		break;
+	default:
+		memcpy(a + 1, e + 1, 5);
+		a[10] = d6;
+		break;
+	}
+
+}
+
+
+/*
+ * Writes the 14-digit form of a GTIN into out, without a terminating null.
+ *
+ */
+static gs1_gtin_err_t normalise(const char *gtin, size_t len, const unsigned int flags, char* const out, uint64_t* const key)
+{
+
+	char upca[12];
+	uint64_t k = 0;
+	unsigned int sum = 0, d;
+	size_t i;
+
+	if (len == 8 && (flags & GS1_GTIN_UPCE)) {
+		for (i = 0; i < 8; i++)
+			if (gtin[i] < '0' || gtin[i] > '9')
+				return GS1_GTIN_NON_DIGIT;
+		if (gtin[0] != '0' && gtin[0] != '1')
+			return GS1_GTIN_INVALID_UPCE;
+		expand_upce(gtin, upca);
+		gtin = upca;
+		len = 12;
+	}
+
+	if (len != 8 && len != 12 && len != 13 && len != 14)
+		return GS1_GTIN_INVALID_LENGTH;
+
+	memset(out, '0', GTIN14_LEN - len);
+
+	/*
+	 * Weights of 3 and 1 alternate leftwards from the digit preceding the
+	 * check digit, so the weight of the first digit depends only on the
+	 * parity of the length. The check digit itself has weight 1, giving a
+	 * total that is a multiple of 10 when it is correct.
+	 *
+	 */
+	for (i = 0; i < len; i++) {
+		d = (unsigned int)(unsigned char)gtin[i] - '0';
+		if (d > 9)
+			return GS1_GTIN_NON_DIGIT;
+		sum += (len - i) % 2 == 0 ? 3 * d : d;
+		k = k * 10 + d;
+		out[GTIN14_LEN - len + i] = gtin[i];
+	}
+
+	if (sum % 10 != 0)
+		return GS1_GTIN_INCORRECT_CHECK_DIGIT;
+
+	if (key) *key = k;
+
+	return GS1_GTIN_OK;
+
+}
+
+
+/**
+ * Normalise a GTIN-8, GTIN-12, GTIN-13 or GTIN-14 to 14 digits by padding it
+ * on the left with zeros, validating its check digit.
+ *
+ * With #GS1_GTIN_UPCE, an 8-digit input is instead taken to be a UPC-E code,
+ * consisting of the number system (0 or 1), six digits and the check digit,
+ * which is expanded to the equivalent GTIN-12.
+ *
+ * @param [in] gtin The GTIN, which need not be null-terminated.
+ * @param [in] len The length of the GTIN.
+ * @param [in] flags Either 0 or #GS1_GTIN_UPCE.
+ * @param [out] out Buffer of at least 15 characters that receives the
+ *                  null-terminated GTIN-14, or `NULL`.
+ * @param [out] key The GTIN-14 as an integer, if not `NULL`.
+ *
+ * @return #GS1_GTIN_OK if okay, otherwise the reason that the GTIN is
+ *         invalid.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_gtin_err_t gs1_gtin_normalise(const char* const gtin, const size_t len, const unsigned int flags,
+							    char* const out, uint64_t* const key)
+{
+
+	char buf[GTIN14_LEN];
+	gs1_gtin_err_t ret;
+
+	assert(gtin || len == 0);
+
+	if ((ret = normalise(gtin, len, flags, buf, key)) != GS1_GTIN_OK)
+		return ret;
+
+	if (out) {
+		memcpy(out, buf, GTIN14_LEN);
+		out[GTIN14_LEN] = '\0';
+	}
+
+	return GS1_GTIN_OK;
+
+}
+
+
+/**
+ * Normalise a batch of GTINs, as for gs1_gtin_normalise().
+ *
+ * GTIN i is gtins[offsets[i]] to gtins[offsets[i+1] - 1], so offsets has
+ * count + 1 entries. Its GTIN-14 is written to out[14 * i] to
+ * out[14 * i + 13], without a terminating null, its key to keys[i] and its
+ * #gs1_gtin_err_t to codes[i]. The GTIN-14 and key of an invalid GTIN are
+ * zero.
+ *
+ * @param [in] gtins The packed GTINs.
+ * @param [in] offsets The offsets of the GTINs.
+ * @param [in] count The number of GTINs.
+ * @param [in] flags Either 0 or #GS1_GTIN_UPCE.
+ * @param [out] out Buffer of 14 * count characters, or `NULL`.
+ * @param [out] keys Array of count keys, or `NULL`.
+ * @param [out] codes Array of count return codes.
+ *
+ * @return the number of invalid GTINs.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_gtin_normalise_batch(const char* const gtins, const uint32_t* const offsets, const size_t count,
+							  const unsigned int flags, char* const out, uint64_t* const keys, uint8_t* const codes)
+{
+
+	char buf[GTIN14_LEN];
+	char *o;
+	uint64_t key;
+	size_t i, fails = 0;
+	gs1_gtin_err_t ret;
+
+	assert(offsets);
+	assert(codes);
+
+	for (i = 0; i < count; i++) {
+		o = out ? out + i * GTIN14_LEN : buf;
+		ret = normalise(gtins + offsets[i], offsets[i+1] - offsets[i], flags, o, &key);
+		if (ret != GS1_GTIN_OK) {
+			memset(o, '0', GTIN14_LEN);
+			key = 0;
+			fails++;
+		}
+		if (keys)
+			keys[i] = key;
+		codes[i] = (uint8_t)ret;
+	}
+
+	return fails;
+
+}
+
+
+/**
+ * Convert a key from gs1_gtin_normalise() back into a GTIN-14.
+ *
+ * @param [in] key The key.
+ * @param [out] out Buffer of at least 15 characters that receives the
+ *                  null-terminated GTIN-14.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_gtin_from_key(uint64_t key, char* const out)
+{
+
+	int i;
+
+	assert(out);
+
+	for (i = GTIN14_LEN - 1; i >= 0; i--, key /= 10)
+		out[i] = (char)('0' + key % 10);
+	out[GTIN14_LEN] = '\0';
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#define TEST_NO_MAIN
+#include "acutest.h"
+
+
+void test_gtin_normalise(void)
+{
+
+	char out[15];
+	uint64_t key;
+
+#define NORM(g, f) gs1_gtin_normalise(g, strlen(g), f, out, &key)
+
+	TEST_CHECK(NORM("95012346", 0) == GS1_GTIN_OK && strcmp(out, "00000095012346") == 0 && key == UINT64_C(95012346));
+	TEST_CHECK(NORM("036000291452", 0) == GS1_GTIN_OK && strcmp(out, "00036000291452") == 0 && key == UINT64_C(36000291452));
+	TEST_CHECK(NORM("9521234543213", 0) == GS1_GTIN_OK && strcmp(out, "09521234543213") == 0);
+	TEST_CHECK(NORM("09521234543213", 0) == GS1_GTIN_OK && strcmp(out, "09521234543213") == 0 && key == UINT64_C(9521234543213));
+	TEST_CHECK(NORM("19521234543210", 0) == GS1_GTIN_OK && key == UINT64_C(19521234543210));
+	TEST_CHECK(gs1_lint_csum(out, NULL, NULL) == GS1_LINTER_OK);
+
+	TEST_CHECK(NORM("95012345", 0) == GS1_GTIN_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(NORM("036000291453", 0) == GS1_GTIN_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(NORM("09521234543214", 0) == GS1_GTIN_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(NORM("0952123454321", 0) == GS1_GTIN_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(NORM("0952123454321A", 0) == GS1_GTIN_NON_DIGIT);
+	TEST_CHECK(NORM("0952123454321/", 0) == GS1_GTIN_NON_DIGIT);
+	TEST_CHECK(NORM("9521234", 0) == GS1_GTIN_INVALID_LENGTH);
+	TEST_CHECK(NORM("095212345432130", 0) == GS1_GTIN_INVALID_LENGTH);
+	TEST_CHECK(NORM("", 0) == GS1_GTIN_INVALID_LENGTH);
+
+	/*
+	 * UPC-E, for each form of zero suppression.
+	 *
+	 */
+	TEST_CHECK(NORM("04252614", GS1_GTIN_UPCE) == GS1_GTIN_OK && strcmp(out, "00042100005264") == 0);
+	TEST_MSG("Got %s", out);
+	TEST_CHECK(NORM("01234133", GS1_GTIN_UPCE) == GS1_GTIN_OK && strcmp(out, "00012300000413") == 0);
+	TEST_MSG("Got %s", out);
+	TEST_CHECK(NORM("01234145", GS1_GTIN_UPCE) == GS1_GTIN_OK && strcmp(out, "00012340000015") == 0);
+	TEST_MSG("Got %s", out);
+	TEST_CHECK(NORM("01234565", GS1_GTIN_UPCE) == GS1_GTIN_OK && strcmp(out, "00012345000065") == 0);
+	TEST_MSG("Got %s", out);
+	TEST_CHECK(NORM("01234204", GS1_GTIN_UPCE) == GS1_GTIN_OK && strcmp(out, "00012000003424") == 0);
+	TEST_MSG("Got %s", out);
+	TEST_CHECK(NORM("01234144", GS1_GTIN_UPCE) == GS1_GTIN_INCORRECT_CHECK_DIGIT);
+	TEST_CHECK(NORM("21234565", GS1_GTIN_UPCE) == GS1_GTIN_INVALID_UPCE);
+	TEST_CHECK(NORM("0123456A", GS1_GTIN_UPCE) == GS1_GTIN_NON_DIGIT);
+	TEST_CHECK(NORM("95012346", GS1_GTIN_UPCE) == GS1_GTIN_INVALID_UPCE);
+	TEST_CHECK(NORM("036000291452", GS1_GTIN_UPCE) == GS1_GTIN_OK);
+
+	TEST_CHECK(gs1_gtin_normalise("9501234", 7, 0, NULL, NULL) == GS1_GTIN_INVALID_LENGTH);
+	TEST_CHECK(gs1_gtin_normalise("95012346", 8, 0, NULL, NULL) == GS1_GTIN_OK);
+
+	gs1_gtin_from_key(UINT64_C(95012346), out);
+	TEST_CHECK(strcmp(out, "00000095012346") == 0);
+	gs1_gtin_from_key(UINT64_C(19521234543210), out);
+	TEST_CHECK(strcmp(out, "19521234543210") == 0);
+
+#undef NORM
+
+}
+
+
+void test_gtin_normalise_batch(void)
+{
+
+	static const char gtins[] = "95012346" "036000291452" "95012345" "9521234543213" "04252614";
+	static const uint32_t offsets[] = { 0, 8, 20, 28, 41, 49 };
+	char out[5 * 14];
+	uint64_t keys[5];
+	uint8_t codes[5];
+
+	/*
+	 * The last is not a valid GTIN-8, only a valid UPC-E.
+	 *
+	 */
+	TEST_CHECK(gs1_gtin_normalise_batch(gtins, offsets, 5, 0, out, keys, codes) == 2);
+	TEST_CHECK(memcmp(out, "00000095012346" "00036000291452" "00000000000000" "09521234543213" "00000000000000", 70) == 0);
+	TEST_CHECK(keys[0] == UINT64_C(95012346) && keys[2] == 0 && keys[3] == UINT64_C(9521234543213));
+	TEST_CHECK(codes[0] == GS1_GTIN_OK && codes[2] == GS1_GTIN_INCORRECT_CHECK_DIGIT && codes[4] == GS1_GTIN_INCORRECT_CHECK_DIGIT);
+
+	TEST_CHECK(gs1_gtin_normalise_batch(gtins, offsets, 5, GS1_GTIN_UPCE, NULL, keys, codes) == 2);
+	TEST_CHECK(codes[0] == GS1_GTIN_INVALID_UPCE && keys[0] == 0);
+	TEST_CHECK(codes[4] == GS1_GTIN_OK && keys[4] == UINT64_C(42100005264));
+
+	TEST_CHECK(gs1_gtin_normalise_batch(gtins, offsets, 0, 0, NULL, NULL, codes) == 0);
+
+}
+
+#endif  /* UNIT_TESTS */
@@ -0,0 +1,314 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Human-readable interpretation (HRI) of AI data, e.g.
+ *
+ *   (01) 09521234543213 (17) 251231
+ *
+ * or, with titles from a loaded dictionary,
+ *
+ *   GTIN (01) 09521234543213 USE BY or EXPIRY (17) 251231
+ *
+ * Each element is assembled with memcpy after a single bounds check, with no
+ * formatting calls or allocation.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+#include "dictionary.h"
+
+
+/*
+ * Title of the AI, or NULL if there is none.
+ *
+ */
+static const char *title_of(const gs1_dict_t* const dict, const gs1_ai_view_t* const v, size_t* const len)
+{
+
+	const struct dict_entry *e;
+	unsigned int entry;
+	int key;
+
+	if (!dict || (key = gs1_dict_ai_key(v->ai, v->ai_len)) < 0 || (entry = DICT_INDEX(dict, key)) == 0)
+		return NULL;
+
+	e = DICT_ENTRY(dict, entry - 1);
+	if (e->title_len == 0)
+		return NULL;
+
+	*len = e->title_len;
+	return DICT_STR(dict, entry - 1, e->title);
+
+}
+
+
+/*
+ * Writes the HRI into out, which has room for cap characters, without a
+ * terminating null. Returns 0 if it does not fit.
+ *
+ */
+static int format_hri(const gs1_ai_view_t* const ais, const size_t count, const gs1_dict_t* const dict, const unsigned int flags,
+		      char* const out, const size_t cap, size_t* const len)
+{
+
+	const char sep = (flags & GS1_HRI_LINES) ? '\n' : ' ';
+	const char *title;
+	size_t i, pos = 0, title_len = 0, need;
+	char *q;
+
+	for (i = 0; i < count; i++) {
+
+		const gs1_ai_view_t * const v = &ais[i];
+
+		title = (flags & GS1_HRI_TITLES) ? title_of(dict, v, &title_len) : NULL;
+
+		/*
+		 * [sep] [title ' '] '(' ai ')' ' ' value
+		 *
+		 */
+		need = (i > 0) + (title ? title_len + 1 : 0) + v->ai_len + 3 + v->value_len;
+		if (need > cap - pos)
+			return 0;
+
+		q = out + pos;
+		if (i > 0)
+			*q++ = sep;
+		if (title) {
+			memcpy(q, title, title_len);
+			q += title_len;
+			*q++ = ' ';
+		}
+		*q++ = '(';
+		memcpy(q, v->ai, v->ai_len);
+		q += v->ai_len;
+		*q++ = ')';
+		*q++ = ' ';
+		memcpy(q, v->value, v->value_len);
+
+		pos += need;
+
+	}
+
+	*len = pos;
+	return 1;
+
+}
+
+
+/**
+ * Determine the size of buffer that is sufficient for the HRI of some AI
+ * data, including the terminating null.
+ *
+ * @param [in] ais The AI data.
+ * @param [in] count The number of AIs.
+ * @param [in] dict A dictionary providing titles, or `NULL`.
+ * @param [in] flags As for gs1_hri_format().
+ *
+ * @return the buffer size.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_hri_len(const gs1_ai_view_t* const ais, const size_t count, const gs1_dict_t* const dict, const unsigned int flags)
+{
+
+	size_t i, len = 1, title_len = 0;
+
+	assert(ais || count == 0);
+
+	for (i = 0; i < count; i++) {
+		len += (i > 0) + ais[i].ai_len + 3 + ais[i].value_len;
+		if ((flags & GS1_HRI_TITLES) && title_of(dict, &ais[i], &title_len))
+			len += title_len + 1;
+	}
+
+	return len;
+
+}
+
+
+/**
+ * Format AI data as bracketed HRI text, e.g. "(01) 09521234543213 (17) 251231".
+ *
+ * With #GS1_HRI_TITLES, each AI that has a title in the dictionary is
+ * preceded by it, e.g. "GTIN (01) 09521234543213". With #GS1_HRI_LINES, the
+ * elements are separated by newlines rather than spaces.
+ *
+ * The values are copied verbatim, so they should have been validated.
+ *
+ * @param [in] ais The AI data.
+ * @param [in] count The number of AIs.
+ * @param [in] dict A dictionary providing titles, or `NULL`.
+ * @param [in] flags A combination of #GS1_HRI_TITLES and #GS1_HRI_LINES.
+ * @param [out] buf Buffer that receives the null-terminated HRI. The size
+ *                  returned by gs1_hri_len() is always sufficient.
+ * @param [in] buf_len The size of buf.
+ *
+ * @return the length of the HRI, or SIZE_MAX if the buffer is too small.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_hri_format(const gs1_ai_view_t* const ais, const size_t count, const gs1_dict_t* const dict, const unsigned int flags,
+						char* const buf, const size_t buf_len)
+{
+
+	size_t len;
+
+	assert(ais || count == 0);
+	assert(buf);
+
+	if (buf_len == 0 || !format_hri(ais, count, dict, flags, buf, buf_len - 1, &len))
+		return SIZE_MAX;
+
+	buf[len] = '\0';
+	return len;
+
+}
+
+
+/**
+ * Format a batch of messages as HRI text.
+ *
+ * The AIs of message i are ais[offsets[i]] to ais[offsets[i+1] - 1], so
+ * offsets has count + 1 entries. The HRI texts are written end-to-end into
+ * out, without null terminators, with the HRI of message i occupying
+ * out[out_offsets[i]] to out[out_offsets[i+1] - 1], so out_offsets also has
+ * count + 1 entries. A message whose HRI does not fit in what remains of out
+ * yields an empty HRI. Since out_offsets are 32-bit, no more than UINT32_MAX
+ * bytes of out are used.
+ *
+ * @return the number of messages whose HRI did not fit.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_hri_format_batch(const gs1_ai_view_t* const ais, const uint32_t* const offsets, const size_t count,
+						      const gs1_dict_t* const dict, const unsigned int flags,
+						      char* const out, const size_t out_len, uint32_t* const out_offsets)
+{
+
+	const size_t avail = out_len < UINT32_MAX ? out_len : UINT32_MAX;
+	size_t i, pos = 0, len, fails = 0;
+
+	assert(offsets);
+	assert(out || out_len == 0);
+	assert(out_offsets);
+
+	out_offsets[0] = 0;
+
+	for (i = 0; i < count; i++) {
+		if (format_hri(&ais[offsets[i]], offsets[i+1] - offsets[i], dict, flags, out + pos, avail - pos, &len))
+			pos += len;
+		else
+			fails++;
+		out_offsets[i+1] = (uint32_t)pos;
+	}
+
+	return fails;
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#include "unittest.h"
+
+
+static const char test_dict[] =
+	"01         *?  N14,csum,key                  ex=02,255,37 dlpkey=22,10,21|235                    # GTIN\n"
+	"17         *?  N6,yymmd0                     req=01,02,255,8006,8026                             # USE BY or EXPIRY\n"
+	"3100-3105  *?  N6                            req=01,02 ex=310n                                   # NET WEIGHT (kg)\n"
+	"8010           Y..30,iso3166999\n";
+
+
+void test_hri_format(void)
+{
+
+	gs1_dict_t *dict;
+	gs1_ai_view_t ais[4];
+	char buf[128];
+	size_t len;
+
+	TEST_ASSERT(gs1_dict_load(test_dict, strlen(test_dict), &dict, NULL) == GS1_DICT_OK);
+
+	set_ai(&ais[0], "01", "09521234543213");
+	set_ai(&ais[1], "17", "251231");
+	set_ai(&ais[2], "3103", "000125");
+	set_ai(&ais[3], "99", "ABC");
+
+	TEST_CHECK((len = gs1_hri_format(ais, 2, NULL, 0, buf, sizeof(buf))) == 31);
+	TEST_CHECK(strcmp(buf, "(01) 09521234543213 (17) 251231") == 0);
+	TEST_MSG("Got %s", buf);
+	TEST_CHECK(gs1_hri_len(ais, 2, NULL, 0) == len + 1);
+
+	/*
+	 * Titles are only available with a dictionary.
+	 *
+	 */
+	TEST_CHECK(gs1_hri_format(ais, 2, NULL, GS1_HRI_TITLES, buf, sizeof(buf)) == 31);
+
+	TEST_CHECK((len = gs1_hri_format(ais, 4, dict, GS1_HRI_TITLES, buf, sizeof(buf))) != SIZE_MAX);
+	TEST_CHECK(strcmp(buf, "GTIN (01) 09521234543213 USE BY or EXPIRY (17) 251231 NET WEIGHT (kg) (3103) 000125 (99) ABC") == 0);
+	TEST_MSG("Got %s", buf);
+	TEST_CHECK(gs1_hri_len(ais, 4, dict, GS1_HRI_TITLES) == len + 1);
+
+	TEST_CHECK((len = gs1_hri_format(ais, 2, dict, GS1_HRI_TITLES | GS1_HRI_LINES, buf, sizeof(buf))) != SIZE_MAX);
+	TEST_CHECK(strcmp(buf, "GTIN (01) 09521234543213\nUSE BY or EXPIRY (17) 251231") == 0);
+	TEST_CHECK(gs1_hri_len(ais, 2, dict, GS1_HRI_TITLES | GS1_HRI_LINES) == len + 1);
+
+	TEST_CHECK(gs1_hri_format(ais, 4, dict, 0, buf, sizeof(buf)) == gs1_hri_len(ais, 4, dict, 0) - 1);
+	TEST_CHECK(strcmp(buf, "(01) 09521234543213 (17) 251231 (3103) 000125 (99) ABC") == 0);
+
+	TEST_CHECK(gs1_hri_format(ais, 0, dict, 0, buf, sizeof(buf)) == 0 && buf[0] == '\0');
+
+	/*
+	 * Exact fit, including the terminator.
+	 *
+	 */
+	TEST_CHECK(gs1_hri_format(ais, 2, NULL, 0, buf, 32) == 31);
+	TEST_CHECK(gs1_hri_format(ais, 2, NULL, 0, buf, 31) == SIZE_MAX);
+	TEST_CHECK(gs1_hri_format(ais, 0, NULL, 0, buf, 0) == SIZE_MAX);
+
+	gs1_dict_free(dict);
+
+}
+
+
+void test_hri_format_batch(void)
+{
+
+	gs1_ai_view_t ais[4];
+	static const uint32_t offsets[] = { 0, 2, 2, 4 };
+	uint32_t out_offsets[4];
+	char out[64];
+
+	set_ai(&ais[0], "01", "09521234543213");
+	set_ai(&ais[1], "17", "251231");
+	set_ai(&ais[2], "00", "095212345678901235");
+	set_ai(&ais[3], "99", "A");
+
+	TEST_CHECK(gs1_hri_format_batch(ais, offsets, 3, NULL, 0, out, sizeof(out), out_offsets) == 0);
+	TEST_CHECK(out_offsets[0] == 0 && out_offsets[1] == 31 && out_offsets[2] == 31 && out_offsets[3] == 61);
+	TEST_CHECK(memcmp(out, "(01) 09521234543213 (17) 251231(00) 095212345678901235 (99) A", 61) == 0);
+
+	TEST_CHECK(gs1_hri_format_batch(ais, offsets, 3, NULL, 0, out, 59, out_offsets) == 1);
+	TEST_CHECK(out_offsets[1] == 31 && out_offsets[2] == 31 && out_offsets[3] == 31);
+
+}
+
+#endif  /* UNIT_TESTS */
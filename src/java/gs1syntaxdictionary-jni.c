@@ -0,0 +1,167 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * JNI binding for the linters, backing the org.gs1.gs1syntaxdictionary Java
+ * package.
+ *
+ * The batch entry point operates directly on the memory of direct NIO
+ * buffers so that no Java strings are created and no Java arrays are copied
+ * when linting a batch of values.
+ *
+ */
+
+#include <jni.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+
+
+static void throw_illegal_argument(JNIEnv *env, const char* const msg)
+{
+	jclass cls = (*env)->FindClass(env, "java/lang/IllegalArgumentException");
+	if (cls)
+		(*env)->ThrowNew(env, cls, msg);
+}
+
+
+JNIEXPORT jlong JNICALL Java_org_gs1_gs1syntaxdictionary_GS1SyntaxDictionary_linterFromName(JNIEnv *env, jclass cls, jstring name)
+{
+
+	const char *str;
+	gs1_linter_t linter;
+
+	(void)cls;
+
+	if (!name)
+		return 0;
+
+	str = (*env)->GetStringUTFChars(env, name, NULL);
+	if (!str)
+		return 0;
+	linter = gs1_linter_from_name(str);
+	(*env)->ReleaseStringUTFChars(env, name, str);
+
+	return (jlong)(intptr_t)linter;
+
+}
+
+
+JNIEXPORT jint JNICALL Java_org_gs1_gs1syntaxdictionary_GS1SyntaxDictionary_lint(JNIEnv *env, jclass cls, jlong handle, jstring data)
+{
+
+	gs1_linter_t linter = (gs1_linter_t)(intptr_t)handle;
+	const char *str;
+	gs1_lint_err_t err;
+
+	(void)cls;
+
+	if (!linter || !data) {
+		throw_illegal_argument(env, "Invalid linter or data");
+		return -1;
+	}
+
+	str = (*env)->GetStringUTFChars(env, data, NULL);
+	if (!str)
+		return -1;
+	err = linter(str, NULL, NULL);
+	(*env)->ReleaseStringUTFChars(env, data, str);
+
+	return (jint)err;
+
+}
+
+
+/*
+ * The offsets and codes buffers are native-order int views, and all buffers
+ * are addressed from their start irrespective of their current position.
+ *
+ * The offsets are validated against the capacity of the data buffer since
+ * they are supplied by the Java caller.
+ *
+ * The codes buffer receives either the return codes or, when packed is set,
+ * the gs1_lint_result_t results.
+ *
+ */
+static jint lint_batch(JNIEnv *env, jlong handle, jobject data, jobject offsets, jint count, jobject codes, const int packed)
+{
+
+	gs1_linter_t linter = (gs1_linter_t)(intptr_t)handle;
+	const char *data_buf;
+	const uint32_t *offsets_buf;
+	int32_t *codes_buf;
+	jlong data_cap;
+	jint i;
+	size_t fails;
+
+	if (!linter || !data || !offsets || !codes || count < 0) {
+		throw_illegal_argument(env, "Invalid linter, buffers or count");
+		return -1;
+	}
+
+	data_buf = (const char *)(*env)->GetDirectBufferAddress(env, data);
+	offsets_buf = (const uint32_t *)(*env)->GetDirectBufferAddress(env, offsets);
+	codes_buf = (int32_t *)(*env)->GetDirectBufferAddress(env, codes);
+	if (!data_buf || !offsets_buf || !codes_buf) {
+		throw_illegal_argument(env, "Buffers must be direct");
+		return -1;
+	}
+
+	data_cap = (*env)->GetDirectBufferCapacity(env, data);
+	if ((*env)->GetDirectBufferCapacity(env, offsets) < (jlong)count + 1 ||
+	    (*env)->GetDirectBufferCapacity(env, codes) < (jlong)count) {
+		throw_illegal_argument(env, "Offsets or codes buffer is too small for count");
+		return -1;
+	}
+
+	for (i = 0; i < count; i++) {
+		if (offsets_buf[i] > offsets_buf[i+1] || (jlong)offsets_buf[i+1] > data_cap) {
+			throw_illegal_argument(env, "Offsets must be non-decreasing and within the data buffer");
+			return -1;
+		}
+	}
+
+	if (packed)
+		fails = gs1_lint_batch_results(linter, data_buf, offsets_buf, (size_t)count, (gs1_lint_result_t *)codes_buf);
+	else
+		fails = gs1_lint_batch(linter, data_buf, offsets_buf, (size_t)count, codes_buf);
+	if (fails == SIZE_MAX) {
+		jclass oom = (*env)->FindClass(env, "java/lang/OutOfMemoryError");
+		if (oom)
+			(*env)->ThrowNew(env, oom, "Unable to allocate buffer for overlong value");
+		return -1;
+	}
+
+	return (jint)fails;
+
+}
+
+
+JNIEXPORT jint JNICALL Java_org_gs1_gs1syntaxdictionary_GS1SyntaxDictionary_lintBatch(JNIEnv *env, jclass cls, jlong handle, jobject data, jobject offsets, jint count, jobject codes)
+{
+	(void)cls;
+	return lint_batch(env, handle, data, offsets, count, codes, 0);
+}
+
+
+JNIEXPORT jint JNICALL Java_org_gs1_gs1syntaxdictionary_GS1SyntaxDictionary_lintBatchResults(JNIEnv *env, jclass cls, jlong handle, jobject data, jobject offsets, jint count, jobject results)
+{
+	(void)cls;
+	return lint_batch(env, handle, data, offsets, count, results, 1);
+}
@@ -0,0 +1,152 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+package org.gs1.gs1syntaxdictionary;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
+
+
+/**
+ * Java binding for the GS1 Syntax Dictionary reference linters.
+ *
+ * Return codes are the numeric values of the C gs1_lint_err_t enumeration,
+ * with {@link #OK} indicating that no issues were detected.
+ */
+public final class GS1SyntaxDictionary {
+
+    static {
+        System.loadLibrary("gs1syntaxdictionary-jni");
+    }
+
+    /** Linter return code indicating that no issues were detected. */
+    public static final int OK = 0;
+
+    private GS1SyntaxDictionary() {}
+
+    /**
+     * A handle to a native linter function, obtained by name once and then
+     * reused for any number of calls.
+     */
+    public static final class Linter {
+
+        private final long handle;
+        private final String name;
+
+        private Linter(long handle, String name) {
+            this.handle = handle;
+            this.name = name;
+        }
+
+        public String getName() {
+            return name;
+        }
+
+    }
+
+    private static native long linterFromName(String name);
+    private static native int lint(long linter, String data);
+    private static native int lintBatch(long linter, ByteBuffer data, IntBuffer offsets, int count, IntBuffer codes);
+    private static native int lintBatchResults(long linter, ByteBuffer data, IntBuffer offsets, int count, IntBuffer results);
+
+    /**
+     * Look up a linter by the name used in the Syntax Dictionary, e.g. "csum".
+     *
+     * @throws IllegalArgumentException if there is no such linter.
+     */
+    public static Linter linter(String name) {
+        long handle = linterFromName(name);
+        if (handle == 0)
+            throw new IllegalArgumentException("Unknown linter: " + name);
+        return new Linter(handle, name);
+    }
+
+    /**
+     * Lint a single value. Convenient, but converts the String on each call;
+     * use {@link #lintBatch} for bulk processing.
+     */
+    public static int lint(Linter linter, String data) {
+        return lint(linter.handle, data);
+    }
+
+    /**
+     * Lint a batch of values that are packed end-to-end in a direct buffer.
+     *
+     * Value i occupies bytes offsets[i] to offsets[i+1] - 1 of data, so the
+     * offsets buffer holds count + 1 entries. The return code for value i is
+     * written to codes[i]. All buffers are addressed absolutely from index 0.
+     *
+     * The offsets and codes buffers must be direct int views in native byte
+     * order, e.g. ByteBuffer.allocateDirect(n * 4).order(ByteOrder.nativeOrder()).asIntBuffer().
+     *
+     * @return the number of values for which an error was reported.
+     */
+    public static int lintBatch(Linter linter, ByteBuffer data, IntBuffer offsets, int count, IntBuffer codes) {
+        if (!data.isDirect() || !offsets.isDirect() || !codes.isDirect())
+            throw new IllegalArgumentException("Buffers must be direct");
+        if (offsets.order() != ByteOrder.nativeOrder() || codes.order() != ByteOrder.nativeOrder())
+            throw new IllegalArgumentException("Offsets and codes buffers must be in native byte order");
+        if (codes.isReadOnly())
+            throw new IllegalArgumentException("Codes buffer must be writable");
+        return lintBatch(linter.handle, data, offsets, count, codes);
+    }
+
+    /**
+     * As {@link #lintBatch}, but the result for value i is written to
+     * results[i] packed into an int: the return code in bits 0-7, the error
+     * position in bits 8-15, the error length in bits 16-23 and flags in bits
+     * 24-31. Unpack with {@link #resultCode}, {@link #resultPos},
+     * {@link #resultLen} and {@link #resultFlags}.
+     *
+     * @return the number of values for which an error was reported.
+     */
+    public static int lintBatchResults(Linter linter, ByteBuffer data, IntBuffer offsets, int count, IntBuffer results) {
+        if (!data.isDirect() || !offsets.isDirect() || !results.isDirect())
+            throw new IllegalArgumentException("Buffers must be direct");
+        if (offsets.order() != ByteOrder.nativeOrder() || results.order() != ByteOrder.nativeOrder())
+            throw new IllegalArgumentException("Offsets and results buffers must be in native byte order");
+        if (results.isReadOnly())
+            throw new IllegalArgumentException("Results buffer must be writable");
+        return lintBatchResults(linter.handle, data, offsets, count, results);
+    }
+
+    /** Result flag indicating that the error position or length exceeded 255 and was clamped. */
+    public static final int RESULT_CLAMPED = 0x01;
+
+    /** The return code of a packed result. */
+    public static int resultCode(int result) {
+        return result & 0xff;
+    }
+
+    /** The error position of a packed result. */
+    public static int resultPos(int result) {
+        return (result >>> 8) & 0xff;
+    }
+
+    /** The error length of a packed result. */
+    public static int resultLen(int result) {
+        return (result >>> 16) & 0xff;
+    }
+
+    /** The flags of a packed result. */
+    public static int resultFlags(int result) {
+        return result >>> 24;
+    }
+
+}
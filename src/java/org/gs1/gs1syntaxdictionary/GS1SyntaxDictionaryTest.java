@@ -0,0 +1,123 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+package org.gs1.gs1syntaxdictionary;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
+import java.nio.charset.StandardCharsets;
+
+
+/**
+ * Unit tests for the JNI binding, run with "make test-jni".
+ */
+public final class GS1SyntaxDictionaryTest {
+
+    private static int failures = 0;
+
+    private static void check(boolean cond, String what) {
+        if (!cond) {
+            System.err.println("FAILED: " + what);
+            failures++;
+        }
+    }
+
+    private static IntBuffer intBuffer(int n) {
+        return ByteBuffer.allocateDirect(n * 4).order(ByteOrder.nativeOrder()).asIntBuffer();
+    }
+
+    public static void main(String[] args) {
+
+        GS1SyntaxDictionary.Linter csum = GS1SyntaxDictionary.linter("csum");
+
+        check(GS1SyntaxDictionary.lint(csum, "02345673") == GS1SyntaxDictionary.OK, "lint good");
+        check(GS1SyntaxDictionary.lint(csum, "12345673") != GS1SyntaxDictionary.OK, "lint bad");
+
+        try {
+            GS1SyntaxDictionary.linter("dummy");
+            check(false, "unknown linter");
+        } catch (IllegalArgumentException e) {
+        }
+
+        String[] values = { "02345673", "12345673", "", "416000336108", "4160003361O8" };
+        ByteBuffer data = ByteBuffer.allocateDirect(64);
+        IntBuffer offsets = intBuffer(values.length + 1);
+        IntBuffer codes = intBuffer(values.length);
+        int pos = 0;
+        offsets.put(0, 0);
+        for (int i = 0; i < values.length; i++) {
+            byte[] b = values[i].getBytes(StandardCharsets.US_ASCII);
+            data.position(pos);
+            data.put(b);
+            pos += b.length;
+            offsets.put(i + 1, pos);
+        }
+
+        int fails = GS1SyntaxDictionary.lintBatch(csum, data, offsets, values.length, codes);
+        check(fails == 3, "batch failure count");
+        check(codes.get(0) == GS1SyntaxDictionary.OK, "batch code 0");
+        check(codes.get(1) != GS1SyntaxDictionary.OK, "batch code 1");
+        check(codes.get(2) != GS1SyntaxDictionary.OK, "batch code 2");
+        check(codes.get(3) == GS1SyntaxDictionary.OK, "batch code 3");
+        check(codes.get(4) != GS1SyntaxDictionary.OK, "batch code 4");
+
+        IntBuffer results = intBuffer(values.length);
+        fails = GS1SyntaxDictionary.lintBatchResults(csum, data, offsets, values.length, results);
+        check(fails == 3, "batch results failure count");
+        check(results.get(0) == 0, "batch result 0");
+        check(GS1SyntaxDictionary.resultCode(results.get(1)) == codes.get(1), "batch result 1 code");
+        check(GS1SyntaxDictionary.resultPos(results.get(1)) == 7, "batch result 1 position");
+        check(GS1SyntaxDictionary.resultLen(results.get(1)) == 1, "batch result 1 length");
+        check(GS1SyntaxDictionary.resultCode(results.get(4)) == codes.get(4), "batch result 4 code");
+        check(GS1SyntaxDictionary.resultPos(results.get(4)) == 10, "batch result 4 position");
+        check(GS1SyntaxDictionary.resultFlags(results.get(4)) == 0, "batch result 4 flags");
+
+        GS1SyntaxDictionary.Linter iso3166 = GS1SyntaxDictionary.linter("iso3166");
+        ByteBuffer nulData = ByteBuffer.allocateDirect(8);
+        nulData.put("095\0XYZ".getBytes(StandardCharsets.US_ASCII));
+        IntBuffer nulOffsets = intBuffer(2);
+        nulOffsets.put(0, 0);
+        nulOffsets.put(1, 7);
+        fails = GS1SyntaxDictionary.lintBatchResults(iso3166, nulData, nulOffsets, 1, results);
+        check(fails == 1, "embedded NUL failure count");
+        check(GS1SyntaxDictionary.resultCode(results.get(0)) != GS1SyntaxDictionary.OK, "embedded NUL code");
+        check(GS1SyntaxDictionary.resultPos(results.get(0)) == 3, "embedded NUL position");
+
+        offsets.put(values.length, 1000);
+        try {
+            GS1SyntaxDictionary.lintBatch(csum, data, offsets, values.length, codes);
+            check(false, "offsets beyond data");
+        } catch (IllegalArgumentException e) {
+        }
+
+        try {
+            GS1SyntaxDictionary.lintBatch(csum, ByteBuffer.allocate(8), offsets, 0, codes);
+            check(false, "non-direct buffer");
+        } catch (IllegalArgumentException e) {
+        }
+
+        if (failures != 0) {
+            System.err.println(failures + " test(s) failed");
+            System.exit(1);
+        }
+        System.out.println("SUCCESS: All JNI tests have passed.");
+
+    }
+
+}
@@ -32,6 +32,7 @@
 #include <string.h>
 
 #include "gs1syntaxdictionary.h"
+#include "charclass.h"
 
 
 /**
@@ -55,22 +56,17 @@
 GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_cset39(const char* const data, size_t* const err_pos, size_t* const err_len)
 {
 
-	/*
-	 * All characters in "CSET 39", the 39 character alphabet.
-	 *
-	 */
-	static const char* const cset39 =
-		"#-/0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-
-	size_t pos;
+	size_t len, pos;
 
 	assert(data);
 
+	len = strlen(data);
+
 	/*
 	 * Any character outside of CSET 39 is illegal.
 	 *
 	 */
-	if ((pos = strspn(data, cset39)) != strlen(data)) {
+	if ((pos = gs1_charclass_span(&gs1_charclass_cset39, data, len)) != len) {
 		if (err_pos) *err_pos = pos;
 		if (err_len) *err_len = 1;
 		return GS1_LINTER_INVALID_CSET39_CHARACTER;
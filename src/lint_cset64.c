@@ -32,6 +32,7 @@
 #include <string.h>
 
 #include "gs1syntaxdictionary.h"
+#include "charclass.h"
 
 
 /**
@@ -56,15 +57,6 @@
 GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_cset64(const char* const data, size_t* const err_pos, size_t* const err_len)
 {
 
-	/*
-	 * All characters in "CSET 64", the 64 character alphabet.
-	 *
-	 */
-	static const char* const cset64 =
-		"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-		"abcdefghijklmnopqrstuvwxyz"
-		"0123456789-_";
-
 	size_t pads, len, pos;
 
 	assert(data);
@@ -87,7 +79,7 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_cset64(const char* const data,
 	 * In what remains, any character outside of CSET 64 is illegal.
 	 *
 	 */
-	if ((pos = strspn(data, cset64)) < len) {
+	if ((pos = gs1_charclass_span(&gs1_charclass_cset64, data, len)) < len) {
 		if (err_pos) *err_pos = pos;
 		if (err_len) *err_len = 1;
 		return GS1_LINTER_INVALID_CSET64_CHARACTER;
@@ -32,6 +32,7 @@
 #include <string.h>
 
 #include "gs1syntaxdictionary.h"
+#include "charclass.h"
 
 
 /**
@@ -55,23 +56,17 @@
 GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_cset82(const char* const data, size_t* const err_pos, size_t* const err_len)
 {
 
-	/*
-	 * All characters in "CSET 82", the 82 character alphabet.
-	 *
-	 */
-	static const char* const cset82 =
-		"!\"%&'()*+,-./0123456789:;<=>?ABCDEFGHIJKLMNOPQRS"
-		"TUVWXYZ_abcdefghijklmnopqrstuvwxyz";
-
-	size_t pos;
+	size_t len, pos;
 
 	assert(data);
 
+	len = strlen(data);
+
 	/*
 	 * Any character outside of CSET 82 is illegal.
 	 *
 	 */
-	if ((pos = strspn(data, cset82)) != strlen(data)) {
+	if ((pos = gs1_charclass_span(&gs1_charclass_cset82, data, len)) != len) {
 		if (err_pos) *err_pos = pos;
 		if (err_len) *err_len = 1;
 		return GS1_LINTER_INVALID_CSET82_CHARACTER;
@@ -28,6 +28,7 @@
 #include <string.h>
 
 #include "gs1syntaxdictionary.h"
+#include "charclass.h"
 
 
 /**
@@ -51,15 +52,17 @@
 GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_csetnumeric(const char* const data, size_t* const err_pos, size_t* const err_len)
 {
 
-	size_t pos;
+	size_t len, pos;
 
 	assert(data);
 
+	len = strlen(data);
+
 	/*
 	 * Any character outside the range '0' to '9' is illegal.
 	 *
 	 */
-	if ((pos = strspn(data, "0123456789")) != strlen(data)) {
+	if ((pos = gs1_charclass_span(&gs1_charclass_csetnumeric, data, len)) != len) {
 		if (err_pos) *err_pos = pos;
 		if (err_len) *err_len = 1;
 		return GS1_LINTER_NON_DIGIT_CHARACTER;
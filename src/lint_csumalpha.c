@@ -35,6 +35,8 @@
 #include <stdio.h>
 
 #include "gs1syntaxdictionary.h"
+#include "gs1syntaxdictionary-tables.h"
+#include "charclass.h"
 
 
 /**
@@ -77,30 +79,20 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_csumalpha(const char* const da
 	 *
 	 */
 	static const unsigned int primes[] = {
-		  2,   3,   5,   7,  11,  13,  17,  19,  23,  29,  31,  37,
-		 41,  43,  47,  53,  59,  61,  67,  71,  73,  79,  83,  89,
-		 97, 101, 103, 107, 109, 113, 127, 131, 137, 139, 149, 151,
-		157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223,
-		227, 229, 233, 239, 241, 251, 257, 263, 269, 271, 277, 281,
-		283, 293, 307, 311, 313, 317, 331, 337, 347, 349, 353, 359,
-		367, 373, 379, 383, 389, 397, 401, 409, 419, 421, 431, 433,
-		439, 443, 449, 457, 461, 463, 467, 479, 487, 491, 499, 503,
-		509
+		GS1_SYNTAX_DICTIONARY_CSUMALPHA_PRIMES
 	};
 
 	/*
 	 * Sequence of all characters in CSET 82, ordered by weight.
 	 *
 	 */
-	static const char* const cset82 =
-		"!\"%&'()*+,-./0123456789:;<=>?ABCDEFGHIJKLMNOPQRSTUVWXYZ_"
-		"abcdefghijklmnopqrstuvwxyz";
+	static const char* const cset82 = GS1_SYNTAX_DICTIONARY_CSET82;
 
 	/*
 	 * Sequence of all characters in CSET 32, ordered by weight.
 	 *
 	 */
-	static const char* const cset32 = "23456789ABCDEFGHJKLMNPQRSTUVWXYZ";
+	static const char* const cset32 = GS1_SYNTAX_DICTIONARY_CSET32;
 
 	size_t i, pos, len;
 	unsigned int sum = 0;
@@ -135,7 +127,7 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_csumalpha(const char* const da
 	 * Ensure that the data characters are in CSET 82
 	 *
 	 */
-	if ((pos = strspn(data, cset82)) < len - 2) {
+	if ((pos = gs1_charclass_span(&gs1_charclass_cset82, data, len - 2)) < len - 2) {
 		if (err_pos) *err_pos = pos;
 		if (err_len) *err_len = 1;
 		return GS1_LINTER_INVALID_CSET82_CHARACTER;
@@ -145,7 +137,7 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_csumalpha(const char* const da
 	 * Ensure that the check characters are in CSET 32
 	 *
 	 */
-	if ((pos = strspn(&data[len - 2], cset32)) != 2) {
+	if ((pos = gs1_charclass_span(&gs1_charclass_cset32, &data[len - 2], 2)) != 2) {
 		if (err_pos) *err_pos = len - 2 + pos;
 		if (err_len) *err_len = 1;
 		return GS1_LINTER_INVALID_CSET32_CHARACTER;
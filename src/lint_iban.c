@@ -32,6 +32,7 @@
 #include <stdio.h>
 
 #include "gs1syntaxdictionary.h"
+#include "charclass.h"
 
 
 #ifndef IBAN_MIN_LENGTH
@@ -69,8 +70,6 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_iban(const char* const data, s
 	const char *p;
 	unsigned int csum;
 
-	static const char* const csetiban = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-
 	assert(data);
 
 	len = strlen(data);
@@ -85,7 +84,7 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_iban(const char* const data, s
 	 * Any character outside of the set of valid IBAN characters is illegal.
 	 *
 	 */
-	if ((pos = strspn(data, csetiban)) != len) {
+	if ((pos = gs1_charclass_span(&gs1_charclass_iban, data, len)) != len) {
 		if (err_pos) *err_pos = pos;
 		if (err_len) *err_len = 1;
 		return GS1_LINTER_INVALID_IBAN_CHARACTER;
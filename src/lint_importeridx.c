@@ -34,6 +34,7 @@
 #include <string.h>
 
 #include "gs1syntaxdictionary.h"
+#include "charclass.h"
 
 
 /**
@@ -58,13 +59,6 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_importeridx(const char* const
 
 	size_t len;
 
-	/*
-	 * All valid Importer Index characters.
-	 *
-	 */
-	static const char* const importeridx =
-		"-0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz";
-
 	assert(data);
 
 	len = strlen(data);
@@ -80,11 +74,11 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_importeridx(const char* const
 	}
 
 	/*
-	 * Any character outside of the valid Importer Index character list is
-	 * illegal.
+	 * Any character outside of the valid Importer Index character list,
+	 * which is the same as CSET 64, is illegal.
 	 *
 	 */
-	if (strspn(data, importeridx) != len) {
+	if (gs1_charclass_span(&gs1_charclass_cset64, data, len) != len) {
 		if (err_pos) *err_pos = 0;
 		if (err_len) *err_len = 1;
 		return GS1_LINTER_INVALID_IMPORT_IDX_CHARACTER;
@@ -32,6 +32,7 @@
 #include <ctype.h>
 
 #include "gs1syntaxdictionary.h"
+#include "gs1syntaxdictionary-tables.h"
 
 
 /*
@@ -88,43 +89,11 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_iso3166(const char* const data
 	 *
 	 *  MAINTENANCE NOTE:
 	 *
-	 *  Updates to the ISO 3166 num-3 country code list are provided here:
-	 *
-	 *  https://isotc.iso.org/livelink/livelink?func=ll&objId=16944257&objAction=browse&viewType=1
+	 *  The list is maintained in gs1syntaxdictionary-tables.h.
 	 *
 	 */
 	static const uint64_t iso3166[] = {
-#if __STDC_VERSION__ >= 202311L
-		0b0000100010101000100010001000100110001000100010001011100010001000,  // 000-063: 004 008 010 012 016 020 024 028 031-032 036 040 044 048 050-052 056 060
-		0b1000101010101000000010100010100010001000100010001000100010001000,  // 064-127: 064 068 070 072 074 076 084 086 090 092 096 100 104 108 112 116 120 124
-		0b0000100010001000100010001000101000100010001000110010100010001001,  // 128-191: 132 136 140 144 148 152 156 158 162 166 170 174 175 178 180 184 188 191
-		0b1000100000011000100010100010001000100001111000110010001010100010,  // 192-255: 192 196 203-204 208 212 214 218 222 226 231-234 238-239 242 246 248 250 254
-		0b0010101000101010000110000000000010001000100010001000100010001000,  // 256-319: 258 260 262 266 268 270 275 276 288 292 296 300 304 308 312 316
-		0b1000100010001010100010001000100010001000100010001000100010001000,  // 320-383: 320 324 328 332 334 336 340 344 348 352 356 360 364 368 372 376 380
-		0b1000100010000010100010001010001001100010001010100010001010100010,  // 384-447: 384 388 392 398 400 404 408 410 414 417-418 422 426 428 430 434 438 440 442 446
-		0b0010001000100010001000100010001010001000000010001011100010001000,  // 448-511: 450 454 458 462 466 470 474 478 480 484 492 496 498-500 504 508
-		0b1000100010001000100101110000100000001000001000100010001000100010,  // 512-575: 512 516 520 524 528 531 533-535 540 548 554 558 562 566 570 574
-		0b0010110111100001000000101000100010001000100010001010001000100010,  // 576-639: 578 580 581 583 584 585 586 591 598 600 604 608 612 616 620 624 626 630 634 638
-		0b0011001000001010000110110010001000100010001000101010001000000011,  // 640-703: 642 643 646 652 654 659 660 662 663 666 670 674 678 682 686 688 690 694 702 703
-		0b1110001000001000000010001100100000001000100010001000100010101000,  // 704-767: 704 705 706 710 716 724 728 729 732 740 744 748 752 756 760 762 764
-		0b1000100010001000100010001001101010001001000000000010000000100001,  // 768-831: 768 772 776 780 784 788 792 795 796 798 800 804 807 818 826 831
-		0b1110000010000000001000100010101000000000000010000010000100000010,  // 832-895: 832 833 834 840 850 854 858 860 862 876 882 887 894
-		0b0000000000000000000000000000000000000000000000000000000000000000,  // 896-959:
-		0b0000000000000000000000000000000000000000000000000000000000000000,  // 960-999:
-#else
-		/*
-		 *  Fallback for compilers lacking binary literal support.
-		 *
-		 *  Generated from the above data with:
-		 *
-		 *     for (size_t i = 0; i < sizeof(iso3166) / sizeof(iso3166[0]); i++) { printf("%lx ", iso3166[i]); };
-		 *
-		 */
-		0x08a888898888b888, 0x8aa80a2888888888, 0x0888888a22232889, 0x88188a2221e322a2,
-		0x2a2a180088888888, 0x888a888888888888, 0x888288a2622a22a2, 0x222222228808b888,
-		0x8888970808222222, 0x2de102888888a222, 0x320a1b222222a203, 0xe20808c8088888a8,
-		0x8888889a89002021, 0xe080222a00082102, 0x0000000000000000, 0x0000000000000000,
-#endif
+		GS1_SYNTAX_DICTIONARY_ISO3166_BITMAP
 	};
 
 /// \cond
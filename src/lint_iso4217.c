@@ -32,6 +32,7 @@
 #include <ctype.h>
 
 #include "gs1syntaxdictionary.h"
+#include "gs1syntaxdictionary-tables.h"
 
 
 /*
@@ -89,44 +90,11 @@ GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_lint_iso4217(const char* const data
 	 *
 	 *  MAINTENANCE NOTE:
 	 *
-	 *  Updates to the ISO 4217 three-digit currency code list are provided
-	 *  here:
-	 *
-	 *  https://www.six-group.com/en/products-services/financial-information/data-standards.html
+	 *  The list is maintained in gs1syntaxdictionary-tables.h.
 	 *
 	 */
 	static const uint64_t iso4217[] = {
-#if __STDC_VERSION__ >= 202311L
-		0b0000000010001000000000000000000010001000000010001011100000001000,  // 000-063: 008 012 032 036 044 048 050-052 060
-		0b1000100010000000000010000010000010000000100010000000100000001000,  // 064-127: 064 068 072 084 090 096 104 108 116 124
-		0b0000100010000000100000001000100000000000001000100000000000001001,  // 128-191: 132 136 144 152 156 170 174 188 191-192
-		0b1000000000010000100000100000001000000010100000100010000000000000,  // 192-255: 192 203 208 214 222 230 232 238 242
-		0b0000001000000010000000000000000000001000000000000000000000000000,  // 256-319: 262 270 292
-		0b1000100010001000000010001000100010001000100010001000000010000000,  // 320-383: 320 324 328 332 340 344 348 352 356 360 364 368 376
-		0b0000100010000010100010001010001001100010001000100010000000000010,  // 384-447: 388 392 398 400 404 408 410 414 417-418 422 426 430 434 446
-		0b0000001000100010000000000000000010001000000000001010000010000000,  // 448-511: 454 458 462 480 484 496 498 504
-		0b1000100000001000000011000000000000001000001000100000001000000000,  // 512-575: 512 516 524 532-533 548 554 558 566
-		0b0010000000100010000000101000100010000000000000000000000000100000,  // 576-639: 578 586 590 598 600 604 608 634
-		0b0001001000000010000000000000000000000000001000000010001000000010,  // 640-703: 643 646 654 682 690 694 702
-		0b1010001000000000000000001000000000000000000010001000100010001000,  // 704-767: 704 706 710 728 748 752 756 760 764
-		0b0000000010001000100010000000000010000001000000000010000000100000,  // 768-831: 776 780 784 788 800 807 818 826
-		0b0010000010000000000000000010100000000000000000000010001000000000,  // 832-895: 834 840 858 860 882 886
-		0b0000010000000000000000000000110111111110101011011011111111011111,  // 896-959: 901 924-925 927-934 936 938 940-941 943-944 946-953 955-959
-		0b1111110111111101111111001110001000100101000000000000000000000000,  // 960-999: 960-965 967-973 975-981 984-986 990 994 997 999
-#else
-		/*
-		 *  Fallback for compilers lacking binary literal support.
-		 *
-		 *  Generated from the above data with:
-		 *
-		 *     for (size_t i = 0; i < sizeof(iso4217) / sizeof(iso4217[0]); i++) { printf("%lx ", iso4217[i]); };
-		 *
-		 */
-		0x008800008808b808, 0x8880082080880808, 0x0880808800220009, 0x8010820202822000,
-		0x0202000008000000, 0x8888088888888080, 0x088288a262222002, 0x022200008800a080,
-		0x88080c0008220200, 0x2022028880000020, 0x1202000000202202, 0xa200008000088888,
-		0x0088880081002020, 0x2080002800002200, 0x0400000dfeadbfdf, 0xfdfdfce225000000,
-#endif
+		GS1_SYNTAX_DICTIONARY_ISO4217_BITMAP
 	};
 
 /// \cond
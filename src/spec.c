@@ -0,0 +1,834 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Validation of AI data against the specification of a dictionary entry,
+ * e.g. "N13,csum,key [X..17]".
+ *
+ * A specification is a sequence of components, each having a character set
+ * (N, X, Y or Z), a fixed length such as "N6" or a range of lengths such as
+ * "X..20", and any number of linters, and each of which may be optional, e.g.
+ * "[N6]". In turn, each component takes as much of the remaining data as its
+ * maximum length permits, which must be at least its minimum length unless
+ * it is optional and no data remains. Its characters are checked against its
+ * character set and then its linters are applied. No data may remain at the
+ * end.
+ *
+ * When a dictionary is loaded each specification is compiled into a short
+ * program:
+ *
+ *   OPT skip           Skip the next component if no data remains
+ *   N|X|Y|Z min max    Take a component, checking its character set
+ *   LINT id            Apply a linter to the current component
+ *   END                Check that no data remains
+ *
+ * which is executed by a direct-threaded interpreter, using computed goto
+ * where the compiler supports it. The table of handlers holds offsets from
+ * one of them, rather than their addresses, so that it needs no relocations.
+ * Linters are resolved once when compiling, using the length-specialised
+ * kernels for fixed-length components.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gs1syntaxdictionary.h"
+#include "dictionary.h"
+#include "charclass.h"
+
+
+#if defined(__GNUC__) && !defined(SPEC_NO_THREADED)
+#define SPEC_THREADED
+#endif
+
+#define MAX_COMPONENT_LEN 99
+#define MAX_PROGRAM_LEN 512
+
+enum {
+	OP_END,
+	OP_OPT,
+	OP_N,
+	OP_X,
+	OP_Y,
+	OP_Z,
+	OP_LINT,
+};
+
+
+struct component {
+	char cset;			/* 'N', 'X', 'Y' or 'Z' */
+	int optional;
+	size_t min;
+	size_t max;
+	const char *linters;		/* Each preceded by "," */
+	const char *linters_end;
+};
+
+
+static const char *parse_number(const char *p, size_t* const n)
+{
+	for (*n = 0; *p >= '0' && *p <= '9' && *n <= MAX_COMPONENT_LEN; p++)
+		*n = *n * 10 + (size_t)(*p - '0');
+	return p;
+}
+
+
+/*
+ * Parses the component at p, returning the position after it, or NULL if it
+ * is malformed.
+ *
+ */
+static const char *parse_component(const char *p, struct component* const c)
+{
+
+	const char *q;
+
+	if ((c->optional = *p == '['))
+		p++;
+
+	if (*p != 'N' && *p != 'X' && *p != 'Y' && *p != 'Z')
+		return NULL;
+	c->cset = *p++;
+
+	q = p;
+	p = parse_number(p, &c->min);
+	if (p[0] == '.' && p[1] == '.') {
+		if (p == q)
+			c->min = 1;
+		q = p += 2;
+		p = parse_number(p, &c->max);
+	} else {
+		c->max = c->min;
+	}
+	if (p == q || c->min == 0 || c->max < c->min || c->max > MAX_COMPONENT_LEN)
+		return NULL;
+
+	if (c->optional && *p++ != ']')
+		return NULL;
+
+	c->linters = p;
+	while (*p == ',') {
+		for (q = ++p; (*p >= 'a' && *p <= 'z') || (*p >= '0' && *p <= '9'); p++);
+		if (p == q)
+			return NULL;
+	}
+	c->linters_end = p;
+
+	if (*p == ' ')
+		p++;
+	else if (*p != '\0')
+		return NULL;
+
+	return p;
+
+}
+
+
+/*
+ * The next linter name of a component, copied into name, or NULL once there
+ * are no more.
+ *
+ */
+static const char *next_linter(const char *p, const char* const end, char* const name, const size_t size)
+{
+
+	size_t n;
+
+	if (p >= end)
+		return NULL;
+
+	for (n = 0, p++; p < end && *p != ','; p++)
+		if (n < size - 1)
+			name[n++] = *p;
+	name[n] = '\0';
+
+	return p;
+
+}
+
+
+/*
+ * CSET 64 also constrains the padding, so its linter is applied, but to data
+ * that is null-terminated; an embedded NUL is reported as an invalid
+ * character.
+ *
+ */
+static gs1_lint_err_t check_cset64(const char* const buf, const size_t n, size_t* const pos, size_t* const len)
+{
+
+	const char *nul;
+	gs1_lint_err_t err;
+
+	if ((err = gs1_lint_cset64(buf, pos, len)) != GS1_LINTER_OK)
+		return err;
+
+	if ((nul = memchr(buf, '\0', n)) != NULL) {
+		*pos = (size_t)(nul - buf);
+		*len = 1;
+		return GS1_LINTER_INVALID_CSET64_CHARACTER;
+	}
+
+	return GS1_LINTER_OK;
+
+}
+
+
+static const gs1_charclass_t *cset_class(const char cset, gs1_lint_err_t* const err)
+{
+
+	switch (cset) {
+	case 'N':
+		*err = GS1_LINTER_NON_DIGIT_CHARACTER;
+		return &gs1_charclass_csetnumeric;
+	case 'X':
+		*err = GS1_LINTER_INVALID_CSET82_CHARACTER;
+		return &gs1_charclass_cset82;
+	case 'Y':
+		*err = GS1_LINTER_INVALID_CSET39_CHARACTER;
+		return &gs1_charclass_cset39;
+	default:
+		return NULL;
+	}
+
+}
+
+
+gs1_lint_err_t gs1_dict_spec_interpret(const char* const spec, const char* const data, const size_t len, size_t* const err_pos, size_t* const err_len)
+{
+
+	char buf[MAX_COMPONENT_LEN + 1], name[32];
+	struct component c;
+	const gs1_charclass_t *cc;
+	gs1_linter_t linter;
+	gs1_lint_err_t err = GS1_LINTER_OK;
+	const char *p = spec, *l;
+	size_t pos = 0, n, epos = 0, elen = 0;
+
+	assert(spec);
+	assert(data || len == 0);
+
+	while (*p) {
+
+		p = parse_component(p, &c);
+		assert(p);
+
+		if (c.optional && pos == len)
+			continue;
+
+		n = len - pos < c.max ? len - pos : c.max;
+		if (n < c.min) {
+			epos = pos;
+			elen = n;
+			err = GS1_LINTER_COMPONENT_TOO_SHORT;
+			goto out;
+		}
+
+		memcpy(buf, data + pos, n);
+		buf[n] = '\0';
+
+		if ((cc = cset_class(c.cset, &err)) != NULL) {
+			if ((epos = gs1_charclass_span(cc, buf, n)) != n) {
+				epos += pos;
+				elen = 1;
+				goto out;
+			}
+			err = GS1_LINTER_OK;
+		} else if ((err = check_cset64(buf, n, &epos, &elen)) != GS1_LINTER_OK) {
+			epos += pos;
+			goto out;
+		}
+
+		for (l = c.linters; (l = next_linter(l, c.linters_end, name, sizeof(name))) != NULL; ) {
+			linter = gs1_linter_from_name(name);
+			assert(linter);
+			if ((err = linter(buf, &epos, &elen)) != GS1_LINTER_OK) {
+				epos += pos;
+				goto out;
+			}
+		}
+
+		pos += n;
+
+	}
+
+	if (pos < len) {
+		epos = pos;
+		elen = len - pos;
+		err = GS1_LINTER_DATA_TOO_LONG;
+	}
+
+out:
+
+	if (err != GS1_LINTER_OK) {
+		if (err_pos) *err_pos = epos;
+		if (err_len) *err_len = elen;
+	}
+
+	return err;
+
+}
+
+
+static int linter_id(struct dict_code* const code, const gs1_linter_t linter, uint8_t* const id)
+{
+
+	gs1_linter_t *linters;
+	size_t i;
+
+	for (i = 0; i < code->num_linters && code->linters[i] != linter; i++);
+
+	if (i == code->num_linters) {
+		if (i > UINT8_MAX || (linters = realloc(code->linters, (i + 1) * sizeof(*linters))) == NULL)
+			return 0;
+		linters[i] = linter;
+		code->linters = linters;
+		code->num_linters++;
+	}
+
+	*id = (uint8_t)i;
+	return 1;
+
+}
+
+
+gs1_dict_err_t gs1_dict_compile_spec(struct dict_code* const code, const char* const spec, uint32_t* const off)
+{
+
+	static const char csets[] = "NXYZ";
+	uint8_t prog[MAX_PROGRAM_LEN];
+	char name[32];
+	struct component c;
+	gs1_linter_t linter;
+	const char *p = spec, *l;
+	size_t n = 0, opt = 0;
+
+	while (*p) {
+
+		if ((p = parse_component(p, &c)) == NULL)
+			return GS1_DICT_INVALID_SPEC;
+
+		if (n + 6 > sizeof(prog))
+			return GS1_DICT_INVALID_SPEC;
+
+		if (c.optional) {
+			prog[n++] = OP_OPT;
+			opt = n++;
+		}
+		prog[n++] = (uint8_t)(OP_N + (strchr(csets, c.cset) - csets));
+		prog[n++] = (uint8_t)c.min;
+		prog[n++] = (uint8_t)c.max;
+
+		for (l = c.linters; (l = next_linter(l, c.linters_end, name, sizeof(name))) != NULL; ) {
+			linter = c.min == c.max ? gs1_linter_from_name_and_length(name, c.min) : gs1_linter_from_name(name);
+			if (!linter || n + 3 > sizeof(prog))
+				return GS1_DICT_INVALID_SPEC;
+			prog[n++] = OP_LINT;
+			if (!linter_id(code, linter, &prog[n++]))
+				return GS1_DICT_NO_MEMORY;
+		}
+
+		if (c.optional)
+			prog[opt] = (uint8_t)(n - opt - 1);
+
+	}
+	prog[n++] = OP_END;
+
+	if (code->len + n > code->cap) {
+		size_t cap = code->cap ? code->cap * 2 : 1024;
+		uint8_t *buf;
+		while (cap < code->len + n)
+			cap *= 2;
+		if (cap > UINT32_MAX || (buf = realloc(code->code, cap)) == NULL)
+			return GS1_DICT_NO_MEMORY;
+		code->code = buf;
+		code->cap = cap;
+	}
+
+	*off = (uint32_t)code->len;
+	memcpy(code->code + code->len, prog, n);
+	code->len += n;
+
+	return GS1_DICT_OK;
+
+}
+
+
+void gs1_dict_free_code(struct dict_code* const code)
+{
+	free(code->code);
+	free(code->linters);
+	memset(code, 0, sizeof(*code));
+}
+
+
+/*
+ * The handler for each opcode, either a label or a case.
+ *
+ */
+#ifdef SPEC_THREADED
+#define HANDLER(op) (int)__extension__ (&&op - &&OP_END)
+#define NEXT __extension__ ({ goto *(&&OP_END + handlers[*pc++]); })
+#define CASE(op) op
+#else
+#define NEXT continue
+#define CASE(op) case op
+#endif
+
+static gs1_lint_err_t run(const struct dict_code* const code, const uint8_t *pc, const char* const data, const size_t len,
+			  size_t* const err_pos, size_t* const err_len)
+{
+
+#ifdef SPEC_THREADED
+	static const int handlers[] = {
+		HANDLER(OP_END), HANDLER(OP_OPT), HANDLER(OP_N), HANDLER(OP_X), HANDLER(OP_Y), HANDLER(OP_Z), HANDLER(OP_LINT),
+	};
+#endif
+	char buf[MAX_COMPONENT_LEN + 1];
+	const gs1_charclass_t *cc = NULL;
+	gs1_lint_err_t err = GS1_LINTER_OK;
+	size_t pos = 0, start = 0, n, epos = 0, elen = 0;
+
+#ifdef SPEC_THREADED
+	NEXT;
+#else
+	for (;;) switch (*pc++) {
+#endif
+
+	CASE(OP_OPT):
+		if (pos == len)
+			pc += pc[0];
+		pc++;
+		NEXT;
+
+	CASE(OP_N):
+		cc = &gs1_charclass_csetnumeric;
+		err = GS1_LINTER_NON_DIGIT_CHARACTER;
+		goto component;
+
+	CASE(OP_X):
+		cc = &gs1_charclass_cset82;
+		err = GS1_LINTER_INVALID_CSET82_CHARACTER;
+		goto component;
+
+	CASE(OP_Y):
+		cc = &gs1_charclass_cset39;
+		err = GS1_LINTER_INVALID_CSET39_CHARACTER;
+		goto component;
+
+	CASE(OP_Z):
+		cc = NULL;
+
+component:
+		n = len - pos < pc[1] ? len - pos : pc[1];
+		if (n < pc[0]) {
+			epos = pos;
+			elen = n;
+			err = GS1_LINTER_COMPONENT_TOO_SHORT;
+			goto out;
+		}
+		pc += 2;
+		if (cc) {
+			if ((epos = gs1_charclass_span(cc, data + pos, n)) != n) {
+				epos += pos;
+				elen = 1;
+				goto out;
+			}
+			err = GS1_LINTER_OK;
+			if (*pc == OP_LINT) {
+				memcpy(buf, data + pos, n);
+				buf[n] = '\0';
+			}
+		} else {
+			memcpy(buf, data + pos, n);
+			buf[n] = '\0';
+			if ((err = check_cset64(buf, n, &epos, &elen)) != GS1_LINTER_OK) {
+				epos += pos;
+				goto out;
+			}
+		}
+		start = pos;
+		pos += n;
+		NEXT;
+
+	CASE(OP_LINT):
+		if ((err = code->linters[*pc++](buf, &epos, &elen)) != GS1_LINTER_OK) {
+			epos += start;
+			goto out;
+		}
+		NEXT;
+
+	CASE(OP_END):
+		if (pos < len) {
+			epos = pos;
+			elen = len - pos;
+			err = GS1_LINTER_DATA_TOO_LONG;
+		}
+		goto out;
+
+#ifndef SPEC_THREADED
+	}
+#endif
+
+out:
+
+	if (err != GS1_LINTER_OK) {
+		if (err_pos) *err_pos = epos;
+		if (err_len) *err_len = elen;
+	}
+
+	return err;
+
+}
+
+
+/**
+ * Validate the data of an AI against the specification of its dictionary
+ * entry: the character set and length of each component, and the linters
+ * that are applied to it.
+ *
+ * The specification is compiled when the dictionary is loaded, so no parsing
+ * is done here.
+ *
+ * @param [in] dict The dictionary.
+ * @param [in] entry The entry number of the AI, from gs1_dict_find().
+ * @param [in] data The AI data, which need not be null-terminated.
+ * @param [in] len The length of the data.
+ * @param [out] err_pos The start position of the bad data, if not `NULL`.
+ * @param [out] err_len The length of the bad data, if not `NULL`.
+ *
+ * @return #GS1_LINTER_OK if okay.
+ * @return #GS1_LINTER_COMPONENT_TOO_SHORT if too little data remains for a
+ *         component.
+ * @return #GS1_LINTER_DATA_TOO_LONG if data remains after the last
+ *         component.
+ * @return otherwise the error of the character set or linter that rejected
+ *         a component, with the position relative to the start of the data.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_lint_err_t gs1_dict_validate(const gs1_dict_t* const dict, const int entry, const char* const data, const size_t len,
+							   size_t* const err_pos, size_t* const err_len)
+{
+
+	assert(dict && entry >= 0 && (size_t)entry < dict->count);
+	assert(data || len == 0);
+
+	return run(DICT_CODE(dict, entry), DICT_PROG(dict, entry), data, len, err_pos, err_len);
+
+}
+
+
+/**
+ * Validate a column of values of one AI, packed end-to-end within a single
+ * buffer, against the specification of its dictionary entry.
+ *
+ * Value i occupies data[offsets[i]] to data[offsets[i+1] - 1], so offsets
+ * has count + 1 entries and must be non-decreasing. The values are validated
+ * in place and need not be null-terminated.
+ *
+ * @param [in] dict The dictionary.
+ * @param [in] entry The entry number of the AI, from gs1_dict_find().
+ * @param [in] data The packed values.
+ * @param [in] offsets The count + 1 offsets delimiting the values.
+ * @param [in] count The number of values.
+ * @param [out] results The result of gs1_dict_validate() for each value,
+ *              packed as a gs1_lint_result_t.
+ *
+ * @return the number of values that failed validation.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_dict_validate_batch(const gs1_dict_t* const dict, const int entry, const char* const data,
+							 const uint32_t* const offsets, const size_t count, gs1_lint_result_t* const results)
+{
+
+	const struct dict_code *code;
+	const uint8_t *pc;
+	size_t i, pos, len, fails = 0;
+	gs1_lint_err_t err;
+
+	assert(dict && entry >= 0 && (size_t)entry < dict->count);
+	assert(data || count == 0);
+	assert(offsets);
+	assert(results || count == 0);
+
+	code = DICT_CODE(dict, entry);
+	pc = DICT_PROG(dict, entry);
+
+	for (i = 0; i < count; i++) {
+		assert(offsets[i] <= offsets[i+1]);
+		pos = len = 0;
+		err = run(code, pc, data + offsets[i], offsets[i+1] - offsets[i], &pos, &len);
+		results[i] = gs1_lint_result_pack(err, pos, len);
+		if (err != GS1_LINTER_OK)
+			fails++;
+	}
+
+	return fails;
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#include "unittest.h"
+
+
+static const char test_dict[] =
+	"01         *?  N14,csum,key                  ex=02,255,37 dlpkey=22,10,21|235                    # GTIN\n"
+	"10          ?  X..20                         req=01,02,8006,8026                                 # BATCH/LOT\n"
+	"253         ?  N13,csum,key [X..17]          dlpkey                                              # GDTI\n"
+	"4300        ?  X..35,pcenc                   req=00                                              # SHIP TO COMP\n"
+	"4330        ?  N6 [X1],hyphen                req=00 ex=4331                                      # MAX TEMP F.\n"
+	"7007        ?  N6,yymmdd [N6],yymmdd         req=01,02                                           # HARVEST DATE\n"
+	"8008        ?  N8,yymmddhh [N..4],mmoptss    req=01,02                                           # PROD TIME\n"
+	"8010        ?  Y..30,key                     dlpkey=8011                                         # CPID\n"
+	"8030           Z..90                                                                             # DIGSIG\n";
+
+
+/*
+ * The compiled program and the reference interpreter agree.
+ *
+ */
+static gs1_lint_err_t validate(const gs1_dict_t* const dict, const char* const ai, const char* const data, size_t* const pos, size_t* const len)
+{
+
+	const int entry = gs1_dict_find(dict, ai, strlen(ai));
+	gs1_lint_err_t err, ref;
+	size_t rpos = 0, rlen = 0;
+
+	*pos = *len = 0;
+	err = gs1_dict_validate(dict, entry, data, strlen(data), pos, len);
+	ref = gs1_dict_spec_interpret(gs1_dict_spec(dict, entry), data, strlen(data), &rpos, &rlen);
+	TEST_CHECK(err == ref && (err == GS1_LINTER_OK || (*pos == rpos && *len == rlen)));
+	TEST_MSG("(%s)%s: compiled (%d, %d, %d); reference (%d, %d, %d)", ai, data,
+		 (int)err, (int)*pos, (int)*len, (int)ref, (int)rpos, (int)rlen);
+
+	return err;
+
+}
+
+
+void test_spec_validate(void)
+{
+
+	gs1_dict_t *dict;
+	size_t pos, len;
+
+	TEST_ASSERT(gs1_dict_load(test_dict, strlen(test_dict), &dict, NULL) == GS1_DICT_OK);
+
+	TEST_CHECK(validate(dict, "01", "09521234543213", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "01", "09521234543214", &pos, &len) == GS1_LINTER_INCORRECT_CHECK_DIGIT && pos == 13 && len == 1);
+	TEST_CHECK(validate(dict, "01", "0952123454321", &pos, &len) == GS1_LINTER_COMPONENT_TOO_SHORT && pos == 0 && len == 13);
+	TEST_CHECK(validate(dict, "01", "095212345432130", &pos, &len) == GS1_LINTER_DATA_TOO_LONG && pos == 14 && len == 1);
+	TEST_CHECK(validate(dict, "01", "0952123454321A", &pos, &len) == GS1_LINTER_NON_DIGIT_CHARACTER && pos == 13 && len == 1);
+	TEST_CHECK(validate(dict, "01", "", &pos, &len) == GS1_LINTER_COMPONENT_TOO_SHORT && pos == 0 && len == 0);
+
+	TEST_CHECK(validate(dict, "10", "ABC123", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "10", "ABC 123", &pos, &len) == GS1_LINTER_INVALID_CSET82_CHARACTER && pos == 3 && len == 1);
+	TEST_CHECK(validate(dict, "10", "123456789012345678901", &pos, &len) == GS1_LINTER_DATA_TOO_LONG && pos == 20 && len == 1);
+	TEST_CHECK(validate(dict, "10", "", &pos, &len) == GS1_LINTER_COMPONENT_TOO_SHORT);
+
+	/*
+	 * Optional components, which may be omitted only when no data remains.
+	 *
+	 */
+	TEST_CHECK(validate(dict, "253", "9521234543213", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "253", "9521234543213ABC", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "253", "9521234543214ABC", &pos, &len) == GS1_LINTER_INCORRECT_CHECK_DIGIT && pos == 12);
+	TEST_CHECK(validate(dict, "4330", "001234", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "4330", "001234-", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "4330", "001234+", &pos, &len) == GS1_LINTER_NOT_HYPHEN && pos == 6 && len == 1);
+	TEST_CHECK(validate(dict, "4330", "001234--", &pos, &len) == GS1_LINTER_DATA_TOO_LONG && pos == 7);
+	TEST_CHECK(validate(dict, "7007", "250101", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "7007", "250101250131", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "7007", "250101250132", &pos, &len) == GS1_LINTER_ILLEGAL_DAY && pos == 10 && len == 2);
+	TEST_CHECK(validate(dict, "7007", "2501012501", &pos, &len) == GS1_LINTER_COMPONENT_TOO_SHORT && pos == 6 && len == 4);
+	TEST_CHECK(validate(dict, "8008", "25010112", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "8008", "250101121530", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "8008", "250101121", &pos, &len) == GS1_LINTER_MMSS_INVALID_LENGTH && pos == 8);
+
+	/*
+	 * Linters of variable-length components, and the other character sets.
+	 *
+	 */
+	TEST_CHECK(validate(dict, "4300", "A%20B", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "4300", "A%2XB", &pos, &len) == GS1_LINTER_INVALID_PERCENT_SEQUENCE && pos == 1 && len == 3);
+	TEST_CHECK(validate(dict, "8010", "9521234-123", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "8010", "9521234.123", &pos, &len) == GS1_LINTER_INVALID_CSET39_CHARACTER && pos == 7);
+	TEST_CHECK(validate(dict, "8030", "ABC_-12=", &pos, &len) == GS1_LINTER_INVALID_CSET64_PADDING);
+	TEST_CHECK(validate(dict, "8030", "ABC_-1", &pos, &len) == GS1_LINTER_OK);
+	TEST_CHECK(validate(dict, "8030", "ABC+", &pos, &len) == GS1_LINTER_INVALID_CSET64_CHARACTER && pos == 3);
+
+	/*
+	 * An embedded NUL is an invalid character of every set.
+	 *
+	 */
+	TEST_CHECK(gs1_dict_validate(dict, gs1_dict_find(dict, "10", 2), "AB\0CD", 5, &pos, &len) == GS1_LINTER_INVALID_CSET82_CHARACTER && pos == 2);
+	TEST_CHECK(gs1_dict_validate(dict, gs1_dict_find(dict, "8030", 4), "AB\0CD", 5, &pos, &len) == GS1_LINTER_INVALID_CSET64_CHARACTER && pos == 2);
+	TEST_CHECK(gs1_dict_spec_interpret("Z..90", "AB\0CD", 5, &pos, &len) == GS1_LINTER_INVALID_CSET64_CHARACTER && pos == 2);
+
+	gs1_dict_free(dict);
+
+}
+
+
+void test_spec_validate_batch(void)
+{
+
+	static const char data[] = "250101" "250101250132" "2501012501" "";
+	static const uint32_t offsets[] = { 0, 6, 18, 28, 28 };
+	gs1_lint_result_t results[4];
+	gs1_dict_t *dict;
+	size_t pos, len;
+
+	TEST_ASSERT(gs1_dict_load(test_dict, strlen(test_dict), &dict, NULL) == GS1_DICT_OK);
+
+	TEST_CHECK(gs1_dict_validate_batch(dict, gs1_dict_find(dict, "7007", 4), data, offsets, 4, results) == 3);
+	TEST_CHECK(results[0] == 0);
+	TEST_CHECK(gs1_lint_result_unpack(results[1], &pos, &len) == GS1_LINTER_ILLEGAL_DAY && pos == 10 && len == 2);
+	TEST_CHECK(gs1_lint_result_unpack(results[2], &pos, &len) == GS1_LINTER_COMPONENT_TOO_SHORT && pos == 6 && len == 4);
+	TEST_CHECK(GS1_LINT_RESULT_CODE(results[3]) == GS1_LINTER_COMPONENT_TOO_SHORT);
+
+	gs1_dict_free(dict);
+
+}
+
+
+void test_spec_compile_errors(void)
+{
+
+	gs1_dict_t *dict;
+	size_t line;
+
+#define LOAD(t) gs1_dict_load(t, strlen(t), &dict, &line)
+
+	TEST_CHECK(LOAD("01 N14,dummy\n") == GS1_DICT_INVALID_SPEC && line == 1);
+	TEST_CHECK(LOAD("01 N14\n02 N0\n") == GS1_DICT_INVALID_SPEC && line == 2);
+	TEST_CHECK(LOAD("01 N100\n") == GS1_DICT_INVALID_SPEC);
+	TEST_CHECK(LOAD("01 N6..3\n") == GS1_DICT_INVALID_SPEC);
+	TEST_CHECK(LOAD("01 [N6\n") == GS1_DICT_INVALID_SPEC);
+	TEST_CHECK(LOAD("01 N6,\n") == GS1_DICT_INVALID_SPEC);
+	TEST_CHECK(LOAD("01 N3..6 [N..4]\n") == GS1_DICT_OK);
+	gs1_dict_free(dict);
+
+#undef LOAD
+
+}
+
+
+/*
+ * Small domains are checked exhaustively: every three-digit code, every
+ * six-digit date, which selects the length-specialised date kernels, and
+ * every pair of bytes.
+ *
+ */
+void test_spec_validate_small_domains(void)
+{
+
+	static const char text[] =
+		"422 N3,iso3166\n"
+		"426 N3,iso3166999\n"
+		"3910 N3,iso4217 [N..15]\n"
+		"11 N6,yymmdd\n"
+		"15 N6,yymmd0\n"
+		"4307 X2,iso3166alpha2\n"
+		"8030 Z..2\n";
+
+	gs1_dict_t *dict;
+	char data[8];
+	size_t e, pos, len, rpos, rlen;
+	gs1_lint_err_t err, ref;
+	int i, n, ok = 1;
+
+	TEST_ASSERT(gs1_dict_load(text, strlen(text), &dict, NULL) == GS1_DICT_OK);
+
+	for (e = 0; e < gs1_dict_count(dict); e++) {
+		const char* const spec = gs1_dict_spec(dict, (int)e);
+		const int bytes = spec[0] == 'X' || spec[0] == 'Z';
+		const int digits = spec[1] - '0';
+		const int count = bytes ? 65536 : digits == 3 ? 1000 : 1000000;
+		for (i = 0; i < count; i++) {
+			if (bytes) {
+				data[0] = (char)(i >> 8);
+				data[1] = (char)(i & 0xff);
+				n = 2;
+			} else
+				n = snprintf(data, sizeof(data), "%0*d", digits, i);
+			pos = len = rpos = rlen = 0;
+			err = gs1_dict_validate(dict, (int)e, data, (size_t)n, &pos, &len);
+			ref = gs1_dict_spec_interpret(spec, data, (size_t)n, &rpos, &rlen);
+			if (err != ref || (err != GS1_LINTER_OK && (pos != rpos || len != rlen))) {
+				TEST_MSG("(%s) %s for %d: compiled (%d, %d, %d); reference (%d, %d, %d)",
+					 gs1_dict_ai(dict, (int)e), spec, i,
+					 (int)err, (int)pos, (int)len, (int)ref, (int)rpos, (int)rlen);
+				ok = 0;
+				break;
+			}
+		}
+	}
+
+	TEST_CHECK(ok);
+
+	gs1_dict_free(dict);
+
+}
+
+
+/*
+ * Every AI of the distributed dictionary agrees with the reference for a
+ * spread of data of each length that it permits, when the tests are run
+ * from the source directory.
+ *
+ */
+void test_spec_validate_file(void)
+{
+
+	static const char chars[] = "0123456789AZaz-=/%_";
+	char data[100];
+	gs1_dict_t *dict;
+	size_t e, n, i, k, pos, len, rpos, rlen;
+	gs1_lint_err_t err, ref;
+
+	if ((dict = load_dictionary_file()) == NULL)
+		return;
+
+	for (e = 0; e < gs1_dict_count(dict); e++) {
+		for (n = 0; n < sizeof(data); n++) {
+			for (k = 0; k < 4; k++) {
+				for (i = 0; i < n; i++)
+					data[i] = k == 0 ? '0' : chars[(i * 7 + k * 3 + e) % (k == 1 ? 10 : sizeof(chars) - 1)];
+				pos = len = rpos = rlen = 0;
+				err = gs1_dict_validate(dict, (int)e, data, n, &pos, &len);
+				ref = gs1_dict_spec_interpret(gs1_dict_spec(dict, (int)e), data, n, &rpos, &rlen);
+				if (!TEST_CHECK(err == ref && (err == GS1_LINTER_OK || (pos == rpos && len == rlen)))) {
+					TEST_MSG("(%s) of length %d", gs1_dict_ai(dict, (int)e), (int)n);
+					goto out;
+				}
+			}
+		}
+	}
+
+out:
+
+	gs1_dict_free(dict);
+
+}
+
+#endif  /* UNIT_TESTS */
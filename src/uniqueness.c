@@ -0,0 +1,831 @@
+/*
+ * GS1 Syntax Dictionary. Copyright (c) 2022-2024 GS1 AISBL.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Detection of repeated (01) GTIN + (21) serial number instance keys across
+ * very many messages, e.g. for serialisation checks.
+ *
+ * The keys are held in a cuckoo filter: buckets of four 16-bit fingerprints,
+ * with each key able to occupy either of two buckets. This needs around two
+ * bytes per key, and a lookup reads at most two cache lines. The rate of
+ * false positives is about 1 in 8000.
+ *
+ * Optionally, every key is also written to an exact store, which is an
+ * append-only log of records in a memory-mapped file. Each slot of the filter
+ * holds the log index of the record for its fingerprint, in a parallel array
+ * of four bytes per slot. A new key is written to the next record in sequence
+ * without reading the store. The store is only read when the filter matches,
+ * and then only the records of the matching fingerprints, so the operating
+ * system can page it out to disk as it grows.
+ *
+ * The tracker is not thread-safe.
+ *
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "gs1syntaxdictionary.h"
+
+
+#define BUCKET_SLOTS 4
+#define MAX_KICKS 500
+#define MAX_SERIAL_LEN 20
+#define PREFETCH_AHEAD 8
+
+#ifdef __GNUC__
+#define PREFETCH(p) __builtin_prefetch(p)
+#else
+#define PREFETCH(p) ((void)(p))
+#endif
+
+/*
+ * A key in the exact store, with the GTIN and serial length packed into a
+ * single word.
+ *
+ */
+struct uniq_record {
+	uint64_t gtin_len;
+	char serial[24];
+};
+
+/*
+ * The instance key of a message, located in the filter.
+ *
+ */
+struct uniq_key {
+	const char *gtin;		/* NULL if there is no valid key */
+	const char *serial;
+	size_t serial_len;
+	uint16_t fp;
+	size_t bucket;
+	size_t alt;
+};
+
+struct gs1_uniq {
+	uint16_t *table;		/* BUCKET_SLOTS per bucket; 0 is empty */
+	uint32_t *refs;			/* Store record of each slot, or NULL */
+	size_t bucket_mask;
+	size_t capacity;
+	size_t count;
+	uint64_t rng;
+	int has_victim;			/* A fingerprint evicted when the table filled */
+	uint16_t victim_fp;
+	uint32_t victim_ref;
+	size_t victim_bucket;
+	struct uniq_record *store;	/* Exact store, or NULL */
+	size_t store_size;
+	size_t store_reads;		/* Records compared, for testing */
+};
+
+
+static uint64_t mix64(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= UINT64_C(0xff51afd7ed558ccd);
+	h ^= h >> 33;
+	h *= UINT64_C(0xc4ceb9fe1a85ec53);
+	h ^= h >> 33;
+	return h;
+}
+
+
+static uint64_t load64(const char* const p)
+{
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+
+static uint32_t load32(const char* const p)
+{
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+
+/*
+ * Whether each of the eight bytes is an ASCII digit. A byte below '0' wraps
+ * when '0' is subtracted, and one above '9' carries into its top bit when
+ * 0x46 is added, so any byte out of range sets a top bit.
+ *
+ */
+static int all_digits(const uint64_t v)
+{
+	const uint64_t ones = UINT64_C(0x0101010101010101);
+	return ((v | (v - 0x30 * ones) | (v + 0x46 * ones)) & 0x80 * ones) == 0;
+}
+
+
+/*
+ * Hashes the 14 GTIN digits and the serial in place, reading each as a few
+ * overlapping words that together cover every byte, so that nothing is
+ * copied and the words are multiplied independently.
+ *
+ */
+static uint64_t hash_key(const uint64_t gtin0, const uint64_t gtin1, const char* const serial, const size_t serial_len)
+{
+
+	uint64_t c, d, e = 0;
+
+	if (serial_len >= 8) {
+		c = load64(serial);
+		d = load64(serial + serial_len - 8);
+		if (serial_len > 16)
+			e = load64(serial + 8);
+	} else if (serial_len >= 4) {
+		c = load32(serial);
+		d = load32(serial + serial_len - 4);
+	} else {
+		c = (uint8_t)serial[0] | (uint64_t)(uint8_t)serial[serial_len / 2] << 8 | (uint64_t)(uint8_t)serial[serial_len - 1] << 16;
+		d = 0;
+	}
+
+	return mix64(gtin0 * UINT64_C(0x9e3779b97f4a7c15) ^ gtin1 * UINT64_C(0xc2b2ae3d27d4eb4f) ^
+		     c * UINT64_C(0x165667b19e3779f9) ^ d * UINT64_C(0xd6e8feb86659fd93) ^
+		     (e ^ serial_len) * UINT64_C(0xff51afd7ed558ccd));
+
+}
+
+
+static size_t alt_bucket(const struct gs1_uniq* const u, const size_t bucket, const uint16_t fp)
+{
+	return (bucket ^ (size_t)((uint32_t)fp * UINT32_C(0x5bd1e995))) & u->bucket_mask;
+}
+
+
+static int bucket_has(const struct gs1_uniq* const u, const size_t bucket, const uint16_t fp)
+{
+	const uint16_t * const b = &u->table[bucket * BUCKET_SLOTS];
+	return b[0] == fp || b[1] == fp || b[2] == fp || b[3] == fp;
+}
+
+
+static int bucket_put(struct gs1_uniq* const u, const size_t bucket, const uint16_t fp, const uint32_t ref)
+{
+
+	uint16_t * const b = &u->table[bucket * BUCKET_SLOTS];
+	int i;
+
+	for (i = 0; i < BUCKET_SLOTS; i++) {
+		if (b[i] == 0) {
+			b[i] = fp;
+			if (u->refs)
+				u->refs[bucket * BUCKET_SLOTS + (size_t)i] = ref;
+			return 1;
+		}
+	}
+
+	return 0;
+
+}
+
+
+/*
+ * Relocates existing fingerprints to their alternate buckets to make room. If
+ * that fails then the last fingerprint to be evicted is kept aside, so no key
+ * is forgotten, but the filter is then full.
+ *
+ */
+static void filter_put(struct gs1_uniq* const u, size_t bucket, uint16_t fp, uint32_t ref)
+{
+
+	uint16_t tmp;
+	uint32_t tmp_ref;
+	size_t slot;
+	int kick;
+
+	if (bucket_put(u, bucket, fp, ref))
+		return;
+	bucket = alt_bucket(u, bucket, fp);
+	if (bucket_put(u, bucket, fp, ref))
+		return;
+
+	for (kick = 0; kick < MAX_KICKS; kick++) {
+		u->rng ^= u->rng << 13;
+		u->rng ^= u->rng >> 7;
+		u->rng ^= u->rng << 17;
+		slot = bucket * BUCKET_SLOTS + (size_t)(u->rng % BUCKET_SLOTS);
+		tmp = u->table[slot];
+		u->table[slot] = fp;
+		fp = tmp;
+		if (u->refs) {
+			tmp_ref = u->refs[slot];
+			u->refs[slot] = ref;
+			ref = tmp_ref;
+		}
+		bucket = alt_bucket(u, bucket, fp);
+		if (bucket_put(u, bucket, fp, ref))
+			return;
+	}
+
+	u->has_victim = 1;
+	u->victim_fp = fp;
+	u->victim_ref = ref;
+	u->victim_bucket = bucket;
+
+}
+
+
+static int store_match(struct gs1_uniq* const u, const uint32_t ref, const uint64_t gtin_len, const char* const serial)
+{
+
+	const struct uniq_record * const r = &u->store[ref];
+
+	u->store_reads++;
+	return r->gtin_len == gtin_len && memcmp(r->serial, serial, (size_t)(gtin_len & 0x1f)) == 0;
+
+}
+
+
+/*
+ * Looks for the key in the exact store, reading only the records of the
+ * matching fingerprints in the key's two buckets.
+ *
+ */
+static int store_has(struct gs1_uniq* const u, const size_t bucket, const uint16_t fp, const uint64_t gtin_len, const char* const serial)
+{
+
+	const size_t buckets[2] = { bucket, alt_bucket(u, bucket, fp) };
+	size_t i, slot;
+
+	for (i = 0; i < 2; i++) {
+		for (slot = buckets[i] * BUCKET_SLOTS; slot < (buckets[i] + 1) * BUCKET_SLOTS; slot++)
+			if (u->table[slot] == fp && store_match(u, u->refs[slot], gtin_len, serial))
+				return 1;
+		if (buckets[1] == buckets[0])
+			break;
+	}
+
+	return u->has_victim && u->victim_fp == fp &&
+	       (u->victim_bucket == buckets[0] || u->victim_bucket == buckets[1]) &&
+	       store_match(u, u->victim_ref, gtin_len, serial);
+
+}
+
+
+static size_t next_pow2(size_t n)
+{
+	size_t p = 1;
+	while (p < n)
+		p <<= 1;
+	return p;
+}
+
+
+/**
+ * Create a tracker for (01) GTIN + (21) serial number instance keys.
+ *
+ * Without an exact store, a key that is reported as a probable repeat is
+ * actually new with a probability of about 1 in 8000, and it is not recorded.
+ *
+ * With an exact store, each key also occupies 32 bytes of a file that is
+ * created, or truncated, at spill_path and memory-mapped, and the filter
+ * takes a further four bytes per slot. Its content is only meaningful to the
+ * tracker, and the file may be removed once the tracker has been freed. The
+ * exact store is not available on Windows.
+ *
+ * @param [in] capacity The maximum number of distinct keys.
+ * @param [in] spill_path The path of the file for the exact store, or `NULL`
+ *                        for none.
+ *
+ * @return the tracker, to be released with gs1_uniq_free(), or `NULL` if it
+ *         could not be created.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_uniq_t *gs1_uniq_create(const size_t capacity, const char* const spill_path)
+{
+
+	struct gs1_uniq *u;
+	size_t buckets;
+
+	if (capacity == 0 || capacity > SIZE_MAX / 4 / sizeof(struct uniq_record) || (spill_path && capacity > UINT32_MAX))
+		return NULL;
+
+	if ((u = calloc(1, sizeof(struct gs1_uniq))) == NULL)
+		return NULL;
+
+	/*
+	 * The filter reliably fills to around 95% with four slots per bucket.
+	 *
+	 */
+	buckets = next_pow2((capacity + capacity / 16) / BUCKET_SLOTS + 1);
+	u->bucket_mask = buckets - 1;
+	u->capacity = capacity;
+	u->rng = UINT64_C(0x853c49e6748fea9b);
+	if ((u->table = calloc(buckets * BUCKET_SLOTS, sizeof(uint16_t))) == NULL)
+		goto fail;
+
+	if (spill_path) {
+#ifdef _WIN32
+		goto fail;
+#else
+		int fd;
+		void *map;
+
+		if ((u->refs = malloc(buckets * BUCKET_SLOTS * sizeof(uint32_t))) == NULL)
+			goto fail;
+		u->store_size = capacity * sizeof(struct uniq_record);
+		if ((fd = open(spill_path, O_RDWR | O_CREAT | O_TRUNC, 0600)) < 0)
+			goto fail;
+		if (ftruncate(fd, (off_t)u->store_size) != 0) {
+			close(fd);
+			goto fail;
+		}
+		map = mmap(NULL, u->store_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (map == MAP_FAILED)
+			goto fail;
+		u->store = map;
+#endif
+	}
+
+	return u;
+
+fail:
+
+	gs1_uniq_free(u);
+	return NULL;
+
+}
+
+
+/**
+ * Release a tracker that was created with gs1_uniq_create().
+ *
+ * @param [in] uniq The tracker, or `NULL`.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API void gs1_uniq_free(gs1_uniq_t* const uniq)
+{
+
+	if (!uniq)
+		return;
+
+#ifndef _WIN32
+	if (uniq->store)
+		munmap(uniq->store, uniq->store_size);
+#endif
+	free(uniq->refs);
+	free(uniq->table);
+	free(uniq);
+
+}
+
+
+/**
+ * The number of distinct keys that have been recorded.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_uniq_count(const gs1_uniq_t* const uniq)
+{
+	assert(uniq);
+	return uniq->count;
+}
+
+
+/*
+ * Finds the instance key of a message and the buckets of its fingerprint,
+ * without reading the filter.
+ *
+ */
+static void find_key(const gs1_uniq_t* const uniq, const gs1_ai_view_t* const ais, const size_t count, struct uniq_key* const k)
+{
+
+	const gs1_ai_view_t *gtin = NULL, *serial = NULL;
+	uint64_t gtin0, gtin1, h;
+	size_t i;
+
+	k->gtin = NULL;
+
+	for (i = 0; i < count && (!gtin || !serial); i++) {
+		if (ais[i].ai_len != 2 || ais[i].ai[1] != '1')
+			continue;
+		if (ais[i].ai[0] == '0')
+			gtin = &ais[i];
+		else if (ais[i].ai[0] == '2')
+			serial = &ais[i];
+	}
+
+	if (!gtin || !serial || gtin->value_len != 14 || serial->value_len == 0 || serial->value_len > MAX_SERIAL_LEN)
+		return;
+
+	gtin0 = load64(gtin->value);
+	gtin1 = load64(gtin->value + 6);
+	if (!all_digits(gtin0) || !all_digits(gtin1))
+		return;
+
+	h = hash_key(gtin0, gtin1, serial->value, serial->value_len);
+	k->gtin = gtin->value;
+	k->serial = serial->value;
+	k->serial_len = serial->value_len;
+	k->fp = (uint16_t)(h >> 48);
+	if (k->fp == 0)
+		k->fp = 1;
+	k->bucket = (size_t)h & uniq->bucket_mask;
+	k->alt = alt_bucket(uniq, k->bucket, k->fp);
+
+}
+
+
+static gs1_uniq_result_t insert_key(gs1_uniq_t* const uniq, const struct uniq_key* const k)
+{
+
+	struct uniq_record *r;
+	uint64_t gtin_len = 0;
+	size_t i;
+	int maybe;
+
+	if (!k->gtin)
+		return GS1_UNIQ_NO_KEY;
+
+	maybe = bucket_has(uniq, k->bucket, k->fp) || bucket_has(uniq, k->alt, k->fp) ||
+		(uniq->has_victim && uniq->victim_fp == k->fp && (uniq->victim_bucket == k->bucket || uniq->victim_bucket == k->alt));
+
+	/*
+	 * The exact store keys the GTIN as a number.
+	 *
+	 */
+	if (uniq->store) {
+		for (i = 0; i < 14; i++)
+			gtin_len = gtin_len * 10 + (uint64_t)(k->gtin[i] - '0');
+		gtin_len = gtin_len << 5 | k->serial_len;
+	}
+
+	if (maybe) {
+		if (!uniq->store)
+			return GS1_UNIQ_PROBABLE_REPEAT;
+		if (store_has(uniq, k->bucket, k->fp, gtin_len, k->serial))
+			return GS1_UNIQ_REPEAT;
+	}
+
+	if (uniq->count == uniq->capacity || uniq->has_victim)
+		return GS1_UNIQ_FULL;
+
+	/*
+	 * A new key whose fingerprint is already present is given a further copy
+	 * of the fingerprint, referring to its own record.
+	 *
+	 */
+	filter_put(uniq, k->bucket, k->fp, (uint32_t)uniq->count);
+
+	if (uniq->store) {
+		r = &uniq->store[uniq->count];
+		r->gtin_len = gtin_len;
+		memcpy(r->serial, k->serial, k->serial_len);
+	}
+	uniq->count++;
+
+	return GS1_UNIQ_NEW;
+
+}
+
+
+/**
+ * Record the (01) + (21) instance key of a message, reporting whether it has
+ * been seen before.
+ *
+ * The AI data is expected to have been validated. Only the lengths of the
+ * values and the digits of the GTIN are checked.
+ *
+ * A new key reads both of its buckets in the filter, and the second is
+ * prefetched while the first is probed. While the filter fits in the CPU
+ * cache, an insert takes some tens of nanoseconds. A filter much larger than
+ * the cache costs two cache misses per key, typically 150 ns or more, which
+ * a single insert cannot hide; gs1_uniq_insert_batch() overlaps the misses of
+ * successive messages, roughly halving that cost. The uniqueness_insert_speed
+ * test, built with SLOW_TESTS=yes, measures both.
+ *
+ * @param [in] uniq The tracker.
+ * @param [in] ais The AI data of the message.
+ * @param [in] count The number of AIs.
+ *
+ * @return a #gs1_uniq_result_t.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API gs1_uniq_result_t gs1_uniq_insert(gs1_uniq_t* const uniq, const gs1_ai_view_t* const ais, const size_t count)
+{
+
+	struct uniq_key k;
+
+	assert(uniq);
+	assert(ais || count == 0);
+
+	find_key(uniq, ais, count, &k);
+	if (k.gtin)
+		PREFETCH(&uniq->table[k.alt * BUCKET_SLOTS]);
+
+	return insert_key(uniq, &k);
+
+}
+
+
+/**
+ * Record the instance keys of a batch of messages.
+ *
+ * The AIs of message i are ais[offsets[i]] to ais[offsets[i+1] - 1], so
+ * offsets has count + 1 entries. The #gs1_uniq_result_t for message i is
+ * written to results[i].
+ *
+ * The results are as for calling gs1_uniq_insert() on each message in turn,
+ * but the buckets of each key are prefetched several messages ahead, so that
+ * the cache misses of a large filter overlap.
+ *
+ * @return the number of messages whose instance key is a repeat or probable
+ *         repeat.
+ *
+ */
+GS1_SYNTAX_DICTIONARY_API size_t gs1_uniq_insert_batch(gs1_uniq_t* const uniq, const gs1_ai_view_t* const ais, const uint32_t* const offsets,
+						       const size_t count, uint8_t* const results)
+{
+
+	struct uniq_key keys[PREFETCH_AHEAD];
+	struct uniq_key *k;
+	size_t i, repeats = 0;
+	gs1_uniq_result_t res;
+
+	assert(uniq);
+	assert(offsets);
+	assert(results);
+
+	for (i = 0; i < count + PREFETCH_AHEAD; i++) {
+
+		if (i >= PREFETCH_AHEAD) {
+			res = insert_key(uniq, &keys[i % PREFETCH_AHEAD]);
+			if (res == GS1_UNIQ_REPEAT || res == GS1_UNIQ_PROBABLE_REPEAT)
+				repeats++;
+			results[i - PREFETCH_AHEAD] = (uint8_t)res;
+		}
+
+		if (i < count) {
+			k = &keys[i % PREFETCH_AHEAD];
+			find_key(uniq, &ais[offsets[i]], offsets[i+1] - offsets[i], k);
+			if (k->gtin) {
+				PREFETCH(&uniq->table[k->bucket * BUCKET_SLOTS]);
+				PREFETCH(&uniq->table[k->alt * BUCKET_SLOTS]);
+			}
+		}
+
+	}
+
+	return repeats;
+
+}
+
+
+#ifdef UNIT_TESTS
+
+#include "unittest.h"
+
+
+/*
+ * Message i of a sequence of distinct keys, using the buffers provided.
+ *
+ */
+static void make_key(gs1_ai_view_t *ais, char *gtin, char *serial, unsigned long i)
+{
+	sprintf(gtin, "0952123%07lu", i % 1000);
+	sprintf(serial, "S%lu", i);
+	set_ai(&ais[0], "01", gtin);
+	set_ai(&ais[1], "10", "LOT");
+	set_ai(&ais[2], "21", serial);
+}
+
+
+void test_uniqueness_filter(void)
+{
+
+	gs1_uniq_t *u;
+	gs1_ai_view_t ais[3];
+	char gtin[16], serial[24];
+	unsigned long i, n = 50000, probable = 0;
+
+	TEST_ASSERT((u = gs1_uniq_create(n, NULL)) != NULL);
+
+	for (i = 0; i < n; i++) {
+		make_key(ais, gtin, serial, i);
+		switch (gs1_uniq_insert(u, ais, 3)) {
+		case GS1_UNIQ_NEW:
+			break;
+		case GS1_UNIQ_PROBABLE_REPEAT:
+			probable++;
+			break;
+		default:
+			TEST_CHECK(0);
+		}
+	}
+	TEST_CHECK(gs1_uniq_count(u) == n - probable);
+
+	/*
+	 * The occasional false positive.
+	 *
+	 */
+	TEST_CHECK(probable < 50);
+	TEST_MSG("Got %lu", probable);
+
+	/*
+	 * No false negatives.
+	 *
+	 */
+	for (i = 0; i < n; i++) {
+		make_key(ais, gtin, serial, i);
+		if (!TEST_CHECK(gs1_uniq_insert(u, ais, 3) == GS1_UNIQ_PROBABLE_REPEAT))
+			break;
+	}
+
+	make_key(ais, gtin, serial, 0);
+	TEST_CHECK(gs1_uniq_insert(u, ais, 2) == GS1_UNIQ_NO_KEY);
+	TEST_CHECK(gs1_uniq_insert(u, &ais[1], 2) == GS1_UNIQ_NO_KEY);
+	set_ai(&ais[0], "01", "0952123456789");
+	TEST_CHECK(gs1_uniq_insert(u, ais, 3) == GS1_UNIQ_NO_KEY);
+	set_ai(&ais[0], "01", "0952123456789A");
+	TEST_CHECK(gs1_uniq_insert(u, ais, 3) == GS1_UNIQ_NO_KEY);
+	set_ai(&ais[0], "01", "09521234543213");
+	set_ai(&ais[2], "21", "");
+	TEST_CHECK(gs1_uniq_insert(u, ais, 3) == GS1_UNIQ_NO_KEY);
+	set_ai(&ais[2], "21", "123456789012345678901");
+	TEST_CHECK(gs1_uniq_insert(u, ais, 3) == GS1_UNIQ_NO_KEY);
+	set_ai(&ais[2], "22", "1");
+	TEST_CHECK(gs1_uniq_insert(u, ais, 3) == GS1_UNIQ_NO_KEY);
+
+	gs1_uniq_free(u);
+
+	TEST_CHECK(gs1_uniq_create(0, NULL) == NULL);
+
+}
+
+
+void test_uniqueness_exact_store(void)
+{
+
+	static const char path[] = "gs1-uniq-test.tmp";
+	static const uint32_t offsets[] = { 0, 3, 6, 9 };
+	gs1_uniq_t *u;
+	gs1_ai_view_t ais[9];
+	char gtin[16], serial[24];
+	uint8_t results[3];
+	unsigned long i, n = 50000;
+
+#ifdef _WIN32
+	TEST_CHECK(gs1_uniq_create(n, path) == NULL);
+	return;
+#endif
+
+	TEST_ASSERT((u = gs1_uniq_create(n, path)) != NULL);
+
+	/*
+	 * Exact, so false positives are resolved.
+	 *
+	 */
+	for (i = 0; i < n; i++) {
+		make_key(ais, gtin, serial, i);
+		if (!TEST_CHECK(gs1_uniq_insert(u, ais, 3) == GS1_UNIQ_NEW))
+			break;
+	}
+	TEST_CHECK(gs1_uniq_count(u) == n);
+
+	/*
+	 * New keys are appended without reading the store, other than to
+	 * resolve the occasional false positive of the filter.
+	 *
+	 */
+	TEST_CHECK(u->store_reads < 50);
+	TEST_MSG("Got %lu", (unsigned long)u->store_reads);
+
+	u->store_reads = 0;
+	for (i = 0; i < n; i += 7) {
+		make_key(ais, gtin, serial, i);
+		if (!TEST_CHECK(gs1_uniq_insert(u, ais, 3) == GS1_UNIQ_REPEAT))
+			break;
+	}
+	TEST_CHECK(u->store_reads >= (n + 6) / 7 && u->store_reads < (n + 6) / 7 + 50);
+	TEST_MSG("Got %lu", (unsigned long)u->store_reads);
+
+	/*
+	 * At capacity.
+	 *
+	 */
+	make_key(ais, gtin, serial, n);
+	TEST_CHECK(gs1_uniq_insert(u, ais, 3) == GS1_UNIQ_FULL);
+
+	gs1_uniq_free(u);
+
+	/*
+	 * A batch with a repeat within it.
+	 *
+	 */
+	TEST_ASSERT((u = gs1_uniq_create(10, path)) != NULL);
+	set_ai(&ais[0], "01", "09521234543213");
+	set_ai(&ais[1], "21", "A1");
+	set_ai(&ais[2], "10", "X");
+	set_ai(&ais[3], "21", "A1");
+	set_ai(&ais[4], "01", "09521234543213");
+	set_ai(&ais[5], "10", "X");
+	set_ai(&ais[6], "01", "09521234543213");
+	set_ai(&ais[7], "21", "A2");
+	set_ai(&ais[8], "10", "X");
+	TEST_CHECK(gs1_uniq_insert_batch(u, ais, offsets, 3, results) == 1);
+	TEST_CHECK(results[0] == GS1_UNIQ_NEW && results[1] == GS1_UNIQ_REPEAT && results[2] == GS1_UNIQ_NEW);
+	gs1_uniq_free(u);
+
+	remove(path);
+
+	TEST_CHECK(gs1_uniq_create(10, "/nonexistent/gs1-uniq-test.tmp") == NULL);
+
+}
+
+
+#ifdef SLOW_TESTS
+
+#include <time.h>
+
+/*
+ * Benchmark of the mean time to insert a new key, singly and in batches,
+ * with a filter that fits in the CPU cache and with one that does not:
+ *
+ *     make test SLOW_TESTS=yes TEST=uniqueness_insert_speed
+ *
+ * The messages are made in batches outside of the timed region.
+ *
+ */
+#define SPEED_BATCH 4096
+
+void test_uniqueness_insert_speed(void)
+{
+
+	static const unsigned long sizes[] = { 100000, 10000000 };
+	static gs1_ai_view_t ais[SPEED_BATCH * 3];
+	static char gtins[SPEED_BATCH][16], serials[SPEED_BATCH][24];
+	static uint32_t offsets[SPEED_BATCH + 1];
+	static uint8_t results[SPEED_BATCH];
+	struct timespec t0, t1;
+	gs1_uniq_t *u;
+	unsigned long i, j, n, batch, fresh;
+	double ns;
+	size_t k;
+	int batched;
+
+	for (i = 0; i <= SPEED_BATCH; i++)
+		offsets[i] = (uint32_t)(3 * i);
+
+	for (k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+		for (batched = 0; batched < 2; batched++) {
+
+			n = sizes[k];
+			TEST_ASSERT((u = gs1_uniq_create(n, NULL)) != NULL);
+
+			for (i = 0, ns = 0, fresh = 0; i < n; i += batch) {
+				batch = n - i < SPEED_BATCH ? n - i : SPEED_BATCH;
+				for (j = 0; j < batch; j++)
+					make_key(&ais[3 * j], gtins[j], serials[j], i + j);
+				clock_gettime(CLOCK_MONOTONIC, &t0);
+				if (batched)
+					gs1_uniq_insert_batch(u, ais, offsets, batch, results);
+				else
+					for (j = 0; j < batch; j++)
+						results[j] = (uint8_t)gs1_uniq_insert(u, &ais[3 * j], 3);
+				clock_gettime(CLOCK_MONOTONIC, &t1);
+				ns += (double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec);
+				for (j = 0; j < batch; j++)
+					fresh += results[j] == GS1_UNIQ_NEW;
+			}
+			TEST_CHECK(fresh == gs1_uniq_count(u));
+
+			printf("\n  %8lu keys, %s: %5.1f ns per insert", n, batched ? "batched" : "singly ", ns / (double)n);
+
+			gs1_uniq_free(u);
+
+		}
+	}
+	printf("\n");
+
+}
+
+#endif  /* SLOW_TESTS */
+
+#endif  /* UNIT_TESTS */
@@ -22,15 +22,29 @@
 #ifndef LINT_UNIT_TEST
 #define LINT_UNIT_TEST
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include "gs1syntaxdictionary.h"
 
 #define TEST_NO_MAIN
 #include "acutest.h"
 
+/*
+ * Not every test file uses every helper.
+ *
+ */
+#ifdef __GNUC__
+#define UNIT_TEST_HELPER static __attribute__((unused))
+#else
+#define UNIT_TEST_HELPER static
+#endif
+
 #define UNIT_TEST_PASS(f, g) DO_UNIT_TEST(1, f, g, 0, NULL, __FILE__, __LINE__)
 #define UNIT_TEST_FAIL(f, g, e, h) DO_UNIT_TEST(0, f, g, e, h, __FILE__, __LINE__)
 
-static void DO_UNIT_TEST(int should_succeed, gs1_lint_err_t (*fn)(const char *, size_t *, size_t *), const char *data, gs1_lint_err_t expect_err, const char *expect_highlight, const char *file, int line) {
+UNIT_TEST_HELPER void DO_UNIT_TEST(int should_succeed, gs1_lint_err_t (*fn)(const char *, size_t *, size_t *), const char *data, gs1_lint_err_t expect_err, const char *expect_highlight, const char *file, int line) {
 
 	gs1_lint_err_t err;
 	size_t err_pos[1], err_len[1];
@@ -46,12 +60,12 @@ static void DO_UNIT_TEST(int should_succeed, gs1_lint_err_t (*fn)(const char *,
 
 	if (should_succeed) {
 		TEST_CHECK(err == GS1_LINTER_OK);
-		TEST_MSG("Expected success, but failed with error: %s", gs1_lint_err_str[err]);
+		TEST_MSG("Expected success, but failed with error: %s", gs1_lint_err_msg(err));
 		return;
 	}
 
 	TEST_CHECK(err == expect_err);
-	TEST_MSG("Got: %s; Expected: %s", gs1_lint_err_str[err], gs1_lint_err_str[expect_err]);
+	TEST_MSG("Got: %s; Expected: %s", gs1_lint_err_msg(err), gs1_lint_err_msg(expect_err));
 
 	if (err == GS1_LINTER_OK)
 		return;
@@ -70,4 +84,51 @@ static void DO_UNIT_TEST(int should_succeed, gs1_lint_err_t (*fn)(const char *,
 
 }
 
+
+/*
+ * Points an AI view at null-terminated strings.
+ *
+ */
+UNIT_TEST_HELPER void set_ai(gs1_ai_view_t *v, const char *ai, const char *value)
+{
+	v->ai = ai;
+	v->ai_len = strlen(ai);
+	v->value = value;
+	v->value_len = strlen(value);
+}
+
+
+/*
+ * Loads the dictionary distributed with the library, when the tests are run
+ * from the source directory, returning NULL if it is not available or fails
+ * to load.
+ *
+ */
+UNIT_TEST_HELPER gs1_dict_t *load_dictionary_file(void)
+{
+
+	FILE *f;
+	char *text;
+	long len = 0;
+	gs1_dict_t *dict = NULL;
+	size_t line = 0;
+
+	if ((f = fopen("../gs1-syntax-dictionary.txt", "rb")) == NULL) {
+		TEST_MSG("Skipping since the dictionary file is not available");
+		return NULL;
+	}
+
+	TEST_ASSERT(fseek(f, 0, SEEK_END) == 0 && (len = ftell(f)) > 0 && fseek(f, 0, SEEK_SET) == 0);
+	TEST_ASSERT((text = malloc((size_t)len)) != NULL);
+	TEST_ASSERT(fread(text, 1, (size_t)len, f) == (size_t)len);
+	fclose(f);
+
+	TEST_CHECK(gs1_dict_load(text, (size_t)len, &dict, &line) == GS1_DICT_OK);
+	TEST_MSG("Line %d", (int)line);
+	free(text);
+
+	return dict;
+
+}
+
 #endif  /* LINT_UNIT_TEST */